@@ -83,9 +83,3 @@ struct BigData {
 	u1 type;
 	op8 value;
 };
-
-struct Array {
-	u4 type;
-	u4 size;
-	void * array;
-};
\ No newline at end of file
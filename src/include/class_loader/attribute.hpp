@@ -2,6 +2,7 @@
 
 #include "constant_pool.hpp"
 #include "code_info.hpp"
+#include "register_code.hpp"
 
 namespace jvm {
 
@@ -9,6 +10,7 @@ namespace jvm {
 	struct AttrCode;
 	struct AttrConstantValue;
 	struct AttrExceptions;
+	struct AttrBootstrapMethods;
 
 	/**
 	 * Maps a string to a function that returns an instance of the corresponding attribute
@@ -21,6 +23,7 @@ namespace jvm {
 		std::vector<std::shared_ptr<AttrCode>> Codes;	///< Vector of the attribute code
 		std::vector<std::shared_ptr<AttrConstantValue>> ConstValues; ///< Vector of the constant values
 		std::vector<std::shared_ptr<AttrExceptions>> Exceptions; ///< Vector of the exceptions
+		std::vector<std::shared_ptr<AttrBootstrapMethods>> BootstrapMethods; ///< Vector of the bootstrap methods of the invokedynamic instructions
 
 		/**
 		 * Fills this attribute entry's members
@@ -78,6 +81,7 @@ namespace jvm {
 		u2 max_locals;
 		std::vector<u1> code_bytes;
 		CodeInfo code;
+		RegisterCode registers;	///< Code translated to registers, when the engine runs it
 		std::vector<exception_table_entry> exception_table;
 		AttributeInfo attributes;
 
@@ -96,4 +100,15 @@ namespace jvm {
 		AttrExceptions(Reader &reader, ConstantPool &cp);
 		void printToStream(std::ostream &os, ConstantPool &pool, std::string &prefix) override;
 	};
+
+	struct AttrBootstrapMethods : public AttrEntry {
+		typedef struct {
+			u2 bootstrap_method_ref;
+			std::vector<u2> bootstrap_arguments;
+		} bootstrap_method;
+
+		std::vector<bootstrap_method> bootstrap_methods;
+		AttrBootstrapMethods(Reader &reader, ConstantPool &cp);
+		void printToStream(std::ostream &os, ConstantPool &pool, std::string &prefix) override;
+	};
 }
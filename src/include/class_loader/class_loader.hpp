@@ -3,6 +3,7 @@
 #include "interface.hpp"
 #include "method.hpp"
 #include "field.hpp"
+#include "runtime_constant_pool.hpp"
 
 namespace jvm {
 
@@ -34,12 +35,34 @@ namespace jvm {
 
 		uint16_t methods_count;                     ///< Number of MethodInfo in the methods entity
 
-		std::unordered_map<std::string, MethodInfo> methods;       ///< Vector of all MethodInfo structures declared by this class or interface type
+		std::unordered_map<u8, MethodInfo> methods; ///< All MethodInfo structures declared by this class or interface type, by Symbols::key(name, descriptor)
+
+		std::vector<u8> method_keys;                ///< Keys of the methods, in the order of the class file
 		
 		uint16_t attributes_count;                  ///< Number of AttributeInfo in the attributes entity
 
 		jvm::AttributeInfo attributes;              ///< Vector of AttributeInfo structures
 
+		std::shared_ptr<const uint8_t> bytes;       ///< Contents of the class file, the Utf8 constants point into it
+
+		RuntimeConstantPool runtime;                ///< Constant pool resolved when the class is linked
+
+		uint32_t instance_size = 0;                 ///< Bytes of the fields of an instance, inherited ones included
+
+		std::unordered_map<u8, u4> field_offsets;   ///< Offset of each instance field, inherited ones included, by Symbols::key(name, descriptor)
+
+		std::vector<u4> reference_offsets;          ///< Offsets of the reference fields of an instance, inherited ones included
+
+		std::vector<u8> static_storage;             ///< Values of the static fields declared by this class, laid out like an instance
+
+		std::unordered_map<u8, u4> static_offsets;  ///< Offset of each static field in static_storage, by Symbols::key(name, descriptor)
+
+		std::vector<u4> static_reference_offsets;   ///< Offsets of the static reference fields, roots of the garbage collector
+
+		std::vector<std::pair<u4, u2>> string_constants; ///< Offset of the static String fields with a ConstantValue and index of the String entry
+
+		bool initialized = false;                   ///< Whether the initialization of the class, running <clinit>, has started
+
 		/**
 		 * Default constructor
 		 */
@@ -50,12 +73,40 @@ namespace jvm {
 		 */
 		void read (std::basic_string<char>);
 
+		/**
+		 * Reads a class file already in memory, the caller keeps the buffer alive as long as the class
+		 */
+		void read (const uint8_t *, uint32_t);
+
 		/**
 		 * Prints the whole class file to the console
 		 */
 		void show ();
 
+		/**
+		 * Lays out the instance fields after the ones of the superclass: 8 byte fields aligned, narrower
+		 * fields packed by decreasing size, filling first the padding left before the 8 byte ones.
+		 * The static fields are laid out the same way in static_storage, which is zeroed
+		 * @param super the superclass, already laid out, nullptr when it is a library class
+		 */
+		void layout_fields (ClassLoader *);
+
+		/**
+		 * Stores the ConstantValue attributes of the static fields in static_storage. String constants
+		 * are heap objects, they are only listed in string_constants, to be stored when the class is initialized
+		 */
+		void apply_constant_values ();
+
 	private:
+		/**
+		 * Lays out the instance or the static fields declared by this class
+		 * @param statics whether the static fields are laid out
+		 * @param size bytes taken by the fields already placed, updated
+		 * @param offsets offset of each field placed, updated
+		 * @param references offsets of the reference fields, updated
+		 */
+		void layout (bool, uint32_t &, std::unordered_map<u8, u4> &, std::vector<u4> &);
+
 		/**
 		 * Prints interfaces count and it's content to the console if it's not null
 		 */
@@ -106,6 +157,11 @@ namespace jvm {
 		 */
 		void read_version (Reader&);
 
+		/**
+		 * Reads the class file from an open reader
+		 */
+		void read (Reader&);
+
 		/**
 		 * Reads the constant pool
 		 */
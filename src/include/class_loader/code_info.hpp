@@ -6,15 +6,125 @@ namespace jvm {
 
 	typedef std::shared_ptr<InstructionInfo> (*InstructionInfoInstantiator)();
 
-	class CodeInfo : public std::map<int, std::shared_ptr<InstructionInfo>, std::less<int>> {
+	/**
+	 * Opcodes the engine rewrites an instruction into once it is resolved, taken from the range
+	 * the JVM leaves unused. The info of the instruction keeps describing the original bytecode
+	 */
+	enum QuickOpcodes : u1 {
+		GETSTATIC_QUICK     = 203,	///> getstatic of an initialized class, cache points to the value, value is the type of the field
+		PUTSTATIC_QUICK     = 204,	///> putstatic of an initialized class, cache points to the value, value is the type of the field
+		INVOKESTATIC_QUICK  = 205,	///> invokestatic of an initialized class, cache is the call site
+		LDC_QUICK           = 206,	///> ldc or ldc_w of an int or a float, value is the constant, type 'I' or 'F'
+		LDC_STRING_QUICK    = 207,	///> ldc or ldc_w of a string, value is the index of the literal in the string pool
+		LDC2_W_QUICK        = 208,	///> ldc2_w, cache points to the constant, type 'J' or 'D'
+		GETFIELD_QUICK      = 209,	///> getfield, value is the offset of the field, type is the type of the field
+		PUTFIELD_QUICK      = 210,	///> putfield, value is the offset of the field, type is the type of the field
+		NEW_QUICK           = 211,	///> new of an initialized class, cache is its class entry, value is the instance size
+		INVOKEVIRTUAL_QUICK = 212,	///> invokevirtual or invokeinterface of a method in bytecode, cache is the call site
+		INVOKESPECIAL_QUICK = 213,	///> invokespecial of a method in bytecode, cache is the call site
+		INVOKENATIVE_QUICK  = 214,	///> any invoke of a native method, cache is the call site
+		NEW_BUILDER_QUICK   = 215,	///> new of java/lang/StringBuilder
+		MULTIANEWARRAY_QUICK = 216	///> multianewarray, cache is the element types and classes of its levels
+	};
+
+	/**
+	 * Opcodes of the superinstructions, a sequence of bytecodes run by a single handler. The first instruction of
+	 * the sequence is rewritten into it, the others are left in place so a branch into the sequence still runs them.
+	 * The handlers read the operands from the instructions of the sequence
+	 */
+	enum SuperOpcodes : u1 {
+		ILOAD_ILOAD                 = 230,	///> iload x; iload y
+		ILOAD_ILOAD_IADD_ISTORE     = 231,	///> iload x; iload y; iadd; istore z
+		ALOAD_ILOAD_IALOAD          = 232,	///> aload a; iload i; iaload
+		ALOAD_ILOAD_ILOAD_IASTORE   = 233,	///> aload a; iload i; iload x; iastore
+		ILOAD_ILOAD_IF_ICMPLT       = 234,	///> iload x; iload y; if_icmplt
+		ILOAD_ILOAD_IF_ICMPGE       = 235,	///> iload x; iload y; if_icmpge
+		ILOAD_ICONST_IF_ICMPLT      = 236,	///> iload x; iconst, bipush or sipush; if_icmplt
+		ILOAD_ICONST_IF_ICMPGE      = 237,	///> iload x; iconst, bipush or sipush; if_icmpge
+		IINC_GOTO                   = 238,	///> iinc; goto, the back edge of the loops of javac
+		IINC_ILOAD_ILOAD_IF_ICMPLT  = 239	///> iinc; iload x; iload y; if_icmplt, the back edge of the loops of ecj
+	};
+
+	/**
+	 * Sequence of bytecodes fused into a superinstruction
+	 */
+	struct Superinstruction {
+		const char *name;	///> Name to enable it with, the mnemonics of the sequence joined by '_'
+
+		u1 opcode;	///> One of the SuperOpcodes
+
+		std::vector<u1> sequence;	///> Opcodes of the sequence, as CodeInfo::family gives them
+	};
+
+	/**
+	 * Compact pre-decoded instruction, stored at the index of its PC
+	 */
+	struct Instruction {
+		static const u2 UNREACHABLE = 0xFFFF;	///> Depth of the instructions the verifier never reached
+
+		u1 opcode;              ///> Opcode to be executed
+		u1 type;                ///> Type of the value of a quick form, the first character of its descriptor
+		u2 jmp;                 ///> Number of bytes of the arguments read
+		u2 index;               ///> Local variable or constant pool index
+		u2 depth;               ///> Operand stack slots in use before the instruction, as the verifier found them
+		i4 value;               ///> Immediate operand (byte, short, iinc constant, atype or dimensions)
+		u4 target;              ///> Absolute PC of the branch target (or the default target of a switch)
+		InstructionInfo *info;  ///> Full decoded instruction, nullptr for the bytes that are arguments
+		const void *handler;    ///> Address of the handler in the threaded interpreter
+		void *cache;            ///> Data the engine resolved for this instruction, e.g. the call site cache
+
+		/**
+		 * @return the instruction that follows this one, when it does not branch
+		 */
+		Instruction *next() {
+			return this + jmp + 1;
+		}
+	};
+
+	class CodeInfo : public std::vector<Instruction> {
 	public:
 
 		/**
-		 * Given an opcode, it will get the right instruction
+		 * Decodes the bytecode into a vector indexed by PC
 		 * @params data vector of bytes to be interpreted
 		 */
 		void interpret(std::vector<u1> &);
 
+		/**
+		 * Rewrites the first instruction of every sequence of an enabled superinstruction into it.
+		 * Runs after the verifier, which reads the original opcodes
+		 * @param enabled opcodes of the superinstructions tried, the longest sequences are tried first
+		 */
+		void fuse(const std::vector<u1> &enabled);
+
+		/**
+		 * @return the superinstructions the engine has a handler for
+		 */
+		static const std::vector<Superinstruction> &superinstructions();
+
+		/**
+		 * @return the superinstruction of an opcode, nullptr when it is not one
+		 */
+		static const Superinstruction *superinstruction(u1 opcode);
+
+		/**
+		 * @return number of bytecodes an opcode runs: the length of the sequence of a superinstruction, 1 otherwise
+		 */
+		static u1 sequenceLength(u1 opcode);
+
+		/**
+		 * Folds the forms of an instruction that only differ in an operand: iload_<n> into iload, and so on for the
+		 * other loads and stores, the int constants into bipush, goto_w into goto
+		 * and the quick forms into their bytecode
+		 * @return the opcode of the family of an opcode
+		 */
+		static u1 family(u1 opcode);
+
+		/**
+		 * @return the mnemonic of an opcode, of a family or of a superinstruction
+		 */
+		static std::string mnemonic(u1 opcode);
+
 		/**
 		 * Print the content of the class
 		 * @param os used to output data
@@ -23,7 +133,9 @@ namespace jvm {
 		void printToStream(std::ostream &, std::string &);
 
 	private:
-		
+
+		std::vector<std::shared_ptr<InstructionInfo>> instructions;	///> Owner of the full decoded instructions
+
 		static InstructionInfoInstantiator instruction_set[256];	///> The set of instantiators to the instruction
 
 		/**
@@ -32,6 +144,14 @@ namespace jvm {
 		 * @return the shared pointer to the instruction
 		 */
 		std::shared_ptr<InstructionInfo> getInstr(u1 &);
+
+		/**
+		 * Fills the compact form of the instruction at a given PC
+		 * @param pc index of the opcode in the data vector
+		 * @param data vector of bytes being interpreted
+		 * @param instr compact instruction to be filled
+		 */
+		static void decode(u4, std::vector<u1> &, Instruction &);
 	};
 
 };
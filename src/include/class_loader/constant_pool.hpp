@@ -3,6 +3,7 @@
 #include "base.hpp"
 #include "util/reader.hpp"
 #include "util/JvmException.hpp"
+#include "util/symbols.hpp"
 
 namespace jvm {
 
@@ -272,8 +273,6 @@ namespace jvm {
 	struct CP_Utf8 final : public CP_Entry {
 		explicit CP_Utf8(Reader& reader);
 
-		~CP_Utf8() override;
-
 		CP_TAGS getTag() override;
 
 		void printToStream(std::ostream &os, ConstantPool &cp) override;
@@ -284,7 +283,9 @@ namespace jvm {
 
 		uint16_t _length;
 
-		uint8_t *_bytes;
+		const uint8_t *_bytes;  ///< Points into the class file, kept alive by the ClassLoader
+
+		uint32_t symbol;        ///< Id of the text in the Symbols table
 	};
 
 	std::ostream& operator<< (std::ostream&, CP_Utf8&);
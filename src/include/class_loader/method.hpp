@@ -14,6 +14,8 @@ namespace jvm {
 
 		AttributeInfo attributes;              ///< An attribute structure
 
+		std::unordered_map<uint32_t, std::vector<bool>> gcMaps; ///< Slots holding references, locals then operands, where the collector may run, by PC
+
 		/**
 		 * Constructor default
 		 */
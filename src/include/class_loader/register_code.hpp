@@ -0,0 +1,122 @@
+#pragma once
+
+#include "code_info.hpp"
+#include "runtime_constant_pool.hpp"
+
+namespace jvm {
+
+	struct AttrCode;
+
+	/**
+	 * Opcodes of the register code. The registers are the slots of the frame: the locals, then the operand stack.
+	 * dst, a and b name the registers written and read, value is a constant operand and target an index in the code
+	 */
+	enum RegisterOpcodes : u1 {
+		R_STACK,                ///> Runs the bytecode at pc with the stack handlers, depth slots of the operand stack in use
+		R_MOVE,                 ///> dst = a
+		R_MOVE2,                ///> dst = a, a long or a double
+		R_CONST,                ///> dst = value
+		R_CONST2,               ///> dst = value, a long
+		R_IADD,                 ///> dst = a + b, as do the int operations below
+		R_ISUB,
+		R_IMUL,
+		R_IAND,
+		R_IOR,
+		R_IXOR,
+		R_ISHL,
+		R_ISHR,
+		R_IUSHR,
+		R_IADD_CONST,           ///> dst = a + value, also isub of a constant
+		R_INEG,                 ///> dst = -a
+		R_LADD,                 ///> dst = a + b, as do the long and double operations below
+		R_LSUB,
+		R_LMUL,
+		R_DADD,
+		R_DSUB,
+		R_DMUL,
+		R_DDIV,
+		R_I2L,                  ///> dst = (long) a, as do the conversions below
+		R_L2I,
+		R_I2D,
+		R_IINC,                 ///> dst += value
+		R_IALOAD,               ///> dst = a[b]
+		R_IASTORE,              ///> a[b] = dst
+		R_ARRAYLENGTH,          ///> dst = a.length
+		R_GOTO,                 ///> Jumps to target
+		R_IFEQ,                 ///> Jumps to target when a == 0, as do the other comparisons with 0 below
+		R_IFNE,
+		R_IFLT,
+		R_IFGE,
+		R_IFGT,
+		R_IFLE,
+		R_IF_ICMPEQ,            ///> Jumps to target when a == b, as do the other comparisons below
+		R_IF_ICMPNE,
+		R_IF_ICMPLT,
+		R_IF_ICMPGE,
+		R_IF_ICMPGT,
+		R_IF_ICMPLE,
+		R_IF_ICMPEQ_CONST,      ///> Jumps to target when a == value, as do the other comparisons with a constant below
+		R_IF_ICMPNE_CONST,
+		R_IF_ICMPLT_CONST,
+		R_IF_ICMPGE_CONST,
+		R_IF_ICMPGT_CONST,
+		R_IF_ICMPLE_CONST,
+		R_IF_ACMPEQ,            ///> Jumps to target when the references a and b are equal
+		R_IF_ACMPNE,
+		R_IFNULL,               ///> Jumps to target when a is null
+		R_IFNONNULL
+	};
+
+	/**
+	 * Instruction of the register code, a whole sequence of loads, an operation and a store when they fold
+	 */
+	struct RegisterInstruction {
+		u1 opcode;	///> One of the RegisterOpcodes
+
+		u1 type;	///> Type tag of the value written to dst, checked by the stack handlers of the debug builds, 0 when nothing is written
+
+		u2 dst;	///> Register written, or the value stored by R_IASTORE
+
+		u2 a;	///> First register read
+
+		u2 b;	///> Second register read
+
+		u2 depth;	///> R_STACK: operand stack slots in use, Instruction::UNREACHABLE to leave them as they are
+
+		i4 value;	///> Constant operand
+
+		u4 target;	///> Index of the branch target in the register code
+
+		u4 pc;	///> R_STACK: PC of the bytecode run
+	};
+
+	/**
+	 * Code of a method translated from the operand stack to registers. The operand stack slot of a given depth is
+	 * always the same register, so the stack handlers run the bytecodes the register code has no instruction for
+	 * on the same frame. The loads and the constants are pending until their consumer reads the local or the
+	 * constant directly, and a store of the result of an operation makes the operation write the local instead
+	 */
+	class RegisterCode : public std::vector<RegisterInstruction> {
+	public:
+		/**
+		 * Translates the code of a method, after the verifier has set the depth of the operand stack of the instructions
+		 * @param codeAttr code of the method
+		 * @param runtime runtime constant pool of the class, for the int and float constants of ldc
+		 */
+		void translate(AttrCode &codeAttr, RuntimeConstantPool &runtime);
+
+		/**
+		 * @return index of the instruction where the register code resumes at a PC: the start of the method,
+		 * a branch target or the instruction after a bytecode run with the stack handlers
+		 */
+		u4 entry(u4 pc) const {
+			return entries[pc];
+		}
+
+		u2 locals = 0;	///> Number of locals, the first operand stack register
+
+	private:
+		std::vector<u4> entries;	///> Index of the first instruction of each bytecode, by PC
+	};
+
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "constant_pool.hpp"
+
+namespace jvm {
+
+	class ClassLoader;
+
+	/**
+	 * Entry of the runtime constant pool, the symbolic reference already walked
+	 */
+	struct RuntimeEntry {
+		u1 tag = 0;	///> CP_TAGS of the entry, 0 for the unusable slots
+
+		op8 value;	///> Value of Integer, Float, Long and Double constants, index of a String in the pool of interned strings plus one once used
+
+		u4 text = 0;	///> Symbol of the text of Utf8 and String, of the name of Class and of the member of field and method references
+
+		u4 descriptor = 0;	///> Symbol of the descriptor of field and method references, NameAndType and MethodType
+
+		u2 classIndex = 0;	///> Class of field and method references
+
+		ClassLoader *classLoader = nullptr;	///> Class of a Class entry, or class declaring the static field of a field reference, set the first time it is used
+
+		u4 offset = 0;	///> Offset of the field of a field reference in the object or in the static storage, set the first time it is used
+
+		char fieldType = 0;	///> First character of the descriptor of a field reference, 0 until it is first used
+	};
+
+	/**
+	 * Constant pool resolved when the class is linked. Indexed like the constant pool,
+	 * the slot 0 is unused, so reading an entry is a single indexed load.
+	 */
+	class RuntimeConstantPool : public std::vector<RuntimeEntry> {
+	public:
+		/**
+		 * Resolves every entry of a constant pool
+		 * @param cp the constant pool read from the class file
+		 */
+		void build(ConstantPool &);
+
+		RuntimeEntry &operator[](size_type index) {
+			return data()[index];
+		}
+	};
+
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "class_loader.hpp"
+
+namespace jvm {
+
+	/**
+	 * Types tracked by the verifier for each local variable and operand stack slot.
+	 * Long and double take two slots, the second one is V_TOP
+	 */
+	enum VerifierType : u1 {
+		V_TOP            = 0,
+		V_INT            = 1,
+		V_FLOAT          = 2,
+		V_LONG           = 3,
+		V_DOUBLE         = 4,
+		V_REF            = 5,
+		V_RETURN_ADDRESS = 6
+	};
+
+	/**
+	 * Types of the local variables and of the operand stack before an instruction
+	 */
+	struct VerifierFrame {
+		bool visited = false;	///> Whether the instruction is reachable
+		std::vector<u1> locals;	///> Type of each local variable
+		std::vector<u1> stack;	///> Type of each operand stack slot, bottom first
+	};
+
+	/**
+	 * Load-time bytecode verifier. Proves, for every instruction, the depth and the type
+	 * of every slot of the operand stack, so the engine may run without checking them.
+	 * Throws a JvmException starting with "VerifyError" when a method is not valid.
+	 */
+	class Verifier {
+	public:
+		/**
+		 * Verifies every method of a class
+		 * @param classLoader class to be verified
+		 */
+		static void verify(ClassLoader &);
+
+		/**
+		 * Verifies one method
+		 * @param classLoader class of the method
+		 * @param method method to be verified
+		 */
+		static void verify(ClassLoader &, MethodInfo &);
+
+	private:
+		/**
+		 * Constructor
+		 * @param classLoader class of the method
+		 * @param method method to be verified
+		 * @param code code attribute of the method
+		 */
+		Verifier(ClassLoader &, MethodInfo &, AttrCode &);
+
+		/**
+		 * Runs the data-flow analysis until every reachable instruction has a stable frame
+		 */
+		void run();
+
+		/**
+		 * Simulates the current instruction over the frame
+		 * @param frame types before the instruction, changed to the types after it
+		 */
+		void execute(VerifierFrame &);
+
+		/**
+		 * Merges a frame into the frame of an instruction, queueing it when it changes
+		 * @param pc position of the instruction that receives the frame
+		 * @param frame frame to be merged
+		 */
+		void merge(u4, const VerifierFrame &);
+
+		void push(VerifierFrame &, u1);
+
+		u1 pop(VerifierFrame &);
+
+		void pop(VerifierFrame &, u1);
+
+		void load(VerifierFrame &, u4, u1);
+
+		void store(VerifierFrame &, u4, u1);
+
+		/**
+		 * Pushes the value of a descriptor, nothing for V
+		 */
+		void pushDescriptor(VerifierFrame &, const std::string &);
+
+		/**
+		 * Pops the arguments of a method descriptor, last one first
+		 */
+		void popArguments(VerifierFrame &, const std::string &);
+
+		/**
+		 * Gets the descriptor of a field, method or invokedynamic constant pool entry
+		 */
+		std::string getDescriptor(u2);
+
+		/**
+		 * @return the type of a descriptor starting at position i
+		 */
+		static u1 typeOf(const std::string &, u4 i = 0);
+
+		/**
+		 * Throws a VerifyError about the current instruction
+		 */
+		[[noreturn]] void fail(const std::string &);
+
+		ClassLoader &cl;	///> Class of the method
+
+		MethodInfo &mt;	///> Method being verified
+
+		AttrCode &codeAttr;	///> Code of the method
+
+		std::vector<VerifierFrame> frames;	///> Frame before each instruction, indexed by PC
+
+		std::vector<u4> pending;	///> Instructions whose frame changed
+
+		u4 pc = 0;	///> Instruction being verified
+	};
+
+}
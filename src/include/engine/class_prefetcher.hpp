@@ -0,0 +1,109 @@
+#pragma once
+
+#include <mutex>
+#include <deque>
+#include <thread>
+#include <condition_variable>
+
+#include "class_loader/class_loader.hpp"
+
+namespace jvm {
+
+	/**
+	 * Loads, in the background, the classes referenced by the constant pool of the classes already loaded,
+	 * so the engine finds them parsed when they are first used. With no workers every class is loaded
+	 * as soon as it is referenced, in a fixed order, which keeps the mode deterministic.
+	 */
+	class ClassPrefetcher {
+	public:
+		/**
+		 * Default constructor
+		 */
+		ClassPrefetcher() = default;
+
+		/**
+		 * Stops the workers, the classes not taken yet are dropped
+		 */
+		~ClassPrefetcher();
+
+		/**
+		 * Starts the prefetching
+		 * @param path directory where the .class files are
+		 * @param workers number of threads, 0 loads every class on the caller's thread
+		 */
+		void start(const std::string &, u4);
+
+		/**
+		 * Requests the classes referenced by the constant pool of a class
+		 * @param classLoader class already loaded
+		 */
+		void request(ClassLoader &);
+
+		/**
+		 * Takes a prefetched class, waiting for it if it is still being parsed
+		 * @param className name of the class
+		 * @return the class, or nullptr if it was not requested or could not be read
+		 */
+		std::unique_ptr<ClassLoader> take(const std::string &);
+
+		/**
+		 * Prints how many classes were prefetched and how much loading time it hid from the interpreter
+		 * @param os used to output data
+		 */
+		void printStats(std::ostream &);
+
+	private:
+		struct Entry {
+			bool done = false;	///> Whether the parsing finished
+			std::unique_ptr<ClassLoader> classLoader;	///> Parsed class, nullptr if it failed or was taken
+			double seconds = 0;	///> Time spent parsing it
+		};
+
+		/**
+		 * Requests one class, unless it was requested before
+		 * @param className name of the class
+		 */
+		void request(const std::string &);
+
+		/**
+		 * @return names of the classes referenced by the constant pool of a class
+		 */
+		static std::vector<std::string> references(ClassLoader &);
+
+		/**
+		 * Parses a class and requests the classes it references
+		 * @param className name of the class
+		 */
+		void load(const std::string &);
+
+		/**
+		 * Loop of each worker thread
+		 */
+		void work();
+
+		std::string path;	///> Directory where the .class files are
+
+		bool serial = true;	///> Load on the caller's thread, no workers
+
+		bool stopping = false;	///> Tells the workers to finish
+
+		std::vector<std::thread> workers;	///> Threads of the pool
+
+		std::deque<std::string> queue;	///> Classes waiting for a worker
+
+		std::unordered_map<std::string, Entry> entries;	///> Every class requested
+
+		std::mutex mutex;	///> Guards everything above
+
+		std::condition_variable pending;	///> Signals a new class in the queue
+
+		std::condition_variable parsed;	///> Signals a class parsed
+
+		u4 taken = 0;	///> Classes handed to the engine
+
+		double hidden = 0;	///> Parsing time of the classes taken, spent on the workers
+
+		double waited = 0;	///> Time the engine waited for a class being parsed
+	};
+
+}
@@ -1,20 +1,94 @@
 #pragma once
 
 #include "base.hpp"
+#include "heap.hpp"
+#include "strings.hpp"
+#include "natives.hpp"
 #include "frames_stack.hpp"
+#include "class_prefetcher.hpp"
+#include "sequence_profiler.hpp"
 #include "class_loader/class_loader.hpp"
 
 namespace jvm {
 
 	struct ClassAndMethod {
-		ClassLoader& classLoader;
-		MethodInfo& method;
-		ClassAndMethod(ClassLoader& classLoader, MethodInfo& method) : classLoader(classLoader), method(method) {}
+		ClassLoader *classLoader;	///> Class that declares the method
+		MethodInfo *method;	///> The method, nullptr when the search reached java/lang/Object, whose methods are natives
 	};
 
+	/**
+	 * Inline cache of an invoke instruction, filled the first time it runs.
+	 * Virtual calls keep a small polymorphic cache of receiver classes.
+	 */
+	struct CallSite {
+		enum Kind : u1 {
+			INVOKE,  ///> Call to a method of a loaded class
+			NATIVE   ///> Call to a method of a library class, run by its native
+		};
+
+		static const u1 MAX_RECEIVERS = 4;	///> Receiver classes cached before the site goes megamorphic
+
+		Kind kind;	///> What the call does
+
+		NativeMethod native;	///> Native run by a NATIVE call
+
+		u2 nargs;	///> Slots of arguments
+
+		u1 receivers;	///> Number of receiver classes cached
+
+		u8 methodKey;	///> Symbols of the name and descriptor, to look up the method on a cache miss
+
+		u4 receiverClass[MAX_RECEIVERS];	///> Symbols of the names of the receiver classes, the first one is the resolved class
+
+		ClassLoader *targetClass[MAX_RECEIVERS];	///> Class where the method was found for each receiver
+
+		MethodInfo *targetMethod[MAX_RECEIVERS];	///> Method called for each receiver, nullptr when a native runs it
+
+		NativeMethod targetNative[MAX_RECEIVERS];	///> Native run for each receiver of a library class or that inherits the method of java/lang/Object
+	};
+
+	/**
+	 * Recipe of an invokedynamic string concatenation (java/lang/invoke/StringConcatFactory),
+	 * parsed the first time it runs. The result is made of pieces: constant characters, then an argument
+	 */
+	struct ConcatSite {
+		struct Piece {
+			u4 constant;	///> Number of constant characters before the argument
+			char type;	///> First character of the descriptor of the argument, 0 for the constant characters after the last one
+			u2 slot;	///> Slot of the argument, from the first one
+		};
+
+		std::vector<u1> constants;	///> Constant characters of every piece, in the coder
+
+		u1 coder;	///> StringObject::UTF16 when a constant character is out of Latin-1
+
+		std::vector<Piece> pieces;	///> Pieces of the result, in order
+
+		u2 nargs;	///> Slots of arguments
+
+		std::vector<char> texts;	///> Latin-1 text of the arguments that are not strings, NumberFormat::MAX_LENGTH characters for each piece
+
+		std::vector<u4> lengths;	///> Characters of the text of each piece in texts
+
+		std::vector<std::string> objects;	///> Text of Object.toString of the arguments of each piece that are other objects
+	};
+
+	/**
+	 * Element types and classes of the levels of a multianewarray, resolved the first time it runs
+	 */
+	struct MultiArraySite {
+		u1 elementTypes[Heap::MAX_DIMENSIONS];	///> Element type of the arrays of each level
+
+		u4 klasses[Heap::MAX_DIMENSIONS];	///> Symbol of the element class of the arrays of each level, 0 for primitive elements
+	};
+
+#if defined(__GNUC__) && !defined(JVM_NO_THREADED_DISPATCH)
+	#define JVM_THREADED_DISPATCH // labels as values are available
+#endif
+
 	class Engine;
 
-	typedef void (Engine::*Execution) (InstructionInfo *);
+	typedef void (Engine::*Execution) (Instruction *);
 
 	/**
 	 * Class that run a single thread virtual machine
@@ -35,17 +109,55 @@ namespace jvm {
 
 		std::string path;
 
+		bool threaded = false;	///> Run with the threaded (computed goto) interpreter
+
+		bool benchmark = false;	///> Report the executed instructions per second
+
+		bool prefetch = false;	///> Load the referenced classes ahead of their first use
+
+		u4 prefetchWorkers = 0;	///> Threads loading classes ahead, 0 loads them in order on the engine thread
+
+		u8 heapSize = Heap::DEFAULT_CAPACITY;	///> Bytes reserved for the heap
+
+		u8 nurserySize = Heap::DEFAULT_NURSERY;	///> Bytes of the heap for the young generation, 0 for a single generation
+
+		bool gcStats = false;	///> Report the allocation and collection statistics at exit
+
+		std::vector<u1> superinstructions;	///> Opcodes of the superinstructions fused into the code of the classes, none by default
+
+		u4 sequences = 0;	///> Number of the most executed sequences of bytecodes reported at exit, 0 does not profile them
+
+		bool registers = false;	///> Run the code translated to registers, instead of the superinstructions
+
 	private:
 
+		u8 executed = 0;	///> Number of instructions executed
+
 		std::vector<Execution> exec;	///> The set of instantiators to the instruction
 
-		std::unordered_map<std::string, ClassLoader> JavaClasses;	///> Reference to .class that will be executed first
+		std::unordered_map<u4, ClassLoader> JavaClasses;	///> Reference to .class that will be executed first
 
-		std::string Entry_class_name;	///> Name of .class that will be executed first
+		u4 Entry_class_name;	///> Symbol of the name of .class that will be executed first
 
 		FramesStack fs;	///> Frame Stack
 
-		std::vector<void*> mem;	///> Engine heap mem
+		ClassPrefetcher prefetcher;	///> Classes loaded ahead of their first use
+
+		std::deque<CallSite> callSites;	///> Inline caches of the invoke instructions
+
+		std::deque<ConcatSite> concatSites;	///> Recipes of the invokedynamic string concatenations
+
+		std::deque<MultiArraySite> multiArraySites;	///> Levels of the multianewarray instructions
+
+		Heap heap;	///> Objects and arrays
+
+		Strings strings {heap};	///> String objects and the pool of the interned ones
+
+		SequenceProfiler profiler;	///> Sequences of bytecodes executed, when they are reported
+
+		PrintStream out {std::cout};	///> System.out, buffered until it is flushed or the engine exits
+
+		Natives natives {heap, strings, out};	///> Methods and static fields of the library classes
 
 		//> Method Area
 		// TODO: understand
@@ -58,22 +170,169 @@ namespace jvm {
 		Execution getExecutor(u1);
 
 		/**
-		 * Run the clinit method
+		 * Interpreter loop that dispatches every instruction through the table of executors
+		 */
+		void run();
+
+		/**
+		 * Interpreter loop of run() that also counts the instructions executed, for the benchmark, and the sequences
+		 * of bytecodes executed, for the superinstructions
+		 */
+		void runProfiling();
+
+		/**
+		 * Interpreter loop of the code translated to registers, the method on top of the frames stack at a time
+		 */
+		void runRegisters();
+
+		/**
+		 * Runs the register code of a frame until it calls, returns or waits on a <clinit>
+		 * @tparam counting whether it counts the instructions executed, for the benchmark
+		 * @param frame the frame on top of the frames stack
+		 * @param code its register code
+		 */
+		template <bool counting>
+		void runRegisters(Frame &frame, const RegisterCode &code);
+
+#ifdef JVM_THREADED_DISPATCH
+		const void **handlers = nullptr;	///> Addresses of the handlers of the threaded interpreter that runs, by opcode
+
+		/**
+		 * Threaded interpreter loop, each handler jumps straight to the handler of the next instruction
+		 * @tparam counting whether the handlers count the instructions executed, for the benchmark
+		 * @param run false only returns the addresses of the handlers, without running anything
+		 * @return the addresses of the handlers, by opcode
+		 */
+		template <bool counting>
+		const void **runThreaded(bool run);
+#endif
+
+		/**
+		 * Prepares a loaded class to be executed
+		 * @param classLoader the class just loaded
+		 */
+		void link(ClassLoader &);
+
+		/**
+		 * Collects the heap. The roots are the reference slots of every frame, told by the GC maps of the verifier
 		 */
-		void run_clinit();
+		void collectGarbage();
+
+		/**
+		 * Starts the initialization of a class on its first active use: pushes the frames of the <clinit>
+		 * methods of the class and of its superclasses not yet initialized, the superclasses on top.
+		 * The instruction that triggered it must not advance the PC, so it runs again after them
+		 * @param classLoader class used
+		 * @return whether a <clinit> frame was pushed
+		 */
+		bool run_clinit(ClassLoader &);
 
 		/**
 		 * Run the init method
 		 */
 		void run_init();
 
-		ClassAndMethod findMethod(CP_Methodref &ref);
+		/**
+		 * Gets the superclass of a class, loading it the first time
+		 * @return the superclass, nullptr when it is a library class
+		 */
+		ClassLoader *findSuper(ClassLoader &);
+
+		/**
+		 * Checks whether an object may be stored where a type is expected, as aastore and arraycopy do
+		 * @param klass symbol of the class of the object, or of the descriptor of an array
+		 * @param type symbol of the expected class, or of the descriptor of an array
+		 * @return whether the class is the type, a subclass of it or implements it
+		 */
+		bool isAssignable(u4 klass, u4 type);
+
+		/**
+		 * Rewrites an instruction into one of the QuickOpcodes, for the interpreter in use
+		 * @param data the instruction, its cache already holds what the quick form needs
+		 * @param opcode the quick opcode
+		 */
+		void quicken(Instruction *data, u1 opcode);
+
+		/**
+		 * Finds a method in a class or in its superclasses
+		 * @param classLoader class where the search starts
+		 * @param methodKey Symbols::key of the name and descriptor of the method
+		 * @return the method, or a null method when no loaded class declares it and the search reached java/lang/Object
+		 */
+		ClassAndMethod findMethod(ClassLoader &classLoader, u8 methodKey);
+
+		/**
+		 * Gets the inline cache of an invoke, resolving the call the first time
+		 * @param data the invoke instruction
+		 */
+		CallSite &getCallSite(Instruction *data);
+
+		/**
+		 * Gets the recipe of an invokedynamic string concatenation, parsing its bootstrap arguments the first time
+		 * @param data the invokedynamic instruction
+		 */
+		ConcatSite &getConcatSite(Instruction *data);
+
+		/**
+		 * Finds the method a virtual call runs for a receiver class, through the inline cache
+		 * @param site inline cache of the call
+		 * @param receiver symbol of the name of the class of the receiver
+		 * @return index of the receiver in the cache
+		 */
+		u1 lookupReceiver(CallSite &site, u4 receiver);
+
+		/**
+		 * Binds the method a receiver class runs to an entry of an inline cache: its own or an inherited method, or the
+		 * native of a library class, java/lang/Object included, throwing UnsatisfiedLinkError when none is registered
+		 * @param site inline cache of the call
+		 * @param i entry of the cache
+		 * @param receiver symbol of the name of the class of the receiver
+		 */
+		void bindReceiver(CallSite &site, u1 i, u4 receiver);
 
-		ClassAndMethod findMethod(CP_Class &classInfo, std::string &nameAndDescriptor);
+		/**
+		 * Gets a class, loading it the first time
+		 * @param className symbol of the name of the class
+		 */
+		ClassLoader& findClass(u4 className);
 
-		ClassLoader& findClass(CP_Class &classInfo);
+		/**
+		 * Gets the class of a Class entry of the runtime constant pool, loading it the first time
+		 * @param classLoader class that owns the constant pool
+		 * @param index index of the Class entry
+		 */
+		ClassLoader& resolveClass(ClassLoader &classLoader, u2 index);
 
-		ClassLoader& findClass(std::string& class_name);
+		/**
+		 * Gets a field reference of the runtime constant pool, finding the offset of the field the first time
+		 * @param classLoader class that owns the constant pool
+		 * @param index index of the FieldRef entry
+		 */
+		RuntimeEntry& resolveField(ClassLoader &classLoader, u2 index);
+
+		/**
+		 * Gets a static field reference of the runtime constant pool, finding the class that declares it the first time
+		 * @param classLoader class that owns the constant pool
+		 * @param index index of the FieldRef entry
+		 */
+		RuntimeEntry& resolveStaticField(ClassLoader &classLoader, u2 index);
+
+		/**
+		 * Gets an element of an array, throwing the NullPointerException or the ArrayIndexOutOfBoundsException
+		 * @param arrayref reference to the array
+		 * @param index index of the element
+		 * @return the element, of the Java width of the array
+		 */
+		template <typename T>
+		T *arrayElement(u4 arrayref, i4 index);
+
+		/**
+		 * Finds the class declaring a static field: the class itself, its superinterfaces or its superclasses
+		 * @param classLoader class where the search starts
+		 * @param fieldKey Symbols::key of the name and descriptor of the field
+		 * @return the class, nullptr when the field is not found
+		 */
+		ClassLoader *findStaticField(ClassLoader &classLoader, u8 fieldKey);
 
 		/**
 		 * Get the arguments of a method based on a descriptor
@@ -84,1027 +343,1147 @@ namespace jvm {
 		/**
 		 * Nothing
 		 */
-		void exec_nop (InstructionInfo *);
+		void exec_nop (Instruction *);
 
 		/**
 		 * Push the null object reference onto the operand stack.
 		 */
-		void exec_aconst_null (InstructionInfo *);
+		void exec_aconst_null (Instruction *);
 
 		/**
 		 *Push the int constant <i> (-1, 0, 1, 2, 3, 4 or 5) onto the operand stack.
 		 */
-		void exec_iconst_m1 (InstructionInfo *);
+		void exec_iconst_m1 (Instruction *);
 
 		/**
 		 * Push the int constant <i> (-1, 0, 1, 2, 3, 4 or 5) onto the operand stack.
 		 */
-		void exec_iconst_0 (InstructionInfo *);
+		void exec_iconst_0 (Instruction *);
 
 		/**
 		 * Push the int constant <i> (-1, 0, 1, 2, 3, 4 or 5) onto the operand stack.
 		 */
-		void exec_iconst_1 (InstructionInfo *);
+		void exec_iconst_1 (Instruction *);
 
 		/**
 		 * Push the int constant <i> (-1, 0, 1, 2, 3, 4 or 5) onto the operand stack.
 		 */
-		void exec_iconst_2 (InstructionInfo *);
+		void exec_iconst_2 (Instruction *);
 
 		/**
 		 *  Push the int constant <i> (-1, 0, 1, 2, 3, 4 or 5) onto the operand stack.
 		 */
-		void exec_iconst_3 (InstructionInfo *);
+		void exec_iconst_3 (Instruction *);
 
 		/**
 		 * Push the int constant <i> (-1, 0, 1, 2, 3, 4 or 5) onto the operand stack.
 		 */
-		void exec_iconst_4 (InstructionInfo *);
+		void exec_iconst_4 (Instruction *);
 
 		/**
 		 * Push the int constant <i> (-1, 0, 1, 2, 3, 4 or 5) onto the operand stack.
 		 */
-		void exec_iconst_5 (InstructionInfo *);
+		void exec_iconst_5 (Instruction *);
 
 		/**
 		 * Push the long constant <l> (0 or 1) onto the operand stack.
 		 */
-		void exec_lconst_0 (InstructionInfo *);
+		void exec_lconst_0 (Instruction *);
 
 		/**
 		 *Push the long constant <l> (0 or 1) onto the operand stack.
 		 */
-		void exec_lconst_1 (InstructionInfo *);
+		void exec_lconst_1 (Instruction *);
 
 		/**
 		 * Push the float constant <f> (0.0, 1.0, or 2.0) onto the operand stack.
 		 */
-		void exec_fconst_0 (InstructionInfo *);
+		void exec_fconst_0 (Instruction *);
 
 		/**
 		 * Push the float constant <f> (0.0, 1.0, or 2.0) onto the operand stack.
 		 */
-		void exec_fconst_1 (InstructionInfo *);
+		void exec_fconst_1 (Instruction *);
 
 		/**
 		 * Push the float constant <f> (0.0, 1.0, or 2.0) onto the operand stack.
 		 */
-		void exec_fconst_2 (InstructionInfo *);
+		void exec_fconst_2 (Instruction *);
 
 		/**
 		 * Push the double constant <d> (0.0 or 1.0) onto the operand stack.
 		 */
-		void exec_dconst_0 (InstructionInfo *);
+		void exec_dconst_0 (Instruction *);
 
 		/**
 		 * Push the double constant <d> (0.0 or 1.0) onto the operand stack.
 		 */
-		void exec_dconst_1 (InstructionInfo *);
+		void exec_dconst_1 (Instruction *);
 
 		/**
 		 * Push byte
 		 */
-		void exec_bipush (InstructionInfo *);
+		void exec_bipush (Instruction *);
 
 		/**
 		 * Push short
 		 */
-		void exec_sipush (InstructionInfo *);
+		void exec_sipush (Instruction *);
 
 		/**
 		 * Push item from run-time constant pool
 		 */
-		void exec_ldc (InstructionInfo *);
+		void exec_ldc (Instruction *);
 
 		/**
 		 * Push item from run-time constant pool (wide index) (byte1 <<8 | byte2) são juntos em 16 bits para 1 index so
 		 */
-		void exec_ldc_w (InstructionInfo *);
+		void exec_ldc_w (Instruction *);
 
 		/**
 		 * Push long or double from run-time constant pool (wide index)
 		 */
-		void exec_ldc2_w (InstructionInfo *);
+		void exec_ldc2_w (Instruction *);
 
 		/**
 		 * Load int from local variable push to stack
 		 */
-		void exec_iload (InstructionInfo *);
+		void exec_iload (Instruction *);
 
 		/**
 		 * Load long from local variable
 		 */
-		void exec_lload (InstructionInfo *);
+		void exec_lload (Instruction *);
 
 		/**
 		 * Load float from local variable
 		 */
-		void exec_fload (InstructionInfo *);
+		void exec_fload (Instruction *);
 
 		/**
 		 * Load double from local variable
 		 */
-		void exec_dload (InstructionInfo *);
+		void exec_dload (Instruction *);
 
 		/**
 		 * Load reference from local variable
 		 */
-		void exec_aload (InstructionInfo *);
+		void exec_aload (Instruction *);
 
 		/**
 		 * Load int from local variable index 1
 		 */
-		void exec_iload_0 (InstructionInfo *);
+		void exec_iload_0 (Instruction *);
 
 		/**
 		 * Load int from local variable index 2
 		 */
-		void exec_iload_1 (InstructionInfo *);
+		void exec_iload_1 (Instruction *);
 
 		/**
 		 * Load int from local variable index 3
 		 */
-		void exec_iload_2 (InstructionInfo *);
+		void exec_iload_2 (Instruction *);
 
 		/**
 		 * Load int from local variable index 4
 		 */
-		void exec_iload_3 (InstructionInfo *);
+		void exec_iload_3 (Instruction *);
 
 		/**
 		 * Load long from local variable from index 1
 		 */
-		void exec_lload_0 (InstructionInfo *);
+		void exec_lload_0 (Instruction *);
 
 		/**
 		 * Load long from local variable from index 2
 		 */
-		void exec_lload_1 (InstructionInfo *);
+		void exec_lload_1 (Instruction *);
 
 		/**
 		 * Load long from local variable from index 3
 		 */
-		void exec_lload_2 (InstructionInfo *);
+		void exec_lload_2 (Instruction *);
 
 		/**
 		 * Load long from local variable from index 4
 		 */
-		void exec_lload_3 (InstructionInfo *);
+		void exec_lload_3 (Instruction *);
 
 		/**
 		 * Load float from local variable index 1
 		 */
-		void exec_fload_0 (InstructionInfo *);
+		void exec_fload_0 (Instruction *);
 
 		/**
 		 * Load float from local variable index 2
 		 */
-		void exec_fload_1 (InstructionInfo *);
+		void exec_fload_1 (Instruction *);
 
 		/**
 		 * Load float from local variable index 3
 		 */
-		void exec_fload_2 (InstructionInfo *);
+		void exec_fload_2 (Instruction *);
 
 		/**
 		 * Load float from local variable index 4
 		 */
-		void exec_fload_3 (InstructionInfo *);
+		void exec_fload_3 (Instruction *);
 
 		/**
 		 * Load float from local variable index 1
 		 */
-		void exec_dload_0 (InstructionInfo *);
+		void exec_dload_0 (Instruction *);
 
 		/**
 		 * Load float from local variable index 2
 		 */
-		void exec_dload_1 (InstructionInfo *);
+		void exec_dload_1 (Instruction *);
 
 		/**
 		 * Load float from local variable index 3
 		 */
-		void exec_dload_2 (InstructionInfo *);
+		void exec_dload_2 (Instruction *);
 
 		/**
 		 * Load float from local variable index 4
 		 */
-		void exec_dload_3 (InstructionInfo *);
+		void exec_dload_3 (Instruction *);
 
 		/**
 		 * The execution of this instruction
 		 */
-		void exec_aload_0 (InstructionInfo *);
+		void exec_aload_0 (Instruction *);
 
 		/**
 		 * The execution of this instruction
 		 */
-		void exec_aload_1 (InstructionInfo *);
+		void exec_aload_1 (Instruction *);
 
 		/**
 		 * The execution of this instruction
 		 */
-		void exec_aload_2 (InstructionInfo *);
+		void exec_aload_2 (Instruction *);
 
 		/**
 		 * The execution of this instruction
 		 */
-		void exec_aload_3 (InstructionInfo *);
+		void exec_aload_3 (Instruction *);
 
 		/**
 		 * The execution of this instruction
 		 */
-		void exec_iaload (InstructionInfo *);
+		void exec_iaload (Instruction *);
 
 		/**
 		 * The execution of this instruction
 		 */
-		void exec_laload (InstructionInfo *);
+		void exec_laload (Instruction *);
 
 		/**
 		 * Load float from array ,arrayref and index poped from stack acquired value is pushed onto the stack
 		 */
-		void exec_faload (InstructionInfo *);
+		void exec_faload (Instruction *);
 
 		/**
 		 * Load double from array arrayref,index
 		 */
-		void exec_daload (InstructionInfo *);
+		void exec_daload (Instruction *);
 
 		/**
 		 * Load reference from array arrayref,index type reference
 		 */
-		void exec_aaload (InstructionInfo *);
+		void exec_aaload (Instruction *);
 
 		/**
 		 * Load byte or boolean from array ,arrayref,index
 		 */
-		void exec_baload (InstructionInfo *);
+		void exec_baload (Instruction *);
 
 		/**
 		 * Load char from array ,arrayref,index
 		 */
-		void exec_caload (InstructionInfo *);
+		void exec_caload (Instruction *);
 
 		/**
 		 * Load short from array arrayref,index
 		 */
-		void exec_saload (InstructionInfo *);
+		void exec_saload (Instruction *);
 
 		/**
 		 * Store int into local variable pop from stack
 		 */
-		void exec_istore (InstructionInfo *);
+		void exec_istore (Instruction *);
 
 		/**
 		 * Store long into local variable
 		 */
-		void exec_lstore (InstructionInfo *);
+		void exec_lstore (Instruction *);
 
 		/**
 		 * Store float into local variable
 		 */
-		void exec_fstore (InstructionInfo *);
+		void exec_fstore (Instruction *);
 
 		/**
 		 * Store double into local variable
 		 */
-		void exec_dstore (InstructionInfo *);
+		void exec_dstore (Instruction *);
 
 		/**
 		 * Store reference into local variable
 		 */
-		void exec_astore (InstructionInfo *);
+		void exec_astore (Instruction *);
 
 		/**
 		 * Store int into local variable index 1
 		 */
-		void exec_istore_0 (InstructionInfo *);
+		void exec_istore_0 (Instruction *);
 
 		/**
 		 * Store int into local variable index 2
 		 */
-		void exec_istore_1 (InstructionInfo *);
+		void exec_istore_1 (Instruction *);
 
 		/**
 		 * Store int into local variable index 3
 		 */
-		void exec_istore_2 (InstructionInfo *);
+		void exec_istore_2 (Instruction *);
 
 		/**
 		 * Store int into local variable index 4
 		 */
-		void exec_istore_3 (InstructionInfo *);
+		void exec_istore_3 (Instruction *);
 
 		/**
 		 * Store long into local variable index 1
 		 */
-		void exec_lstore_0 (InstructionInfo *);
+		void exec_lstore_0 (Instruction *);
 
 		/**
 		 * Store long into local variable index 2
 		 */
-		void exec_lstore_1 (InstructionInfo *);
+		void exec_lstore_1 (Instruction *);
 
 		/**
 		 * Store long into local variable index 3
 		 */
-		void exec_lstore_2 (InstructionInfo *);
+		void exec_lstore_2 (Instruction *);
 
 		/**
 		 * Store long into local variable index 4
 		 */
-		void exec_lstore_3 (InstructionInfo *);
+		void exec_lstore_3 (Instruction *);
 
 		/**
 		 * Store float into local variable index 1
 		 */
-		void exec_fstore_0 (InstructionInfo *);
+		void exec_fstore_0 (Instruction *);
 
 		/**
 		 * Store float into local variable index 2
 		 */
-		void exec_fstore_1 (InstructionInfo *);
+		void exec_fstore_1 (Instruction *);
 
 		/**
 		 * Store float into local variable index 3
 		 */
-		void exec_fstore_2 (InstructionInfo *);
+		void exec_fstore_2 (Instruction *);
 
 		/**
 		 * Store float into local variable index 4
 		 */
-		void exec_fstore_3 (InstructionInfo *);
+		void exec_fstore_3 (Instruction *);
 
 		/**
 		 * Store double into local variable index 1
 		 */
-		void exec_dstore_0 (InstructionInfo *);
+		void exec_dstore_0 (Instruction *);
 
 		/**
 		 * Store double into local variable index 2
 		 */
-		void exec_dstore_1 (InstructionInfo *);
+		void exec_dstore_1 (Instruction *);
 
 		/**
 		 * Store double into local variable index 3
 		 */
-		void exec_dstore_2 (InstructionInfo *);
+		void exec_dstore_2 (Instruction *);
 
 		/**
 		 * Store double into local variable index 4
 		 */
-		void exec_dstore_3 (InstructionInfo *);
+		void exec_dstore_3 (Instruction *);
 
 		/**
 		 * Store reference into local variable index 1
 		 */
-		void exec_astore_0 (InstructionInfo *);
+		void exec_astore_0 (Instruction *);
 
 		/**
 		 * Store reference into local variable index 2
 		 */
-		void exec_astore_1 (InstructionInfo *);
+		void exec_astore_1 (Instruction *);
 
 		/**
 		 * Store reference into local variable index 3
 		 */
-		void exec_astore_2 (InstructionInfo *);
+		void exec_astore_2 (Instruction *);
 
 		/**
 		 * Store reference into local variable index 4
 		 */
-		void exec_astore_3 (InstructionInfo *);
+		void exec_astore_3 (Instruction *);
 
 		/**
 		 * Store into int array opstack -> arrayref,index,value
 		 */
-		void exec_iastore (InstructionInfo *);
+		void exec_iastore (Instruction *);
 
 		/**
 		 * Store into long array ,The arrayref must be of type reference and must refer to an array whose components are of type long. The index must be of type int
 		 */
-		void exec_lastore (InstructionInfo *);
+		void exec_lastore (Instruction *);
 
 		/**
 		 * Store into float array arrayref, index, value →
 		 */
-		void exec_fastore (InstructionInfo *);
+		void exec_fastore (Instruction *);
 
 		/**
 		 * Store into double array  arrayref, index, value →
 		 */
-		void exec_dastore (InstructionInfo *);
+		void exec_dastore (Instruction *);
 
 		/**
 		 * Store into reference array  arrayref, index, value →
 		 */
-		void exec_aastore (InstructionInfo *);
+		void exec_aastore (Instruction *);
 
 		/**
 		 * Store into byte or boolean array , arrayref, index, value →
 		 */
-		void exec_bastore (InstructionInfo *);
+		void exec_bastore (Instruction *);
 
 		/**
 		 * Store into char array ,The arrayref must be of type reference and must refer to an array whose components are of type char. The index and the value must both be of type int
 		 */
-		void exec_castore (InstructionInfo *);
+		void exec_castore (Instruction *);
 
 		/**
 		 * Store into short array
 		 */
-		void exec_sastore (InstructionInfo *);
+		void exec_sastore (Instruction *);
 
 		/**
 		 * Pop the top operand stack value
 		 */
-		void exec_pop (InstructionInfo *);
+		void exec_pop (Instruction *);
 
 		/**
 		 * Pop the top one or two operand stack values
 		 */
-		void exec_pop2 (InstructionInfo *);
+		void exec_pop2 (Instruction *);
 
 		/**
 		 * Duplicate the top operand stack value
 		 */
-		void exec_dup (InstructionInfo *);
+		void exec_dup (Instruction *);
 
 		/**
 		 * Duplicate the top operand stack value and insert two values down ,..., value2, value1 → ..., value1, value2, value1
 		 */
-		void exec_dup_x1 (InstructionInfo *);
+		void exec_dup_x1 (Instruction *);
 
 		/**
 		 * Duplicate the top operand stack value and insert two or three values down ..., value3, value2, value1 → ..., value1, value3, value2, value1
 		 */
-		void exec_dup_x2 (InstructionInfo *);
+		void exec_dup_x2 (Instruction *);
 
 		/**
 		 * Duplicate the top one or two operand stack values
 		 */
-		void exec_dup2 (InstructionInfo *);
+		void exec_dup2 (Instruction *);
 
 		/**
 		 * Duplicate the top one or two operand stack values and insert two or three values down
 		 */
-		void exec_dup2_x1 (InstructionInfo *);
+		void exec_dup2_x1 (Instruction *);
 
 		/**
 		 * Duplicate the top one or two operand stack values and insert two, three, or four values down
 		 */
-		void exec_dup2_x2 (InstructionInfo *);
+		void exec_dup2_x2 (Instruction *);
 
 		/**
 		 * Swap the top two operand stack values
 		 */
-		void exec_swap (InstructionInfo *);
+		void exec_swap (Instruction *);
 
 		/**
 		 * Swap the top two operand stack values
 		 */
-		void exec_iadd (InstructionInfo *);
+		void exec_iadd (Instruction *);
 
 		/**
 		 * Add long
 		 */
-		void exec_ladd (InstructionInfo *);
+		void exec_ladd (Instruction *);
 
 		/**
 		 * Add float
 		 */
-		void exec_fadd (InstructionInfo *);
+		void exec_fadd (Instruction *);
 
 		/**
 		 * Add double
 		 */
-		void exec_dadd (InstructionInfo *);
+		void exec_dadd (Instruction *);
 
 		/**
 		 * Subtract int
 		 */
-		void exec_isub (InstructionInfo *);
+		void exec_isub (Instruction *);
 
 		/**
 		 * Subtract long
 		 */
-		void exec_lsub (InstructionInfo *);
+		void exec_lsub (Instruction *);
 
 		/**
 		 * Subtract float
 		 */
-		void exec_fsub (InstructionInfo *);
+		void exec_fsub (Instruction *);
 
 		/**
 		 * Subtract double
 		 */
-		void exec_dsub (InstructionInfo *);
+		void exec_dsub (Instruction *);
 
 		/**
 		 * Multiply int
 		 */
-		void exec_imul (InstructionInfo *);
+		void exec_imul (Instruction *);
 
 		/**
 		 * Multiply long
 		 */
-		void exec_lmul (InstructionInfo *);
+		void exec_lmul (Instruction *);
 
 		/**
 		 * Multiply float
 		 */
-		void exec_fmul (InstructionInfo *);
+		void exec_fmul (Instruction *);
 
 		/**
 		 * Multiply double
 		 */
-		void exec_dmul (InstructionInfo *);
+		void exec_dmul (Instruction *);
 
 		/**
 		 * Divide int
 		 */
-		void exec_idiv (InstructionInfo *);
+		void exec_idiv (Instruction *);
 
 		/**
 		 * Divide long
 		 */
-		void exec_ldiv (InstructionInfo *);
+		void exec_ldiv (Instruction *);
 
 		/**
 		 * Divide float
 		 */
-		void exec_fdiv (InstructionInfo *);
+		void exec_fdiv (Instruction *);
 
 		/**
 		 * Divide double
 		 */
-		void exec_ddiv (InstructionInfo *);
+		void exec_ddiv (Instruction *);
 
 		/**
 		 * Remainder int
 		 */
-		void exec_irem (InstructionInfo *);
+		void exec_irem (Instruction *);
 
 		/**
 		 * Remainder long
 		 */
-		void exec_lrem (InstructionInfo *);
+		void exec_lrem (Instruction *);
 
 		/**
 		 * Remainder float
 		 */
-		void exec_frem (InstructionInfo *);
+		void exec_frem (Instruction *);
 
 		/**
 		 * Remainder double
 		 */
-		void exec_drem (InstructionInfo *);
+		void exec_drem (Instruction *);
 
 		/**
 		 * Negate int
 		 */
-		void exec_ineg (InstructionInfo *);
+		void exec_ineg (Instruction *);
 
 		/**
 		 * Negate long
 		 */
-		void exec_lneg (InstructionInfo *);
+		void exec_lneg (Instruction *);
 
 		/**
 		 * Negate float
 		 */
-		void exec_fneg (InstructionInfo *);
+		void exec_fneg (Instruction *);
 
 		/**
 		 * Negate double
 		 */
-		void exec_dneg (InstructionInfo *);
+		void exec_dneg (Instruction *);
 
 		/**
 		 * Shift left int  ,shift value1 by low 5 bits of value2
 		 */
-		void exec_ishl (InstructionInfo *);
+		void exec_ishl (Instruction *);
 
 		/**
 		 * Shift left long ,shift value1 by low 5 bits of value2
 		 */
-		void exec_lshl (InstructionInfo *);
+		void exec_lshl (Instruction *);
 
 		/**
 		 * Arithmetic shift right int,shift value1 by low 5 bits of value2
 		 */
-		void exec_ishr (InstructionInfo *);
+		void exec_ishr (Instruction *);
 
 		/**
 		 * Arithmetic shift right long, shift value1 by low 5 bits of value2
 		 */
-		void exec_lshr (InstructionInfo *);
+		void exec_lshr (Instruction *);
 
 		/**
 		 * Logical shift right int, shift value1 by low 5 bits of value2
 		 */
-		void exec_iushr (InstructionInfo *);
+		void exec_iushr (Instruction *);
 
 		/**
 		 * Logical shift right long, shift value1 by low 6 bits of value2
 		 */
-		void exec_lushr (InstructionInfo *);
+		void exec_lushr (Instruction *);
 
 		/**
 		 * Boolean AND int
 		 */
-		void exec_iand (InstructionInfo *);
+		void exec_iand (Instruction *);
 
 		/**
 		 * Boolean AND long
 		 */
-		void exec_land (InstructionInfo *);
+		void exec_land (Instruction *);
 
 		/**
 		 *  Boolean OR int ,  ..., value1, value2 → ..., result
 		 */
-		void exec_ior (InstructionInfo *);
+		void exec_ior (Instruction *);
 
 		/**
 		 * Boolean OR long
 		 */
-		void exec_lor (InstructionInfo *);
+		void exec_lor (Instruction *);
 
 		/**
 		 * Boolean XOR int
 		 */
-		void exec_ixor (InstructionInfo *);
+		void exec_ixor (Instruction *);
 
 		/**
 		 * Boolean XOR long
 		 */
-		void exec_lxor (InstructionInfo *);
+		void exec_lxor (Instruction *);
 
 		/**
 		 * Increment local variable by constant
 		 */
-		void exec_iinc (InstructionInfo *);
+		void exec_iinc (Instruction *);
 
 		/**
 		 * Convert int to long
 		 */
-		void exec_i2l (InstructionInfo *);
+		void exec_i2l (Instruction *);
 
 		/**
 		 * Convert int to float
 		 */
-		void exec_i2f (InstructionInfo *);
+		void exec_i2f (Instruction *);
 
 		/**
 		 * Convert int to double
 		 */
-		void exec_i2d (InstructionInfo *);
+		void exec_i2d (Instruction *);
 
 		/**
 		 * Convert long to int
 		 */
-		void exec_l2i (InstructionInfo *);
+		void exec_l2i (Instruction *);
 
 		/**
 		 * Convert long to float
 		 */
-		void exec_l2f (InstructionInfo *);
+		void exec_l2f (Instruction *);
 
 		/**
 		 * Convert long to double
 		 */
-		void exec_l2d (InstructionInfo *);
+		void exec_l2d (Instruction *);
 
 		/**
 		 * Convert float to int
 		 */
-		void exec_f2i (InstructionInfo *);
+		void exec_f2i (Instruction *);
 
 		/**
 		 * Convert float to long
 		 */
-		void exec_f2l (InstructionInfo *);
+		void exec_f2l (Instruction *);
 
 		/**
 		 * Convert float to double
 		 */
-		void exec_f2d (InstructionInfo *);
+		void exec_f2d (Instruction *);
 
 		/**
 		 * Convert double to int
 		 */
-		void exec_d2i (InstructionInfo *);
+		void exec_d2i (Instruction *);
 
 		/**
 		 * Convert double to long
 		 */
-		void exec_d2l (InstructionInfo *);
+		void exec_d2l (Instruction *);
 
 		/**
 		 * Convert double to float
 		 */
-		void exec_d2f (InstructionInfo *);
+		void exec_d2f (Instruction *);
 
 		/**
 		 * Convert int to byte
 		 */
-		void exec_i2b (InstructionInfo *);
+		void exec_i2b (Instruction *);
 
 		/**
 		 * Convert int to char
 		 */
-		void exec_i2c (InstructionInfo *);
+		void exec_i2c (Instruction *);
 
 		/**
 		 * Convert int to short
 		 */
-		void exec_i2s (InstructionInfo *);
+		void exec_i2s (Instruction *);
 
 		/**
 		 * Compare long , if value1 > value2 push 1 , if value2 > value1 push -1 if value1 == value2 push 0
 		 */
-		void exec_lcmp (InstructionInfo *);
+		void exec_lcmp (Instruction *);
 
 		/**
 		 * Compare float, if value1 > value2 push 1 , if value2 > value1 push -1 if value1 == value2 push 0
 		 */
-		void exec_fcmpl (InstructionInfo *);
+		void exec_fcmpl (Instruction *);
 
 		/**
 		 * Compare float, if value1 > value2 push 1 , if value2 > value1 push -1 if value1 == value2 push 0
 		 */
-		void exec_fcmpg (InstructionInfo *);
+		void exec_fcmpg (Instruction *);
 
 		/**
 		 * Compare double , if value1 > value2 push 1 , if value2 > value1 push -1 if value1 == value2 push 0
 		 */
-		void exec_dcmpl (InstructionInfo *);
+		void exec_dcmpl (Instruction *);
 
 		/**
 		 * Compare double ,if value1 > value2 push 1 , if value2 > value1 push -1 if value1 == value2 push 0
 		 */
-		void exec_dcmpg (InstructionInfo *);
+		void exec_dcmpg (Instruction *);
 
 		/**
 		 * Branch if int comparison with zero succeeds , == 0
 		 */
-		void exec_ifeq (InstructionInfo *);
+		void exec_ifeq (Instruction *);
 
 		/**
 		 * Branch if int comparison with zero succeeds , != 0
 		 */
-		void exec_ifne (InstructionInfo *);
+		void exec_ifne (Instruction *);
 
 		/**
 		 * Branch if int comparison with zero succeeds , < 0
 		 */
-		void exec_iflt (InstructionInfo *);
+		void exec_iflt (Instruction *);
 
 		/**
 		 * Branch if int comparison with zero succeeds , >= 0
 		 */
-		void exec_ifge (InstructionInfo *);
+		void exec_ifge (Instruction *);
 
 		/**
 		 * Branch if int comparison with zero succeeds , >0
 		 */
-		void exec_ifgt (InstructionInfo *);
+		void exec_ifgt (Instruction *);
 
 		/**
 		 * Branch if int comparison with zero succeeds , >= 0
 		 */
-		void exec_ifle (InstructionInfo *);
+		void exec_ifle (Instruction *);
 
 		/**
 		 *  Branch if int comparison succeeds, value1 = value2
 		 */
-		void exec_if_icmpeq (InstructionInfo *);
+		void exec_if_icmpeq (Instruction *);
 
 		/**
 		 * Branch if int comparison succeeds, value1 != value2
 		 */
-		void exec_if_icmpne (InstructionInfo *);
+		void exec_if_icmpne (Instruction *);
 
 		/**
 		 * Branch if int comparison succeeds, value1 < value2
 		 */
-		void exec_if_icmplt (InstructionInfo *);
+		void exec_if_icmplt (Instruction *);
 
 		/**
 		 * Branch if int comparison succeeds, value1 >= value2
 		 */
-		void exec_if_icmpge (InstructionInfo *);
+		void exec_if_icmpge (Instruction *);
 
 		/**
 		 * Branch if int comparison succeeds, value1 > value2
 		 */
-		void exec_if_icmpgt (InstructionInfo *);
+		void exec_if_icmpgt (Instruction *);
 
 		/**
 		 * Branch if int comparison succeeds,value1 <= value2
 		 */
-		void exec_if_icmple (InstructionInfo *);
+		void exec_if_icmple (Instruction *);
 
 		/**
 		 * Branch if reference comparison succeeds , value1 = value2, ref
 		 */
-		void exec_if_acmpeq (InstructionInfo *);
+		void exec_if_acmpeq (Instruction *);
 
 		/**
 		 * Branch if reference comparison succeeds  value1 != value2, ref
 		 */
-		void exec_if_acmpne (InstructionInfo *);
+		void exec_if_acmpne (Instruction *);
 
 		/**
 		 * Branch always
 		 */
-		void exec_goto (InstructionInfo *);
+		void exec_goto (Instruction *);
 
 		/**
 		 * Jump subroutine
 		 */
-		void exec_jsr (InstructionInfo *);
+		void exec_jsr (Instruction *);
 
 		/**
 		 * Return from subroutine
 		 */
-		void exec_ret (InstructionInfo *);
+		void exec_ret (Instruction *);
 
 		/**
 		 * Access jump table by index and jump
 		 */
-		void exec_tableswitch (InstructionInfo *);
+		void exec_tableswitch (Instruction *);
 
 		/**
 		 * Access jump table by key match and jump
 		 */
-		void exec_lookupswitch (InstructionInfo *);
+		void exec_lookupswitch (Instruction *);
 
 		/**
 		 * Return int from method
 		 */
-		void exec_ireturn (InstructionInfo *);
+		void exec_ireturn (Instruction *);
 
 		/**
 		 * Return long from method
 		 */
-		void exec_lreturn (InstructionInfo *);
+		void exec_lreturn (Instruction *);
 
 		/**
 		 * Return long from method
 		 */
-		void exec_freturn (InstructionInfo *);
+		void exec_freturn (Instruction *);
 
 		/**
 		 * Return double from method
 		 */
-		void exec_dreturn (InstructionInfo *);
+		void exec_dreturn (Instruction *);
 
 		/**
 		 * Return reference from method
 		 */
-		void exec_areturn (InstructionInfo *);
+		void exec_areturn (Instruction *);
 
 		/**
 		 * Return void from method
 		 */
-		void exec_return (InstructionInfo *);
+		void exec_return (Instruction *);
 
 		/**
 		 * Get static field from class
 		 */
-		void exec_getstatic (InstructionInfo *);
+		void exec_getstatic (Instruction *);
 
 		/**
 		 * Get static field from class
 		 */
-		void exec_putstatic (InstructionInfo *);
+		void exec_putstatic (Instruction *);
 
 		/**
 		 * Fetch field from object
 		 */
-		void exec_getfield (InstructionInfo *);
+		void exec_getfield (Instruction *);
 
 		/**
 		 * Set field in object
 		 */
-		void exec_putfield (InstructionInfo *);
+		void exec_putfield (Instruction *);
 
 		/**
 		 * Invoke instance method; dispatch based on class , constant pool
 		 */
-		void exec_invokevirtual (InstructionInfo *);
+		void exec_invokevirtual (Instruction *);
 
 		/**
 		 * Invoke instance method; special handling for superclass, private, and instance initialization method invocations
 		 */
-		void exec_invokespecial (InstructionInfo *);
+		void exec_invokespecial (Instruction *);
 
 		/**
 		 * Invoke a class (static) method
 		 */
-		void exec_invokestatic (InstructionInfo *);
+		void exec_invokestatic (Instruction *);
 
 		/**
 		 * Invoke interface method
 		 */
-		void exec_invokeinterface (InstructionInfo *);
+		void exec_invokeinterface (Instruction *);
 
 		/**
 		 * Invoke dynamic method , indexbyte1 + indexbyte2 , 0 , 0
 		 */
-		void exec_invokedynamic (InstructionInfo *);
+		void exec_invokedynamic (Instruction *);
 
 		/**
 		 * Create new object
 		 */
-		void exec_new (InstructionInfo *);
+		void exec_new (Instruction *);
 
 		/**
 		 * Create new array , 4 = boolean, 5 = char ,6 = float , 7 = double, 8 = byte, 9 = short ,10 = int , 11 = long
 		 */
-		void exec_newarray (InstructionInfo *);
+		void exec_newarray (Instruction *);
 
 		/**
 		 * Create new array of reference , constant pool
 		 */
-		void exec_anewarray (InstructionInfo *);
+		void exec_anewarray (Instruction *);
 
 		/**
 		 * Get length of array
 		 */
-		void exec_arraylength (InstructionInfo *);
+		void exec_arraylength (Instruction *);
 
 		/**
 		 * Throw exception or error
 		 */
-		void exec_athrow (InstructionInfo *);
+		void exec_athrow (Instruction *);
 
 		/**
 		 * Check whether object is of given type
 		 */
-		void exec_checkcast (InstructionInfo *);
+		void exec_checkcast (Instruction *);
 
 		/**
 		 * Determine if object is of given type
 		 */
-		void exec_instanceof (InstructionInfo *);
+		void exec_instanceof (Instruction *);
 
 		/**
 		 * Enter monitor for object
 		 */
-		void exec_monitorenter (InstructionInfo *);
+		void exec_monitorenter (Instruction *);
 
 		/**
 		 * Exit monitor for object
 		 */
-		void exec_monitorexit (InstructionInfo *);
+		void exec_monitorexit (Instruction *);
 
 		/**
 		 * Extend local variable index by additional bytes
 		 */
-		void exec_wide (InstructionInfo *);
+		void exec_wide (Instruction *);
 
 		/**
 		 * Create new multidimensional array
 		 */
-		void exec_multianewarray (InstructionInfo *);
+		void exec_multianewarray (Instruction *);
+
+		/**
+		 * multianewarray with the levels resolved, cache is its MultiArraySite
+		 */
+		void exec_multianewarray_quick (Instruction *);
 
 		/**
 		 * Branch if reference is null
 		 */
-		void exec_ifnull (InstructionInfo *);
+		void exec_ifnull (Instruction *);
 
 		/**
 		 * Branch if reference not null
 		 */
-		void exec_ifnonnull (InstructionInfo *);
+		void exec_ifnonnull (Instruction *);
 
 		/**
 		 * Branch always (wide index)
 		 */
-		void exec_goto_w (InstructionInfo *);
+		void exec_goto_w (Instruction *);
 
 		/**
 		 * Jump subroutine (wide index)
 		 */
-		void exec_jsr_w (InstructionInfo *);
+		void exec_jsr_w (Instruction *);
 
 		/**
 		 * mnemonic breakpoint and is intended to be used by debuggers to implement breakpoints.
 		 */
-		void exec_breakpoint (InstructionInfo *);
+		void exec_breakpoint (Instruction *);
 
 		/**
 		 * These instructions are intended to provide "back doors" or traps to implementation-specific functionality implemented in software and hardware, respectively
 		 */
-		void exec_impdep1 (InstructionInfo *);
+		void exec_impdep1 (Instruction *);
 
 		/**
 		 * These instructions are intended to provide "back doors" or traps to implementation-specific functionality implemented in software and hardware, respectively
 		 */
-		void exec_impdep2 (InstructionInfo *);
+		void exec_impdep2 (Instruction *);
+
+		/**
+		 * getstatic of a field whose class is initialized, the cache points to the value
+		 */
+		void exec_getstatic_quick (Instruction *);
+
+		/**
+		 * putstatic of a field whose class is initialized, the cache points to the value
+		 */
+		void exec_putstatic_quick (Instruction *);
+
+		/**
+		 * invokestatic of a method whose class is initialized, the cache is the call site
+		 */
+		void exec_invokestatic_quick (Instruction *);
+
+		/**
+		 * ldc or ldc_w of an int or a float, the value is the constant
+		 */
+		void exec_ldc_quick (Instruction *);
+
+		/**
+		 * ldc or ldc_w of a string, the value is the index of the literal in the string pool
+		 */
+		void exec_ldc_string_quick (Instruction *);
+
+		/**
+		 * ldc2_w, the cache points to the constant
+		 */
+		void exec_ldc2_w_quick (Instruction *);
+
+		/**
+		 * getfield of a resolved field, the value is its offset
+		 */
+		void exec_getfield_quick (Instruction *);
+
+		/**
+		 * putfield of a resolved field, the value is its offset
+		 */
+		void exec_putfield_quick (Instruction *);
+
+		/**
+		 * new of an initialized class, the value is the instance size
+		 */
+		void exec_new_quick (Instruction *);
+
+		/**
+		 * new of java/lang/StringBuilder, allocated by the strings
+		 */
+		void exec_new_builder_quick (Instruction *);
+
+		/**
+		 * invokevirtual or invokeinterface of a method in bytecode, the cache is the call site
+		 */
+		void exec_invokevirtual_quick (Instruction *);
+
+		/**
+		 * invokespecial of a method in bytecode, the cache is the call site
+		 */
+		void exec_invokespecial_quick (Instruction *);
+
+		/**
+		 * Any invoke of a native method, the cache is the call site
+		 */
+		void exec_invokenative_quick (Instruction *);
+
+		/**
+		 * Superinstruction: iload x; iload y
+		 */
+		void exec_iload_iload (Instruction *);
+
+		/**
+		 * Superinstruction: iload x; iload y; iadd; istore z
+		 */
+		void exec_iload_iload_iadd_istore (Instruction *);
+
+		/**
+		 * Superinstruction: aload a; iload i; iaload
+		 */
+		void exec_aload_iload_iaload (Instruction *);
+
+		/**
+		 * Superinstruction: aload a; iload i; iload x; iastore
+		 */
+		void exec_aload_iload_iload_iastore (Instruction *);
+
+		/**
+		 * Superinstruction: iload x; iload y; if_icmplt
+		 */
+		void exec_iload_iload_if_icmplt (Instruction *);
+
+		/**
+		 * Superinstruction: iload x; iload y; if_icmpge
+		 */
+		void exec_iload_iload_if_icmpge (Instruction *);
+
+		/**
+		 * Superinstruction: iload x; an int constant; if_icmplt
+		 */
+		void exec_iload_iconst_if_icmplt (Instruction *);
+
+		/**
+		 * Superinstruction: iload x; an int constant; if_icmpge
+		 */
+		void exec_iload_iconst_if_icmpge (Instruction *);
+
+		/**
+		 * Superinstruction: iinc; goto
+		 */
+		void exec_iinc_goto (Instruction *);
+
+		/**
+		 * Superinstruction: iinc; iload x; iload y; if_icmplt
+		 */
+		void exec_iinc_iload_iload_if_icmplt (Instruction *);
 	};
 
 }
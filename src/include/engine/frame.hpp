@@ -11,9 +11,13 @@ namespace jvm {
 	class Frame {
 	public:
 		/**
-		 * Constructor Default
+		 * Constructor
+		 * @param cl class of the method
+		 * @param mt method being executed
+		 * @param slots first slot of the frame in the FramesStack arena, locals come first and then the operands
+		 * @param tags type tags parallel to slots
 		 */
-		Frame(ClassLoader&, MethodInfo&);
+		Frame(ClassLoader&, MethodInfo&, op4 *, u1 *);
 
 		Operands operands;	///> Operands Stack
 
@@ -26,6 +30,8 @@ namespace jvm {
 		ClassLoader& cl;	///> Class loader reference
 
 		MethodInfo& mt;	///> Method info reference
+
+		Instruction *code;	///> Pre-decoded code of the method, indexed by PC
 	};
 
 }
@@ -4,12 +4,44 @@
 
 namespace jvm {
 
-	class FramesStack : public std::stack<Frame> {
+	/**
+	 * Stack of frames over one preallocated arena, each frame holds its locals and operands back to back
+	 */
+	class FramesStack : public std::stack<Frame, std::vector<Frame>> {
 	public:
+		static const u4 MAX_FRAMES = 4096;	///> Maximum depth of calls
+
+		static const u4 MAX_SLOTS = 1 << 20;	///> Size of the arena, in 4 byte slots
+
 		/**
 		* Constructor Default
 		*/
-		FramesStack() = default;
+		FramesStack();
+
+		/**
+		 * Pushes a frame for a method. The arguments already on the operand stack
+		 * of the current frame become the first local variables of the new frame
+		 * @param cl class of the method
+		 * @param mt method to be executed
+		 * @param nargs number of slots of arguments
+		 * @return the new frame
+		 */
+		Frame &push(ClassLoader &, MethodInfo &, u2 nargs = 0);
+
+		/**
+		 * @return the first frame, the bottom of the stack
+		 */
+		std::vector<Frame>::iterator begin() { return c.begin(); }
+
+		/**
+		 * @return the position after the top frame
+		 */
+		std::vector<Frame>::iterator end() { return c.end(); }
+
+	private:
+		std::vector<op4> slots;	///> Locals and operands of every frame
+
+		std::vector<u1> tags;	///> Type of each slot
 	};
 
 }
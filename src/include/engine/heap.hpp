@@ -0,0 +1,282 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+
+#include "base.hpp"
+
+namespace jvm {
+
+	/**
+	 * Header laid out right before the payload of every object and array of the heap
+	 */
+	struct HeapObject {
+		static const u2 FORWARDED = 1;	///> Flag of an object already copied by the collector, klass holds the new reference
+
+		u4 size;	///> Bytes taken by the object, header included, multiple of Heap::ALIGNMENT
+
+		u1 kind;	///> T_OBJ or T_ARRAY
+
+		u1 elementType;	///> Type of the elements of an array: T_BOOL ... T_LONG, or T_REF
+
+		u2 flags;	///> Flags of the garbage collector
+
+		u4 klass;	///> Symbol of the name of the class, or of the element class of a reference array
+
+		u4 length;	///> Number of elements of an array, 0 for objects
+	};
+
+	/**
+	 * Managed generational heap. One region is reserved up front: a nursery, where objects are bump-allocated,
+	 * and an old generation split in two semispaces. References are 32 bit offsets from the start of the region, 0 is null.
+	 * A young collection copies the live objects of the nursery to the old generation, its roots are the frames and the
+	 * cards of the old generation dirtied by the write barrier. A full collection, when the old generation is full, copies
+	 * every live object to the other old semispace (Cheney's algorithm). With no nursery every collection is full.
+	 */
+	class Heap {
+	public:
+		static const u4 ALIGNMENT = 8;	///> Alignment of every object, so long and double elements are aligned
+
+		static const u4 RESERVED = 1 << 16;	///> Offsets below are never references, so null and small integers are never taken for objects
+
+		static const u4 CARD_SHIFT = 9;	///> Cards of the write barrier have 512 bytes
+
+		static const u8 DEFAULT_CAPACITY = u8(1) << 30;	///> Bytes reserved by default
+
+		static const u8 DEFAULT_NURSERY = u8(4) << 20;	///> Bytes of the nursery by default
+
+		static const u8 MAX_CAPACITY = u8(1) << 32;	///> Bytes of the largest heap, as far as 32 bit references reach
+
+		static const u4 MAX_DIMENSIONS = 255;	///> Dimensions of the largest multidimensional array, as many as an array descriptor has
+
+		std::function<void()> collector;	///> Finds the roots and collects, called when the nursery or the old generation is full
+
+		/**
+		 * Default constructor, nothing is reserved until reserve()
+		 */
+		Heap() = default;
+
+		/**
+		 * Releases the region
+		 */
+		~Heap();
+
+		Heap(const Heap &) = delete;
+
+		Heap &operator=(const Heap &) = delete;
+
+		/**
+		 * Reserves the region
+		 * @param capacity bytes reserved, at most 4GB since references are 32 bit
+		 * @param nursery bytes of the nursery, taken from the capacity, 0 for a single generation
+		 */
+		void reserve(u8 capacity, u8 nursery = DEFAULT_NURSERY);
+
+		/**
+		 * Allocates a zeroed object
+		 * @param bytes size of the payload
+		 * @param klass symbol of the name of the class
+		 * @return reference to the object
+		 */
+		u4 newObject(u4 bytes, u4 klass);
+
+		/**
+		 * Allocates a zeroed array
+		 * @param elementType T_BOOL ... T_LONG, or T_REF
+		 * @param length number of elements
+		 * @param klass symbol of the element class of a reference array, 0 otherwise
+		 * @return reference to the array
+		 */
+		u4 newArray(u1 elementType, i4 length, u4 klass = 0);
+
+		/**
+		 * Allocates a multidimensional array and its subarrays in a single zeroed block, laid out level by level
+		 * as the collector copies them, so the rows of each level are contiguous in row-major order
+		 * @param elementTypes element type of the arrays of each level, T_REF but for the last one of a primitive array
+		 * @param klasses symbol of the element class of the arrays of each level, 0 for primitive elements
+		 * @param lengths length of the arrays of each level
+		 * @param dimensions number of levels allocated, at most MAX_DIMENSIONS
+		 * @return reference to the outermost array
+		 */
+		u4 newMultiArray(const u1 *elementTypes, const u4 *klasses, const i4 *lengths, u4 dimensions);
+
+		/**
+		 * @return the header of an object
+		 */
+		HeapObject *get(u4 ref) const {
+			return reinterpret_cast<HeapObject *>(base + ref);
+		}
+
+		/**
+		 * @return the payload of an object or the first element of an array
+		 */
+		template <typename T>
+		T *data(u4 ref) const {
+			return reinterpret_cast<T *>(base + ref + sizeof(HeapObject));
+		}
+
+		/**
+		 * Write barrier, to be called after a reference is stored in an object or array
+		 * @param slot where the reference was stored
+		 */
+		void markCard(const void *slot) {
+			cards[static_cast<size_t>(static_cast<const u1 *>(slot) - base) >> CARD_SHIFT] = 1;
+		}
+
+		/**
+		 * Write barrier of bulk stores, to be called after references are stored in a range of an array
+		 * @param begin first slot stored
+		 * @param end slot after the last one stored
+		 */
+		void markCards(const void *begin, const void *end) {
+			if (begin != end) {
+				auto first = cards.begin() + ((static_cast<const u1 *>(begin) - base) >> CARD_SHIFT);
+				auto last = cards.begin() + ((static_cast<const u1 *>(end) - 1 - base) >> CARD_SHIFT);
+				std::fill(first, last + 1, 1);
+			}
+		}
+
+		/**
+		 * Tells the collector where the references are in the objects of a class
+		 * @param klass symbol of the name of the class
+		 * @param offsets offsets of the reference fields from the start of the payload
+		 */
+		void setReferences(u4 klass, const std::vector<u4> &offsets) {
+			references[klass] = offsets;
+		}
+
+		/**
+		 * @return the bytes taken by each element of an array of a type
+		 */
+		static u1 elementSize(u1 elementType);
+
+		/**
+		 * @return the element type of an array from the first character of the descriptor of the elements
+		 */
+		static u1 elementType(char descriptor);
+
+		/**
+		 * Starts a collection, young unless the old generation may not hold the survivors of the nursery
+		 */
+		void beginCollection();
+
+		/**
+		 * Copies an object reachable from a root, once
+		 * @param ref reference found in a root, values outside the space being collected are kept
+		 * @return the new reference to the object
+		 */
+		u4 forward(u4 ref);
+
+		/**
+		 * Copies the objects reachable from the ones already copied and empties the nursery
+		 */
+		void endCollection();
+
+		/**
+		 * @return bytes taken by the objects in the nursery and in the old generation
+		 */
+		u8 used() const {
+			return (youngTop - youngStart) + (top - start);
+		}
+
+		/**
+		 * @return number of objects allocated so far
+		 */
+		u8 allocations() const {
+			return count;
+		}
+
+		/**
+		 * Prints the allocation and collection statistics
+		 * @param os used to output data
+		 */
+		void printStats(std::ostream &) const;
+
+	private:
+		/**
+		 * Allocates a zeroed block, in the nursery when it fits there
+		 * @param bytes size of the object, header included
+		 * @return reference to the object
+		 */
+		u4 allocate(u8 bytes);
+
+		/**
+		 * Bumps the top of the old generation, recording where the object starts for the cards it covers
+		 * @param bytes size of the object, multiple of ALIGNMENT
+		 * @return reference to the object
+		 */
+		u4 bumpOld(u8 bytes);
+
+		/**
+		 * Records the objects starting in the cards covered by a block of the old generation
+		 * @param ref first object of the block
+		 * @param end end of the block
+		 */
+		void recordObjects(u8 ref, u8 end);
+
+		/**
+		 * Forwards the references of an object that lie between two offsets
+		 * @param ref the object
+		 * @param from first offset scanned
+		 * @param to end of the offsets scanned
+		 */
+		void scan(u4 ref, u8 from, u8 to);
+
+		/**
+		 * Forwards the references stored in the dirty cards of the old generation below an offset
+		 * @param end top of the old generation before the collection
+		 */
+		void scanCards(u8 end);
+
+		u1 *base = nullptr;	///> Start of the region
+
+		u8 capacity = 0;	///> Bytes reserved
+
+		u8 youngStart = 0;	///> Start of the nursery
+
+		u8 youngTop = 0;	///> Offset of the next object of the nursery
+
+		u8 youngLimit = 0;	///> End of the nursery
+
+		u8 semispace = 0;	///> Bytes of each old semispace
+
+		u8 start = 0;	///> Offset of the old semispace in use
+
+		u8 top = 0;	///> Offset of the next object of the old generation
+
+		u8 limit = 0;	///> End of the old semispace in use
+
+		bool full = false;	///> Whether the collection running is a full one
+
+		u8 fromStart = 0;	///> Old semispace being collected, empty in a young collection
+
+		u8 fromTop = 0;	///> End of the objects of the old semispace being collected
+
+		u8 collectedYoung = 0;	///> End of the objects of the nursery being collected
+
+		u8 survivors = 0;	///> Offset where the objects copied by the running collection start
+
+		std::vector<u1> cards;	///> Dirty flag of each card of the region
+
+		std::vector<u4> firstObject;	///> Object covering the start of each card of the old generation
+
+		std::unordered_map<u4, std::vector<u4>> references;	///> Offsets of the reference fields of the objects of each class
+
+		u8 count = 0;	///> Objects allocated
+
+		u8 allocated = 0;	///> Bytes allocated
+
+		u8 promoted = 0;	///> Bytes copied from the nursery to the old generation
+
+		u8 reclaimed = 0;	///> Bytes released by the collections
+
+		u8 collections[2] = {0, 0};	///> Young and full collections done
+
+		double pauseTotal[2] = {0, 0};	///> Seconds spent in young and in full collections
+
+		double pauseMax = 0;	///> Longest collection, in seconds
+
+		std::chrono::steady_clock::time_point pauseStart;	///> Start of the current collection
+	};
+
+}
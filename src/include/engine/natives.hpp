@@ -0,0 +1,193 @@
+#pragma once
+
+#include <functional>
+#include <map>
+#include <tuple>
+
+#include "heap.hpp"
+#include "strings.hpp"
+#include "operands.hpp"
+#include "print_stream.hpp"
+
+namespace jvm {
+
+	/**
+	 * Typed view of the arguments of a native method, in place on the operand stack of the caller.
+	 * Slots are numbered from the first argument, the receiver of an instance method; long and double take two
+	 */
+	class NativeArgs {
+	public:
+		/**
+		 * Constructor
+		 * @param operands operand stack of the caller, the arguments on top
+		 * @param size slots of arguments
+		 */
+		NativeArgs(Operands &operands, u2 size) : operands(operands), slots(operands.end() - size), size(size) {
+		}
+
+		i4 getInt(u2 slot) const {
+			return slots[slot].i4;
+		}
+
+		u2 getChar(u2 slot) const {
+			return slots[slot].ui2;
+		}
+
+		float getFloat(u2 slot) const {
+			return slots[slot].f;
+		}
+
+		i8 getLong(u2 slot) const {
+			return Converter::to_op8(slots[slot], slots[slot + 1]).ll;
+		}
+
+		double getDouble(u2 slot) const {
+			return Converter::to_op8(slots[slot], slots[slot + 1]).lf;
+		}
+
+		/**
+		 * @return the slot of a reference, a root updated when the native allocates and the collector moves the object
+		 */
+		u4 &getRef(u2 slot) const {
+			return slots[slot].ui4;
+		}
+
+		/**
+		 * @return the slot of a reference, throwing the NullPointerException when it is null
+		 */
+		u4 &getNonNull(u2 slot) const;
+
+		/**
+		 * @return the slots of the arguments, for the values read as they are
+		 */
+		const op4 *getSlots() const {
+			return slots;
+		}
+
+		/**
+		 * Pops the arguments of a method that returns nothing
+		 */
+		void returnVoid() {
+			operands.drop(size);
+		}
+
+		/**
+		 * Replaces the arguments with the result, for int, short, char, byte and boolean
+		 */
+		void returnInt(i4 value) {
+			operands.drop(size);
+			operands.push4(T_INT, static_cast<u4>(value));
+		}
+
+		void returnLong(i8 value) {
+			operands.drop(size);
+			operands.push8(T_LONG, static_cast<u8>(value));
+		}
+
+		void returnFloat(float value) {
+			op4 result;
+			result.f = value;
+			operands.drop(size);
+			operands.push4(T_FLOAT, result);
+		}
+
+		void returnDouble(double value) {
+			op8 result;
+			result.lf = value;
+			operands.drop(size);
+			operands.push8(T_DOUBLE, result);
+		}
+
+		void returnRef(u4 value) {
+			operands.drop(size);
+			operands.push4(T_REF, value);
+		}
+
+	private:
+		Operands &operands;	///> Operand stack of the caller
+
+		op4 *slots;	///> First slot of the arguments
+
+		u2 size;	///> Slots of arguments
+	};
+
+	class Natives;
+
+	/**
+	 * Method of a library class implemented by the engine. It replaces its arguments with its result
+	 */
+	typedef void (*NativeMethod)(Natives &, NativeArgs &);
+
+	/**
+	 * Registry of the native methods and static fields of the library classes, keyed by the symbols of the
+	 * class, name and descriptor. Invokes find their native when the call site is linked and call it directly after.
+	 * The natives reach the heap, the strings and System.out through it
+	 */
+	class Natives {
+	public:
+		Heap &heap;	///> Objects and arrays
+
+		Strings &strings;	///> String objects
+
+		PrintStream &out;	///> System.out
+
+		u4 systemOut = 0;	///> The java/io/PrintStream object of System.out, the receiver of the print natives
+
+		std::function<bool(u4, u4)> assignable;	///> Whether objects of a class may be stored where a type is expected, set by the engine
+
+		/**
+		 * Constructor, registers the natives of the engine
+		 */
+		Natives(Heap &, Strings &, PrintStream &);
+
+		/**
+		 * Registers a native method, replacing the one of the same method
+		 * @param klass name of the class
+		 * @param name name of the method
+		 * @param descriptor descriptor of the method
+		 * @param method the native
+		 */
+		void add(const std::string &klass, const std::string &name, const std::string &descriptor, NativeMethod method);
+
+		/**
+		 * Registers a static field of a library class, whose value never changes
+		 * @param klass name of the class
+		 * @param name name of the field
+		 * @param value its value, a reference or a value of at most 8 bytes
+		 */
+		void addField(const std::string &klass, const std::string &name, u8 value);
+
+		/**
+		 * @return the native of a method, nullptr when there is none
+		 */
+		NativeMethod find(u4 klass, u4 name, u4 descriptor) const;
+
+		/**
+		 * @return where the value of a static field is, nullptr when it was not registered
+		 */
+		u8 *findField(u4 klass, u4 name);
+
+		/**
+		 * Allocates the objects of the static fields, as System.out, once the heap is reserved
+		 */
+		void createObjects();
+
+		/**
+		 * Updates the references of the static fields after the collector moved their objects
+		 */
+		void forwardRoots();
+
+		/**
+		 * Native that does nothing, as java/lang/Object.<init>
+		 */
+		static void ignore(Natives &, NativeArgs &args);
+
+	private:
+		std::map<std::tuple<u4, u4, u4>, NativeMethod> methods;	///> Natives by the symbols of class, name and descriptor
+
+		std::map<std::pair<u4, u4>, u8> fields;	///> Values of the static fields by the symbols of class and name
+
+		u8 *outField;	///> Value of System.out among the fields
+	};
+
+}
@@ -5,8 +5,14 @@
 
 namespace jvm {
 
-	class Operands : public std::stack<Data> {
+	/**
+	 * Operand stack of a frame, a view over a region of the FramesStack arena
+	 */
+	class Operands {
 	private:
+		op4 *values = nullptr;	///< Slots of the operand stack
+		u1 *types = nullptr;	///< Type tag of each slot
+		u2 depth = 0;	///< Number of slots in use
 		u2 maxSize = 0;	///< Maximum size of the operands stack
 	public:
 
@@ -16,10 +22,49 @@ namespace jvm {
 		Operands() = default;
 
 		/**
-		 * Sets the maximum size of the operands stack
-		 * @param size 
+		 * Binds the operand stack to its storage
+		 * @param values first slot of the operand stack
+		 * @param types first type tag of the operand stack
+		 * @param size maximum size of the operand stack
 		 */
-		void setSize(u2 size);
+		void bind(op4 *, u1 *, u2);
+
+		/**
+		 * @return true if there is no operand on the stack
+		 */
+		bool empty() const { return depth == 0; }
+
+		/**
+		 * @return number of slots in use
+		 */
+		u2 size() const { return depth; }
+
+		/**
+		 * @return first slot of the stack, the bottom one
+		 */
+		op4 *begin() const { return values; }
+
+		/**
+		 * @return first slot above the top of the stack, where a callee frame may start
+		 */
+		op4 *end() const { return values + depth; }
+
+		/**
+		 * @return type tag of the first slot of the stack
+		 */
+		u1 *tags() const { return types; }
+
+		/**
+		 * Sets the number of slots in use, their values already written to the slots
+		 * @param count number of slots in use
+		 */
+		void resize(u2);
+
+		/**
+		 * Discards slots from the top of the stack, without reading them
+		 * @param count number of slots discarded
+		 */
+		void drop(u2);
 
 		/**
 		 * Pops 4 bytes from the operand stack and returns it
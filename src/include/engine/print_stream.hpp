@@ -0,0 +1,114 @@
+#pragma once
+
+#include <ostream>
+#include <vector>
+
+#include "base.hpp"
+
+namespace jvm {
+
+	/**
+	 * Native java/io/PrintStream of System.out. The text is encoded in UTF-8 into a buffer, which is only written
+	 * to the stream when it is full, on flush() and when the stream is destroyed, at exit
+	 */
+	class PrintStream {
+	public:
+		static const size_t BUFFER_SIZE = size_t(1) << 16;	///> Bytes buffered before they are written
+
+		/**
+		 * Constructor
+		 * @param os where the text is written
+		 */
+		explicit PrintStream(std::ostream &);
+
+		/**
+		 * Writes what is left in the buffer
+		 */
+		~PrintStream();
+
+		PrintStream(const PrintStream &) = delete;
+
+		PrintStream &operator=(const PrintStream &) = delete;
+
+		/**
+		 * Writes a byte
+		 */
+		void put(char c) {
+			if (used == buffer.size()) {
+				drain();
+			}
+			buffer[used++] = c;
+		}
+
+		/**
+		 * Writes bytes
+		 * @param text the bytes
+		 * @param length number of bytes
+		 */
+		void write(const char *text, size_t length);
+
+		/**
+		 * Writes Latin-1 characters
+		 * @param chars the characters
+		 * @param length number of characters
+		 */
+		void printLatin1(const u1 *chars, u4 length);
+
+		/**
+		 * Writes UTF-16 code units, a surrogate pair as one code point and a lone surrogate as '?'
+		 * @param units the code units
+		 * @param length number of code units
+		 */
+		void printUtf16(const u2 *units, u4 length);
+
+		/**
+		 * Writes an int or a long
+		 */
+		void printLong(i8);
+
+		/**
+		 * Writes a float as Float.toString
+		 */
+		void printFloat(float);
+
+		/**
+		 * Writes a double as Double.toString
+		 */
+		void printDouble(double);
+
+		/**
+		 * Writes true or false
+		 */
+		void printBoolean(bool);
+
+		/**
+		 * Ends the line
+		 */
+		void newLine() {
+			put('\n');
+		}
+
+		/**
+		 * Writes the buffer and flushes the stream
+		 */
+		void flush();
+
+	private:
+		/**
+		 * Writes the buffer to the stream, without flushing it
+		 */
+		void drain();
+
+		/**
+		 * Writes a code point encoded in UTF-8
+		 */
+		void putCodePoint(u4);
+
+		std::ostream &os;	///> Where the text is written
+
+		std::vector<char> buffer;	///> Text not written yet
+
+		size_t used = 0;	///> Bytes of the buffer in use
+	};
+
+}
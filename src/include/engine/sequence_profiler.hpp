@@ -0,0 +1,47 @@
+#pragma once
+
+#include <unordered_map>
+
+#include "class_loader/code_info.hpp"
+
+namespace jvm {
+
+	/**
+	 * Mines the candidate superinstructions of a run: counts the sequences of bytecodes executed one right
+	 * after the other in the same method, with no branch taken, call or return in between.
+	 * The opcodes are folded into their families, so iload_1; iload_2 and iload 5; iload_0 count as the same sequence
+	 */
+	class SequenceProfiler {
+	public:
+		static const u1 MAX_LENGTH = 4;	///> Instructions of the longest sequence counted
+
+		/**
+		 * Counts the sequences that end at an instruction, to be called right before it runs
+		 * @param instruction the instruction about to run
+		 */
+		void record(Instruction *instruction);
+
+		/**
+		 * Prints the sequences that would save the most dispatches as a superinstruction, and the superinstruction
+		 * that already runs each of them
+		 * @param os used to output data
+		 * @param top number of sequences printed
+		 */
+		void printStats(std::ostream &, u4 top) const;
+
+	private:
+		/**
+		 * @return whether an instruction may transfer control, so no sequence goes on after it
+		 */
+		static bool endsSequence(u1 opcode);
+
+		u1 window[MAX_LENGTH];	///> Families of the last instructions run in a row, the oldest first
+
+		u1 length = 0;	///> Instructions in the window
+
+		Instruction *expected = nullptr;	///> Instruction that runs next if the last one falls through
+
+		std::unordered_map<u8, u8> counts;	///> Times each sequence ran, by its length and its families packed in a key
+	};
+
+}
@@ -0,0 +1,315 @@
+#pragma once
+
+#include "heap.hpp"
+#include "print_stream.hpp"
+#include "class_loader/runtime_constant_pool.hpp"
+
+namespace jvm {
+
+	/**
+	 * Payload of a java/lang/String in the heap. The characters follow it in the same object:
+	 * one byte each when every character is Latin-1, UTF-16 code units otherwise
+	 */
+	struct StringObject {
+		static const u1 LATIN1 = 0;	///> One byte per character
+		static const u1 UTF16 = 1;	///> Two bytes per character
+
+		u4 length;	///> Number of characters
+
+		i4 hash;	///> Cached hashCode, 0 until it is computed
+
+		u1 coder;	///> LATIN1 or UTF16
+
+		u1 hashIsZero;	///> Whether the hashCode was computed and is 0, so it is not computed again
+
+		u2 padding;	///> Keeps the characters aligned
+	};
+
+	/**
+	 * Payload of a java/lang/StringBuilder in the heap
+	 */
+	struct StringBuilderObject {
+		u4 value;	///> byte[] with the characters in the coder, 0 until the first append. Its length is the capacity in bytes
+
+		u4 count;	///> Number of characters
+
+		u1 coder;	///> StringObject::LATIN1 until a character out of Latin-1 is appended
+
+		u1 padding[3];	///> Keeps the payload aligned
+	};
+
+	/**
+	 * Creates the java/lang/String and java/lang/StringBuilder objects of the heap and keeps the pool of the interned
+	 * strings, the string literals among them. The strings of the pool are roots of the collector.
+	 * The methods that allocate may collect, so the references they take by reference must be roots,
+	 * as the slots of an operand stack: they are updated when the objects move
+	 */
+	class Strings {
+	public:
+		/**
+		 * Constructor
+		 * @param heap where the strings are allocated
+		 */
+		explicit Strings(Heap &);
+
+		/**
+		 * @return the symbol of java/lang/String, the class of every string
+		 */
+		static u4 stringClass();
+
+		/**
+		 * @return the symbol of java/lang/StringBuilder
+		 */
+		static u4 builderClass();
+
+		/**
+		 * Allocates a string, its characters zeroed
+		 * @param length number of characters
+		 * @param coder StringObject::LATIN1 or StringObject::UTF16
+		 * @return reference to the string
+		 */
+		u4 create(u4 length, u1 coder);
+
+		/**
+		 * Allocates a string of UTF-16 code units, compacted to Latin-1 when it can be
+		 * @return reference to the string
+		 */
+		u4 create(const std::u16string &);
+
+		/**
+		 * Gets the string of a String entry of a runtime constant pool, interned the first time
+		 * @param entry the String entry, remembers its place in the pool
+		 * @return reference to the string
+		 */
+		u4 literal(RuntimeEntry &);
+
+		/**
+		 * Interns the string of a String entry of a runtime constant pool, as literal
+		 * @param entry the String entry, remembers its place in the pool
+		 * @return index of the string in the pool, it stays there for the whole run
+		 */
+		u4 literalIndex(RuntimeEntry &);
+
+		/**
+		 * @return the string at an index of the pool, as literalIndex gives it
+		 */
+		u4 pooled(u4 index) const {
+			return pool[index];
+		}
+
+		/**
+		 * Gets the string of the pool equal to a string, adding the string when there is none
+		 * @return reference to the string of the pool
+		 */
+		u4 intern(u4 ref);
+
+		/**
+		 * Allocates an empty StringBuilder, its buffer is allocated by the first append
+		 * @return reference to the builder
+		 */
+		u4 newBuilder();
+
+		/**
+		 * Grows the buffer of a builder to hold some characters
+		 * @param builder the builder, a root
+		 * @param capacity number of characters
+		 */
+		void ensureCapacity(u4 &builder, u4 capacity);
+
+		/**
+		 * Appends the characters of a string or of a builder, "null" for null and the text of Object.toString for other objects
+		 * @param builder the builder, a root
+		 * @param value the object appended, a root
+		 */
+		void append(u4 &builder, u4 &value);
+
+		/**
+		 * Appends Latin-1 text, as the text of a number
+		 * @param builder the builder, a root
+		 * @param text the characters
+		 * @param length number of characters
+		 */
+		void append(u4 &builder, const char *text, u4 length);
+
+		/**
+		 * Appends a character
+		 * @param builder the builder, a root
+		 * @param c UTF-16 code unit
+		 */
+		void append(u4 &builder, u2 c);
+
+		/**
+		 * Truncates a builder, or pads it with null characters
+		 * @param builder the builder, a root
+		 * @param length new number of characters
+		 */
+		void setLength(u4 &builder, i4 length);
+
+		/**
+		 * Creates a string with the characters of a builder, compacted to Latin-1 when it can be
+		 * @param builder the builder, a root
+		 * @return reference to the string
+		 */
+		u4 toString(u4 &builder);
+
+		/**
+		 * @return the payload of a builder
+		 */
+		StringBuilderObject *builder(u4 ref) const {
+			return heap.data<StringBuilderObject>(ref);
+		}
+
+		/**
+		 * @return the payload of a string
+		 */
+		StringObject *get(u4 ref) const {
+			return heap.data<StringObject>(ref);
+		}
+
+		/**
+		 * @return the characters of a Latin-1 string
+		 */
+		u1 *latin1(u4 ref) const {
+			return reinterpret_cast<u1 *>(get(ref) + 1);
+		}
+
+		/**
+		 * @return the code units of a UTF-16 string
+		 */
+		u2 *utf16(u4 ref) const {
+			return reinterpret_cast<u2 *>(get(ref) + 1);
+		}
+
+		/**
+		 * @return the number of characters of a string or of a builder
+		 */
+		u4 length(u4 ref) const {
+			return view(ref).length;
+		}
+
+		/**
+		 * @return the coder of the characters of a string or of a builder
+		 */
+		u1 coder(u4 ref) const {
+			return view(ref).coder;
+		}
+
+		/**
+		 * @return the character at an index of a string or of a builder, throwing the StringIndexOutOfBoundsException
+		 */
+		u2 charAt(u4 ref, i4 index) const;
+
+		/**
+		 * Copies the characters of a string or of a builder
+		 * @param ref the string or builder
+		 * @param to where the characters are written
+		 * @param coder of the characters written, UTF16 unless the source is Latin-1
+		 */
+		void getChars(u4 ref, u1 *to, u1 coder) const;
+
+		/**
+		 * @return whether an object is a string or a builder, whose characters are read by the methods above
+		 */
+		bool isText(u4 ref) const {
+			return heap.get(ref)->klass == stringClass() || heap.get(ref)->klass == builderClass();
+		}
+
+		/**
+		 * @return the text of Object.toString, the name of the class and the reference as the identity hash
+		 */
+		std::string objectText(u4 ref) const;
+
+		/**
+		 * Text of a primitive value other than char, as String.valueOf
+		 * @param type first character of the descriptor of the value
+		 * @param slots the slots of the value, two for long and double
+		 * @param out at least NumberFormat::MAX_LENGTH characters, for the Latin-1 text
+		 * @return number of characters written
+		 */
+		static u4 valueOf(char type, const op4 *slots, char *out);
+
+		/**
+		 * Copies characters, widening Latin-1 to UTF-16
+		 * @param from the characters copied
+		 * @param fromCoder of the characters copied
+		 * @param length number of characters
+		 * @param to where the characters are written
+		 * @param toCoder of the characters written, UTF16 unless fromCoder is LATIN1
+		 */
+		static void copyChars(const u1 *from, u1 fromCoder, u4 length, u1 *to, u1 toCoder);
+
+		/**
+		 * Decodes the modified UTF-8 of the class files
+		 * @return the UTF-16 code units
+		 */
+		static std::u16string decode(const std::string &);
+
+		/**
+		 * @return the hashCode of a string, computed once
+		 */
+		i4 hashCode(u4 ref);
+
+		/**
+		 * @return whether two strings have the same characters
+		 */
+		bool equals(u4 a, u4 b) const;
+
+		/**
+		 * Writes a string or the characters of a builder
+		 * @param out where the characters are written
+		 * @param ref the string or builder
+		 */
+		void print(PrintStream &, u4 ref) const;
+
+		/**
+		 * Forwards the strings of the pool, during a collection
+		 */
+		void forwardRoots();
+
+	private:
+		static const u4 MAX_LENGTH = u4(1) << 30;	///> Characters of the longest string or builder
+
+		/**
+		 * Characters of a string or of a builder
+		 */
+		struct Chars {
+			const u1 *data;	///> First character
+			u4 length;	///> Number of characters
+			u1 coder;	///> StringObject::LATIN1 or StringObject::UTF16
+		};
+
+		/**
+		 * @return the characters of a string or of a builder, valid until the next allocation
+		 */
+		Chars view(u4 ref) const;
+
+		/**
+		 * Makes room for characters at the end of a builder, growing its buffer geometrically
+		 * @param builder the builder, a root
+		 * @param more number of characters appended
+		 * @param coder of the characters appended, the buffer is inflated to UTF-16 for UTF16
+		 * @return where the characters go, in the coder of the builder, valid until the next allocation
+		 */
+		u1 *appendSpace(u4 &builder, u4 more, u1 coder);
+
+		/**
+		 * Finds the string of the pool with some characters
+		 * @param chars the UTF-16 code units
+		 * @param hash hashCode of the characters
+		 * @return index of the string in the pool, or -1
+		 */
+		i4 find(const std::u16string &chars, i4 hash) const;
+
+		/**
+		 * @return the UTF-16 code units of a string
+		 */
+		std::u16string chars(u4 ref) const;
+
+		Heap &heap;	///> Where the strings are allocated
+
+		std::vector<u4> pool;	///> Interned strings
+
+		std::unordered_multimap<i4, u4> byHash;	///> Index in the pool of the interned strings, by hashCode
+	};
+
+}
@@ -5,24 +5,26 @@
 
 namespace jvm {
 
+	/**
+	 * Local variables of a frame, a view over a region of the FramesStack arena
+	 */
 	class Variables {
 	public:
 		/**
 		 * Constructor
 		 */
-		//Variables(uint32_t);
-		Variables();
+		Variables() = default;
 
 		/**
-		 * Destructor
+		 * Binds the variables vector to its storage
+		 * @param vec first slot of the local variables
 		 */
-		~Variables();
+		void bind(op4 *);
 
 		/**
-		 * Sets the maximum size of the variables vector
-		 * @param size
+		 * @return first slot of the local variables, the operand stack follows them
 		 */
-		void setSize(u4 size);
+		op4 *begin() const { return vec; }
 
 		/**
 		 * Gets a value of the variables vector given it's index
@@ -68,11 +70,7 @@ namespace jvm {
 
 	private:
 
-		std::vector<op4> vec;	///> Array of op4
-
-		// TODO: implement this
-		//> Array of op4
-		// op4* vec;
+		op4 *vec = nullptr;	///> Array of op4
 	};
 
 }
@@ -1,12 +1,23 @@
 #include <vector>
 #include <string>
 
+#include "base.hpp"
 #include "JvmException.hpp"
 
 namespace jvm {
     struct CommandState {
         bool shouldDescribe;
         bool shouldRun;
+        bool threaded;
+        bool benchmark;
+        bool prefetch;
+        unsigned prefetchWorkers;
+        bool gcStats;
+        unsigned long heapMegabytes;
+        long youngMegabytes;
+        std::vector<u1> superinstructions;
+        unsigned sequences;
+        bool registers;
         std::string filename;
     };
 
@@ -22,6 +33,16 @@ namespace jvm {
          */
         static void show_help();
 
+        /*
+         * Gets the opcodes of the superinstructions named in a list separated by commas.
+         */
+        static std::vector<u1> parseSuperinstructions(const std::string &names);
+
+        /*
+         * Gets the number after the prefix of an option, between 0 and max, or throws a usage message.
+         */
+        static unsigned long parseNumber(const std::string &command, size_t prefix, unsigned long max);
+
         /*
          * Show help information about the CLI.
          */
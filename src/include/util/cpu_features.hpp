@@ -0,0 +1,31 @@
+#pragma once
+
+#include "base.hpp"
+
+namespace jvm {
+
+	/**
+	 * Instruction set extensions of the CPU running the engine, detected once at startup.
+	 * Every flag is false out of x86, where the natives use the scalar code
+	 */
+	class CpuFeatures {
+	public:
+		/**
+		 * @return the features of this CPU
+		 */
+		static const CpuFeatures &get();
+
+		bool sse2 = false;	///> sqrtsd, scalar double arithmetic in registers
+
+		bool sse41 = false;	///> roundsd and roundss, floor, ceil and rint in one instruction
+
+		bool fma = false;	///> vfmadd, a * b + c rounded once
+
+	private:
+		/**
+		 * Detects the features
+		 */
+		CpuFeatures();
+	};
+
+}
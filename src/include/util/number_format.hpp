@@ -0,0 +1,50 @@
+#pragma once
+
+#include "base.hpp"
+
+namespace jvm {
+
+	/**
+	 * Text of the numbers as java/lang/String.valueOf writes it, into a caller buffer and without iostreams
+	 */
+	class NumberFormat {
+	public:
+		static const u4 MAX_LENGTH = 32;	///> Characters of the longest text written
+
+		/**
+		 * Writes an integer, two digits at a time from a table
+		 * @param value the number, an int widened or a long
+		 * @param out at least MAX_LENGTH characters
+		 * @return number of characters written
+		 */
+		static u4 writeLong(i8 value, char *out);
+
+		/**
+		 * Writes a double with the fewest digits that read back as the same double, as Double.toString
+		 * @param value the number
+		 * @param out at least MAX_LENGTH characters
+		 * @return number of characters written
+		 */
+		static u4 writeDouble(double value, char *out);
+
+		/**
+		 * Writes a float with the fewest digits that read back as the same float, as Float.toString
+		 * @param value the number
+		 * @param out at least MAX_LENGTH characters
+		 * @return number of characters written
+		 */
+		static u4 writeFloat(float value, char *out);
+
+	private:
+		/**
+		 * Writes the shortest decimal digits of a finite non-zero number as Java does: plain when the magnitude
+		 * is in [10^-3, 10^7), computerized scientific notation otherwise
+		 * @param value the number, a float widened or a double
+		 * @param single whether the digits must only read back as the same float
+		 * @param out at least MAX_LENGTH characters
+		 * @return number of characters written
+		 */
+		static u4 writeShortest(double value, bool single, char *out);
+	};
+
+}
@@ -4,13 +4,19 @@
 
 namespace jvm {
 
+	/**
+	 * Reads a .class file from a memory mapping or from a buffer in memory.
+	 * Fields are decoded in place, with big-endian bounds-checked loads.
+	 */
 	class Reader {
 	private:
-		std::ifstream _class;       ///< Stream with the .class file
+		std::shared_ptr<const uint8_t> buffer; ///< Owner of the bytes of the .class file
 
-		std::vector<uint8_t> bytes; ///< Bytes read from file
+		const uint8_t *data = nullptr;         ///< Bytes of the .class file
 
-		int32_t index;              ///< Index in the vector
+		uint32_t length = 0;                   ///< Number of bytes of the .class file
+
+		uint32_t index = 0;                    ///< Index of the next byte
 
 		/**
 		* Check if it is a .class file
@@ -21,14 +27,22 @@ namespace jvm {
 	public:
 
 		/**
-		* Open a .class file
+		* Open a .class file, mapping it in memory when the system allows it
 		* @param  filename The name of the .class we are opening
 		* @see isValid()
 		*/
 		void open(std::string &filename);
 
 		/**
-		* Close the .class file
+		* Use a .class already in memory, the caller keeps the buffer alive while it is used
+		* @param bytes The contents of the .class
+		* @param size Number of bytes of the .class
+		* @see isValid()
+		*/
+		void open(const uint8_t *bytes, uint32_t size);
+
+		/**
+		* Close the .class file, the mapping lives while the buffer() is shared
 		*/
 		void close();
 
@@ -38,6 +52,19 @@ namespace jvm {
 		*/
 		uint64_t size();
 
+		/**
+		* Owner of the bytes of the .class file. Whoever keeps pointers from getBytes() must keep it
+		* @return Shared pointer to the bytes
+		*/
+		std::shared_ptr<const uint8_t> getBuffer();
+
+		/**
+		* Get the next bytes in the file, without copying them
+		* @param n number of bytes
+		* @return Pointer to the bytes, valid while getBuffer() is alive
+		*/
+		const uint8_t *getBytes(uint32_t n);
+
 		/**
 		* Get the next byte in the file
 		* @return The next Byte
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <string>
+
+#include "base.hpp"
+
+namespace jvm {
+
+	/**
+	 * Global table of interned names and descriptors. Each distinct UTF-8 string gets a stable
+	 * 32-bit id, so classes and methods are looked up by integer compares and every name is
+	 * kept in memory once.
+	 */
+	class Symbols {
+	public:
+		/**
+		 * Gets the id of a string, adding it to the table the first time
+		 * @param text the string
+		 * @return id of the string
+		 */
+		static u4 intern(const std::string &);
+
+		/**
+		 * Gets the string of an id, without taking the lock
+		 * @param id a value returned by intern()
+		 * @return the string, which lives as long as the program
+		 */
+		static const std::string &get(u4 id) {
+			return chunks[id >> CHUNK_SHIFT].load(std::memory_order_acquire)[id & (CHUNK_SIZE - 1)];
+		}
+
+		/**
+		 * Key of a method: the ids of its name and of its descriptor
+		 * @param name id of the name
+		 * @param descriptor id of the descriptor
+		 */
+		static u8 key(u4 name, u4 descriptor) {
+			return static_cast<u8>(name) << 32 | descriptor;
+		}
+
+	private:
+		static const u4 CHUNK_SHIFT = 12;
+
+		static const u4 CHUNK_SIZE = 1 << CHUNK_SHIFT;	///> Strings of a chunk
+
+		static const u4 MAX_CHUNKS = 1 << 12;	///> Chunks of the table, for 16M strings
+
+		static std::mutex mutex;	///> Classes are parsed by several threads when prefetching, intern() takes it
+
+		static std::unordered_map<std::string, u4> ids;	///> Id of each string
+
+		static u4 count;	///> Strings in the table
+
+		static std::atomic<std::string *> chunks[MAX_CHUNKS];	///> String of each id, in chunks that never move nor grow
+	};
+
+}
@@ -23,6 +23,10 @@ namespace jvm {
 				auto constantValuePtr = std::make_shared<AttrConstantValue>(reader, cp);
 				ConstValues.push_back(constantValuePtr);
 				push_back(constantValuePtr);
+			} else if (name == "BootstrapMethods") {
+				auto bootstrapMethodsPtr = std::make_shared<AttrBootstrapMethods>(reader, cp);
+				BootstrapMethods.push_back(bootstrapMethodsPtr);
+				push_back(bootstrapMethodsPtr);
 			} else {
 				// In this case, the attribute is of a type we won't read
 				// Add a nullptr and skip the attribute's bytes
@@ -50,10 +54,8 @@ namespace jvm {
 		max_locals = reader.getNextHalfWord();
 
 		u4 code_length = reader.getNextWord();
-		code_bytes.reserve(code_length);
-		while (code_length--) {
-			code_bytes.emplace_back(reader.getNextByte());
-		}
+		auto bytes = reader.getBytes(code_length);
+		code_bytes.assign(bytes, bytes + code_length);
 
 		code.interpret(code_bytes);
 
@@ -72,11 +74,14 @@ namespace jvm {
 	void AttrCode::printToStream(std::ostream &os, ConstantPool &cp, std::string &prefix) {
 		os << prefix << "Code:" << std::endl;
 
-		for (auto pair : code) {
-			auto instr = pair.second;
+		for (u4 pc = 0; pc < code.size(); pc++) {
+			auto instr = code[pc].info;
+			if (instr == nullptr) { // bytes of the arguments of an instruction
+				continue;
+			}
 			auto prefix2 = prefix + "\t";
 			auto fakeprefix = std::string("");
-			os << prefix2 << pair.first << ": ";
+			os << prefix2 << pc << ": ";
 			instr->printToStream(os, fakeprefix, cp);
 		}
 	}
@@ -100,4 +105,28 @@ namespace jvm {
 	void AttrExceptions::printToStream(std::ostream &os, ConstantPool &pool, std::string &prefix) {
 		os << prefix << "Exception (count: " << exception_index_table.size() << ")" << std::endl;
 	}
+
+	AttrBootstrapMethods::AttrBootstrapMethods(Reader &reader, ConstantPool &cp) {
+		auto count = reader.getNextHalfWord();
+		bootstrap_methods.resize(count);
+		for (auto &method : bootstrap_methods) {
+			method.bootstrap_method_ref = reader.getNextHalfWord();
+			auto arguments = reader.getNextHalfWord();
+			method.bootstrap_arguments.reserve(arguments);
+			while (arguments--) {
+				method.bootstrap_arguments.push_back(reader.getNextHalfWord());
+			}
+		}
+	}
+
+	void AttrBootstrapMethods::printToStream(std::ostream &os, ConstantPool &cp, std::string &prefix) {
+		os << prefix << "BootstrapMethods (count: " << bootstrap_methods.size() << ")" << std::endl;
+		for (size_t i = 0; i < bootstrap_methods.size(); i++) {
+			os << prefix << "\t" << i << ": #" << bootstrap_methods[i].bootstrap_method_ref << " (";
+			for (size_t j = 0; j < bootstrap_methods[i].bootstrap_arguments.size(); j++) {
+				os << (j > 0 ? ", #" : "#") << bootstrap_methods[i].bootstrap_arguments[j];
+			}
+			os << ")" << std::endl;
+		}
+	}
 }
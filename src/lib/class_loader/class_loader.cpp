@@ -17,9 +17,11 @@ namespace jvm {
 
 		for (int i = 0; i < methods_count; ++i) {
 			MethodInfo currentMethod(file, constant_pool);
-			auto name = currentMethod.getName(constant_pool);
-			auto descriptor = currentMethod.getDescriptor(constant_pool);
-			methods.insert({name + descriptor, currentMethod});
+			auto name = constant_pool[currentMethod.name_index]->as<CP_Utf8>().symbol;
+			auto descriptor = constant_pool[currentMethod.descriptor_index]->as<CP_Utf8>().symbol;
+			auto key = Symbols::key(name, descriptor);
+			methods.insert({key, currentMethod});
+			method_keys.push_back(key);
 		}
 
 	}
@@ -78,6 +80,18 @@ namespace jvm {
 		auto file = Reader();
 
 		file.open(filename);
+		read(file);
+	}
+
+	void ClassLoader::read (const uint8_t *data, uint32_t size) {
+		auto file = Reader();
+
+		file.open(data, size);
+		read(file);
+	}
+
+	void ClassLoader::read (Reader &file) {
+		bytes = file.getBuffer();
 
 		read_version(file);
 		read_cp(file);
@@ -90,6 +104,107 @@ namespace jvm {
 		file.close();
 	}
 
+	void ClassLoader::layout_fields (ClassLoader *super) {
+		instance_size = 0;
+		field_offsets.clear();
+		reference_offsets.clear();
+
+		if (super != nullptr) {
+			instance_size = super->instance_size;
+			field_offsets = super->field_offsets;
+			reference_offsets = super->reference_offsets;
+		}
+
+		layout(false, instance_size, field_offsets, reference_offsets);
+
+		// The static fields of the superclasses stay in their own storage
+		uint32_t static_size = 0;
+		static_offsets.clear();
+		static_reference_offsets.clear();
+		layout(true, static_size, static_offsets, static_reference_offsets);
+		static_storage.assign((static_size + 7) / 8, 0);
+	}
+
+	void ClassLoader::layout (bool statics, uint32_t &size, std::unordered_map<u8, u4> &offsets, std::vector<u4> &references) {
+		auto symbol = [this](u2 index) { return static_cast<CP_Utf8 *>(constant_pool[index])->symbol; };
+		auto bytes = [](char type) -> u4 {
+			switch (type) {
+				case 'J': case 'D': return 8;
+				case 'C': case 'S': return 2;
+				case 'B': case 'Z': return 1;
+				default:            return 4; // int, float and references, that are heap offsets
+			}
+		};
+
+		struct Pending { u8 key; u4 bytes; bool reference; };
+		std::vector<Pending> pending;
+
+		for (auto &field : fields) {
+			if (((field.access_flags & fields::STATIC) != 0) == statics) {
+				auto descriptor = symbol(field.descriptor_index);
+				auto type = Symbols::get(descriptor)[0];
+				pending.push_back({Symbols::key(symbol(field.name_index), descriptor), bytes(type), type == 'L' || type == '['});
+			}
+		}
+
+		std::stable_sort(pending.begin(), pending.end(), [](const Pending &a, const Pending &b) { return a.bytes > b.bytes; });
+
+		auto place = [&](const Pending &field) {
+			size = (size + field.bytes - 1) & ~(field.bytes - 1);
+			offsets[field.key] = size;
+			if (field.reference) {
+				references.push_back(size);
+			}
+			size += field.bytes;
+		};
+
+		// Narrower fields first fill the padding the superclass left before the 8 byte fields
+		if (not pending.empty() && pending.front().bytes == 8) {
+			for (auto field = pending.begin(); field != pending.end() && size % 8 != 0;) {
+				if (field->bytes < 8 && field->bytes <= 8 - size % 8 && size % field->bytes == 0) {
+					place(*field);
+					field = pending.erase(field);
+				} else {
+					++field;
+				}
+			}
+		}
+
+		for (auto &field : pending) { // by decreasing size, so each one is already aligned after the first
+			place(field);
+		}
+	}
+
+	void ClassLoader::apply_constant_values () {
+		auto symbol = [this](u2 index) { return static_cast<CP_Utf8 *>(constant_pool[index])->symbol; };
+		auto storage = reinterpret_cast<u1 *>(static_storage.data());
+		string_constants.clear();
+
+		for (auto &field : fields) {
+			if (not (field.access_flags & fields::STATIC) || field.attributes.ConstValues.empty()) {
+				continue;
+			}
+
+			auto descriptor = symbol(field.descriptor_index);
+			auto offset = static_offsets[Symbols::key(symbol(field.name_index), descriptor)];
+			auto slot = storage + offset;
+			auto index = field.attributes.ConstValues[0]->constantvalue_index;
+			auto value = runtime[index].value.ull;
+
+			if (runtime[index].tag == CP_TAGS::String) {
+				string_constants.emplace_back(offset, index);
+				continue;
+			}
+
+			switch (Symbols::get(descriptor)[0]) {
+				case 'Z': case 'B': *slot = static_cast<u1>(value); break;
+				case 'C': case 'S': *reinterpret_cast<u2 *>(slot) = static_cast<u2>(value); break;
+				case 'J': case 'D': *reinterpret_cast<u8 *>(slot) = value; break;
+				default:            *reinterpret_cast<u4 *>(slot) = static_cast<u4>(value); break;
+			}
+		}
+	}
+
 	void ClassLoader::print_class_flags() {
 		auto flag = (uint32_t) access_flags;
 		std::cout << "Access Flags:" << std::endl;
@@ -132,8 +247,8 @@ namespace jvm {
 		std::cout << "Methods:";
 
 		auto i = 0;
-		for (auto& item : methods) {
-			auto& method = item.second;
+		for (auto key : method_keys) {
+			auto& method = methods[key];
 			std::cout << std::endl << "\t[" << std::setfill('0') << std::setw(2) << ++i << "] ";
 			method.PrintToStream(std::cout, constant_pool, "");
 		}
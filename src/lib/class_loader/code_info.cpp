@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "class_loader/code_info.hpp"
 #include "util/JvmException.hpp"
 
@@ -263,16 +265,197 @@ namespace jvm {
 	};
 
 	void CodeInfo::interpret(std::vector<u1> &data) {
+		clear();
+		resize(data.size(), Instruction());
+
 		for (uint32_t i = 0; i < data.size(); i++) {
 			auto opcode = data[i];
 			auto instr = getInstr(opcode);
 			auto paramsRead = instr->fillParams(i, data);
 
-			insert({i, instr});
+			auto &decoded = at(i);
+			decoded.opcode = opcode;
+			decoded.jmp = static_cast<u2>(paramsRead);
+			decoded.info = instr.get();
+			decode(i, data, decoded);
+
+			instructions.push_back(instr);
 			i += paramsRead;
 		}
 	}
 
+	void CodeInfo::fuse(const std::vector<u1> &enabled) {
+		std::vector<const Superinstruction *> tried;
+		for (auto opcode : enabled) {
+			tried.push_back(superinstruction(opcode));
+		}
+		std::stable_sort(tried.begin(), tried.end(), [](const Superinstruction *a, const Superinstruction *b) {
+			return a->sequence.size() > b->sequence.size();
+		});
+
+		auto end = data() + size();
+		for (auto first = data(); first < end; first = first->next()) {
+			for (auto super : tried) {
+				auto instr = first;
+				auto matched = 0u;
+				while (matched < super->sequence.size() && instr < end && family(instr->opcode) == super->sequence[matched]) {
+					instr = instr->next();
+					matched++;
+				}
+
+				if (matched == super->sequence.size()) {
+					first->opcode = super->opcode;
+					break;
+				}
+			}
+		}
+	}
+
+	const std::vector<Superinstruction> &CodeInfo::superinstructions() {
+		static const std::vector<Superinstruction> supers = {
+			{"iload_iload", ILOAD_ILOAD, {21, 21}},
+			{"iload_iload_iadd_istore", ILOAD_ILOAD_IADD_ISTORE, {21, 21, 96, 54}},
+			{"aload_iload_iaload", ALOAD_ILOAD_IALOAD, {25, 21, 46}},
+			{"aload_iload_iload_iastore", ALOAD_ILOAD_ILOAD_IASTORE, {25, 21, 21, 79}},
+			{"iload_iload_if_icmplt", ILOAD_ILOAD_IF_ICMPLT, {21, 21, 161}},
+			{"iload_iload_if_icmpge", ILOAD_ILOAD_IF_ICMPGE, {21, 21, 162}},
+			{"iload_iconst_if_icmplt", ILOAD_ICONST_IF_ICMPLT, {21, 16, 161}},
+			{"iload_iconst_if_icmpge", ILOAD_ICONST_IF_ICMPGE, {21, 16, 162}},
+			{"iinc_goto", IINC_GOTO, {132, 167}},
+			{"iinc_iload_iload_if_icmplt", IINC_ILOAD_ILOAD_IF_ICMPLT, {132, 21, 21, 161}}
+		};
+		return supers;
+	}
+
+	const Superinstruction *CodeInfo::superinstruction(u1 opcode) {
+		for (auto &super : superinstructions()) {
+			if (super.opcode == opcode) {
+				return &super;
+			}
+		}
+		return nullptr;
+	}
+
+	u1 CodeInfo::sequenceLength(u1 opcode) {
+		static const std::vector<u1> lengths = [] {
+			std::vector<u1> table(256, 1);
+			for (auto &super : superinstructions()) {
+				table[super.opcode] = static_cast<u1>(super.sequence.size());
+			}
+			return table;
+		}();
+		return lengths[opcode];
+	}
+
+	u1 CodeInfo::family(u1 opcode) {
+		if (opcode >= 26 && opcode <= 45) { // [ilfda]load_<n>
+			return static_cast<u1>(21 + (opcode - 26) / 4);
+		} else if (opcode >= 59 && opcode <= 78) { // [ilfda]store_<n>
+			return static_cast<u1>(54 + (opcode - 59) / 4);
+		} else if ((opcode >= 2 && opcode <= 8) || opcode == 17) { // iconst_<i>, sipush
+			return 16;
+		} else if (opcode == 200) { // goto_w
+			return 167;
+		}
+
+		switch (opcode) { // the quick forms are the bytecode they were rewritten from
+			case GETSTATIC_QUICK: return 178;
+			case PUTSTATIC_QUICK: return 179;
+			case INVOKESTATIC_QUICK: return 184;
+			case LDC_QUICK: case LDC_STRING_QUICK: return 18;
+			case LDC2_W_QUICK: return 20;
+			case GETFIELD_QUICK: return 180;
+			case PUTFIELD_QUICK: return 181;
+			case NEW_QUICK: case NEW_BUILDER_QUICK: return 187;
+			case MULTIANEWARRAY_QUICK: return 197;
+			case INVOKEVIRTUAL_QUICK: case INVOKENATIVE_QUICK: return 182;
+			case INVOKESPECIAL_QUICK: return 183;
+			default: return opcode;
+		}
+	}
+
+	std::string CodeInfo::mnemonic(u1 opcode) {
+		auto super = superinstruction(opcode);
+		if (super != nullptr) {
+			return super->name;
+		} else if (opcode == 16) { // every int constant, see family()
+			return "iconst";
+		}
+		return instruction_set[opcode] ? instruction_set[opcode]()->getName() : "opcode " + std::to_string(opcode);
+	}
+
+	void CodeInfo::decode(u4 pc, std::vector<u1> &data, Instruction &instr) {
+		// The short forms get their implicit operand too, so the superinstructions read it as for the long ones
+		if (instr.opcode >= 26 && instr.opcode <= 45) { // [ilfda]load_<n>
+			instr.index = static_cast<u2>((instr.opcode - 26) % 4);
+		} else if (instr.opcode >= 59 && instr.opcode <= 78) { // [ilfda]store_<n>
+			instr.index = static_cast<u2>((instr.opcode - 59) % 4);
+		} else if (instr.opcode >= 2 && instr.opcode <= 8) { // iconst_<i>
+			instr.value = instr.opcode - 3;
+		}
+
+		switch (instr.opcode) {
+			case 16: // bipush
+				instr.value = Converter::to_i1(data[pc + 1]);
+				break;
+			case 17: // sipush
+				instr.value = Converter::to_i2(data[pc + 1], data[pc + 2]);
+				break;
+			case 18:                     // ldc
+			case 21: case 22: case 23:   // iload, lload, fload
+			case 24: case 25:            // dload, aload
+			case 54: case 55: case 56:   // istore, lstore, fstore
+			case 57: case 58:            // dstore, astore
+			case 169:                    // ret
+				instr.index = data[pc + 1];
+				break;
+			case 19: case 20:            // ldc_w, ldc2_w
+			case 178: case 179:          // getstatic, putstatic
+			case 180: case 181:          // getfield, putfield
+			case 182: case 183: case 184: case 185: case 186: // invokes
+			case 187: case 189:          // new, anewarray
+			case 192: case 193:          // checkcast, instanceof
+				instr.index = Converter::to_u2(data[pc + 1], data[pc + 2]);
+				break;
+			case 132: // iinc
+				instr.index = data[pc + 1];
+				instr.value = Converter::to_i1(data[pc + 2]);
+				break;
+			case 188: // newarray
+				instr.value = data[pc + 1];
+				break;
+			case 197: // multianewarray
+				instr.index = Converter::to_u2(data[pc + 1], data[pc + 2]);
+				instr.value = data[pc + 3];
+				break;
+			case 153: case 154: case 155: case 156: case 157: case 158: // if<cond>
+			case 159: case 160: case 161: case 162: case 163: case 164: // if_icmp<cond>
+			case 165: case 166:          // if_acmp<cond>
+			case 167: case 168:          // goto, jsr
+			case 198: case 199:          // ifnull, ifnonnull
+				instr.target = static_cast<u4>(static_cast<i4>(pc) + Converter::to_i2(data[pc + 1], data[pc + 2]));
+				break;
+			case 200: case 201: // goto_w, jsr_w
+				instr.target = static_cast<u4>(static_cast<i4>(pc) + Converter::to_i4(data[pc + 1], data[pc + 2], data[pc + 3], data[pc + 4]));
+				break;
+			case 170: // tableswitch
+				instr.target = static_cast<u4>(static_cast<i4>(pc) + static_cast<OPINFOtableswitch *>(instr.info)->defaultbyte);
+				break;
+			case 171: // lookupswitch
+				instr.target = static_cast<u4>(static_cast<i4>(pc) + static_cast<OPINFOlookupswitch *>(instr.info)->defaultbyte);
+				break;
+			case 196: // wide, decoded as the modified instruction with a wide index
+				instr.opcode = data[pc + 1];
+				instr.index = Converter::to_u2(data[pc + 2], data[pc + 3]);
+				if (instr.opcode == 132) { // iinc
+					instr.value = Converter::to_i2(data[pc + 4], data[pc + 5]);
+				}
+				break;
+			default:
+				break;
+		}
+	}
+
 	std::shared_ptr<InstructionInfo> CodeInfo::getInstr(u1 &opcode) {
 		auto instrInstantiator = instruction_set[opcode];
 
@@ -229,17 +229,13 @@ namespace jvm {
 	}
 
 	void CP_MethodHandle::printToStream(std::ostream &os, ConstantPool &cp) {
-		CP_Entry* name1  = cp[reference_index];
-		auto& nam1 = name1->as<CP_MethodHandle>();
 		os << "Method Handle" << std::endl;
 		os << "\tReference Kind: " << CP_MethodHandle::toString(cp);
-		os << "\tReference: " << nam1.reference_index << std::endl;
+		os << "\tReference: #" << reference_index << std::endl;
 	}
 
 	std::string CP_MethodHandle::toString(ConstantPool &cp) {
-		CP_Entry* name1  = cp[reference_index];
-		auto& nam1 = name1->as<CP_MethodHandle>();
-		switch(nam1.reference_kind) {
+		switch(reference_kind) {
 			case 0x01: return "REF_getField\n";
 			case 0x02: return "REF_getStatic\n";
 			case 0x03: return "REF_putField\n";
@@ -331,31 +327,20 @@ namespace jvm {
 	}
 
 	void CP_InvokeDynamic::printToStream(std::ostream &os, ConstantPool &cp) {
-		CP_Entry* name1 = cp[bootstrap_method_attr_index];
-		CP_Entry* name2 = cp[name_and_type_index];
-		auto& nam1 = name1->as<CP_Utf8>();
-		auto& nam2 = name2->as<CP_Utf8>();
 		os << "InvokeDynamic" << std::endl;
-		os << "\t\tBootstrap_method: " << nam1 <<std::endl;
-		os << "\t\tName and Type: " << nam2 <<std::endl;
+		os << "\t\tBootstrap_method: " << bootstrap_method_attr_index << std::endl; // index in the BootstrapMethods attribute
+		os << "\t\tName and Type: #" << name_and_type_index << " ";
+		cp[name_and_type_index]->printToStream(os, cp);
 	}
 
 	std::string CP_InvokeDynamic::toString(ConstantPool &cp) {
-		CP_Entry* name1 = cp[bootstrap_method_attr_index];
-		auto& nam1 = name1->as<CP_Utf8>();
-		return nam1.toString(cp);
+		return cp[name_and_type_index]->toString(cp);
 	}
 
 	CP_Utf8::CP_Utf8(Reader &reader) {
 		_length = reader.getNextHalfWord();
-		_bytes = new uint8_t[_length];
-		for (int i = 0; i < _length; ++i) {
-			_bytes[i] = reader.getNextByte();
-		}
-	}
-
-	CP_Utf8::~CP_Utf8() {
-		delete[] _bytes;
+		_bytes = reader.getBytes(_length);
+		symbol = Symbols::intern(toString());
 	}
 
 	void CP_Utf8::printToStream(std::ostream &os, ConstantPool &cp) {
@@ -3803,7 +3803,7 @@ namespace jvm {
 	uint32_t OPINFOtableswitch::fillParams (uint32_t idx, std::vector<u1>& data) {
 		uint32_t i = idx + 1;
 
-		i += (i % 4); // this jump is needed! A tableswitch is a variable-length instruction. Immediately after the tableswitch opcode, between zero and three bytes must act as padding, such that defaultbyte1 begins at an address that is a multiple of four bytes from the start of the current method (the opcode of its first instruction).
+		i += (4 - i % 4) % 4; // this jump is needed! A tableswitch is a variable-length instruction. Immediately after the tableswitch opcode, between zero and three bytes must act as padding, such that defaultbyte1 begins at an address that is a multiple of four bytes from the start of the current method (the opcode of its first instruction).
 
 		defaultbyte = Converter::to_i4(data[i], data[i+1], data[i+2], data[i+3]); i += 4;
 		low         = Converter::to_i4(data[i], data[i+1], data[i+2], data[i+3]); i += 4;
@@ -3811,7 +3811,7 @@ namespace jvm {
 
 		auto n = high - low + 1;
 
-		if (low <= high) {
+		if (low > high) {
 			throw JvmException("Invalid tableswitch");
 		}
 
@@ -3850,7 +3850,7 @@ namespace jvm {
 	uint32_t OPINFOlookupswitch::fillParams (uint32_t idx, std::vector<u1>& data) {
 		uint32_t i = idx + 1;
 
-		i += (i % 4); // this jump is needed! A tableswitch is a variable-length instruction. Immediately after the tableswitch opcode, between zero and three bytes must act as padding, such that defaultbyte1 begins at an address that is a multiple of four bytes from the start of the current method (the opcode of its first instruction).
+		i += (4 - i % 4) % 4; // this jump is needed! A tableswitch is a variable-length instruction. Immediately after the tableswitch opcode, between zero and three bytes must act as padding, such that defaultbyte1 begins at an address that is a multiple of four bytes from the start of the current method (the opcode of its first instruction).
 
 		defaultbyte = Converter::to_i4(data[i], data[i+1], data[i+2], data[i+3]); i += 4;
 		npairs      = Converter::to_i4(data[i], data[i+1], data[i+2], data[i+3]); i += 4;
@@ -4187,7 +4187,7 @@ namespace jvm {
 		if(!count)
 			throw JvmException("Invalid invokeinterface: the value of count must not be zero");
 
-		if(!data[idx+4])
+		if(data[idx+4])
 			throw JvmException("Invalid invokeinterface: the value of the last argument must be zero");
 
 		return 4;
@@ -4213,7 +4213,7 @@ namespace jvm {
 
 	uint32_t OPINFOinvokedynamic::fillParams (uint32_t idx, std::vector<u1>& data) {
 		index = Converter::to_u2(data[idx+1], data[idx+2]);
-		if(!data[idx+3] || !data[idx+4]) {
+		if(data[idx+3] || data[idx+4]) {
 			throw JvmException("Invalid invokedynamic: the value of the last 2 arguments must be zero");
 		}
 		return 4;
@@ -0,0 +1,442 @@
+#include "class_loader/register_code.hpp"
+#include "class_loader/attribute.hpp"
+#include "util/JvmException.hpp"
+
+namespace jvm {
+
+	namespace {
+		const u1 LOAD_TYPES[] = { T_INT, T_LONG, T_FLOAT, T_DOUBLE, T_ARRAY }; ///< Tags the stack handlers push for [ilfda]load
+
+		/**
+		 * Value of an operand stack slot while a method is translated
+		 */
+		struct StackValue {
+			enum Kind : u1 {
+				SLOT,       ///> Written to its register
+				LOCAL,      ///> Load not written to its register yet, the consumer reads the local
+				CONSTANT    ///> Constant not written to its register yet, the consumer may take it as an operand
+			};
+
+			Kind kind;	///> Where the value is
+
+			u1 type;	///> Type tag of the value
+
+			bool wide;	///> Whether it is a long or a double, the slot above it is its second half
+
+			u2 reg;	///> SLOT: its register, LOCAL: the local
+
+			i4 value;	///> CONSTANT: the constant
+		};
+
+		/**
+		 * Translates the bytecodes of a method in order, keeping the operand stack as the place of each value
+		 */
+		class Translator {
+		public:
+			Translator(AttrCode &codeAttr, RuntimeConstantPool &runtime, RegisterCode &out, std::vector<u4> &entries)
+				: code(codeAttr.code), codeAttr(codeAttr), runtime(runtime), out(out), entries(entries) {}
+
+			/**
+			 * Translates the whole code, then turns the targets of the branches from PCs into indices
+			 */
+			void run();
+
+		private:
+			/**
+			 * Marks the instructions where control flow joins: the operand stack is written to its registers there
+			 */
+			void findLeaders();
+
+			/**
+			 * Translates an instruction, the others run with the stack handlers
+			 */
+			void translate(Instruction &instruction, u4 pc);
+
+			/**
+			 * Appends an instruction to the register code
+			 * @return the instruction
+			 */
+			RegisterInstruction &emit(u1 opcode, u1 type, u2 dst, u2 a = 0, u2 b = 0, i4 value = 0);
+
+			/**
+			 * Appends an instruction that writes the operand stack slot at the top, pushing the result
+			 */
+			void result(u1 opcode, u1 type, bool wide, u2 a, u2 b = 0, i4 value = 0);
+
+			/**
+			 * Appends a branch, the operand stack written to its registers before
+			 */
+			void branch(u1 opcode, u4 target, u2 a = 0, u2 b = 0, i4 value = 0);
+
+			/**
+			 * Stores the top of the operand stack in a local, making the operation that produced it write the local
+			 */
+			void store(u2 local, bool wide);
+
+			/**
+			 * Writes the pending loads of a local to their registers, before the local changes
+			 */
+			void clobber(u2 local, bool wide);
+
+			/**
+			 * Writes a pending value to its register
+			 * @param depth slot of the value in the operand stack
+			 */
+			void materialize(u4 depth);
+
+			/**
+			 * Writes every pending value to its register
+			 */
+			void flush();
+
+			/**
+			 * Sets the operand stack to the slots in use before an instruction, every value in its register
+			 * @param pc the instruction, not reached at all when past the code or never reached by the verifier
+			 */
+			void reset(u4 pc);
+
+			void push(StackValue value);
+
+			StackValue pop(bool wide);
+
+			/**
+			 * Pops a value, writing it to its register when it is a constant
+			 * @return the register of the value
+			 */
+			u2 popRegister(bool wide);
+
+			/**
+			 * @return the register of an operand stack slot
+			 */
+			u2 slot(u4 depth) const {
+				return static_cast<u2>(codeAttr.max_locals + depth);
+			}
+
+			CodeInfo &code;	///> Bytecodes translated
+
+			AttrCode &codeAttr;	///> Code of the method
+
+			RuntimeConstantPool &runtime;	///> Constants of ldc
+
+			RegisterCode &out;	///> Register code written
+
+			std::vector<u4> &entries;	///> Index of the first instruction of each bytecode
+
+			std::vector<bool> leaders;	///> Whether control flow joins at a PC
+
+			std::vector<StackValue> stack;	///> Place of each operand stack slot
+
+			std::vector<u4> branches;	///> Instructions whose target is still a PC
+
+			bool producer = false;	///> Whether the last instruction wrote the top of the operand stack, so a store may take its place
+		};
+
+		void Translator::run() {
+			entries.assign(code.size(), 0);
+			findLeaders();
+
+			for (u4 pc = 0; pc < code.size(); pc += code[pc].jmp + 1) {
+				auto &instruction = code[pc];
+
+				if (instruction.depth == Instruction::UNREACHABLE) {
+					entries[pc] = static_cast<u4>(out.size());
+					emit(R_STACK, 0, 0).pc = pc;
+					out.back().depth = Instruction::UNREACHABLE;
+					continue;
+				}
+
+				if (leaders[pc]) {
+					flush(); // the path falling through
+					reset(pc);
+				}
+
+				if (stack.size() != instruction.depth) {
+					throw JvmException("InternalError: operand stack of " + std::to_string(stack.size()) + " slots at " + std::to_string(pc));
+				}
+
+				entries[pc] = static_cast<u4>(out.size());
+				translate(instruction, pc);
+			}
+
+			for (auto i : branches) {
+				out[i].target = entries[out[i].target];
+			}
+		}
+
+		void Translator::findLeaders() {
+			leaders.assign(code.size(), false);
+			leaders[0] = true;
+
+			for (u4 pc = 0; pc < code.size(); pc += code[pc].jmp + 1) {
+				auto &instruction = code[pc];
+
+				switch (CodeInfo::family(instruction.opcode)) {
+					case 153: case 154: case 155: case 156: case 157: case 158: // if<cond>
+					case 159: case 160: case 161: case 162: case 163: case 164: // if_icmp<cond>
+					case 165: case 166:          // if_acmp<cond>
+					case 167: case 168: case 201: // goto, jsr, jsr_w
+					case 198: case 199:          // ifnull, ifnonnull
+						leaders[instruction.target] = true;
+						break;
+					case 170:                    // tableswitch
+						leaders[instruction.target] = true;
+						for (auto offset : static_cast<OPINFOtableswitch *>(instruction.info)->jumpOffsets) {
+							leaders[static_cast<u4>(static_cast<i4>(pc) + offset)] = true;
+						}
+						break;
+					case 171:                    // lookupswitch
+						leaders[instruction.target] = true;
+						for (auto &pair : static_cast<OPINFOlookupswitch *>(instruction.info)->pairs) {
+							leaders[static_cast<u4>(static_cast<i4>(pc) + pair.second)] = true;
+						}
+						break;
+					default:
+						break;
+				}
+			}
+
+			for (auto &handler : codeAttr.exception_table) {
+				leaders[handler.handler_pc] = true;
+			}
+		}
+
+		void Translator::translate(Instruction &instruction, u4 pc) {
+			auto opcode = CodeInfo::family(instruction.opcode);
+
+			switch (opcode) {
+				case 0:                          // nop
+					return;
+				case 1:                          // aconst_null
+					push({StackValue::CONSTANT, T_REF, false, 0, 0});
+					return;
+				case 16:                         // iconst_<i>, bipush, sipush
+					push({StackValue::CONSTANT, T_INT, false, 0, instruction.value});
+					return;
+				case 9: case 10:                 // lconst_<l>
+					push({StackValue::CONSTANT, T_LONG, true, 0, opcode - 9});
+					return;
+				case 18: case 19: {              // ldc, ldc_w of an int or a float, the strings allocate
+					auto &k = runtime[instruction.index];
+					if (k.tag == CP_TAGS::Integer || k.tag == CP_TAGS::Float) {
+						push({StackValue::CONSTANT, k.tag == CP_TAGS::Integer ? u1(T_INT) : u1(T_FLOAT), false, 0, static_cast<i4>(k.value.ull)});
+						return;
+					}
+					break;
+				}
+				case 21: case 22: case 23: case 24: case 25: // [ilfda]load
+					push({StackValue::LOCAL, LOAD_TYPES[opcode - 21], opcode == 22 || opcode == 24, instruction.index, 0});
+					return;
+				case 54: case 55: case 56: case 57: case 58: // [ilfda]store
+					store(instruction.index, opcode == 55 || opcode == 57);
+					return;
+				case 132:                        // iinc
+					clobber(instruction.index, false);
+					emit(R_IINC, 0, instruction.index, 0, 0, instruction.value);
+					return;
+				case 96: case 100: {             // iadd, isub
+					auto b = pop(false);
+					if (b.kind == StackValue::CONSTANT) {
+						auto a = popRegister(false);
+						result(R_IADD_CONST, T_INT, false, a, 0, static_cast<i4>(opcode == 96 ? static_cast<u4>(b.value) : 0u - static_cast<u4>(b.value)));
+					} else {
+						auto a = popRegister(false);
+						result(opcode == 96 ? R_IADD : R_ISUB, T_INT, false, a, b.reg);
+					}
+					return;
+				}
+				case 104: case 126: case 128: case 130: // imul, iand, ior, ixor
+				case 120: case 122: case 124: {  // ishl, ishr, iushr
+					static const u1 OPERATIONS[] = { R_ISHL, 0, R_ISHR, 0, R_IUSHR, 0, R_IAND, 0, R_IOR, 0, R_IXOR };
+					auto b = popRegister(false);
+					auto a = popRegister(false);
+					result(opcode == 104 ? R_IMUL : OPERATIONS[opcode - 120], T_INT, false, a, b);
+					return;
+				}
+				case 116:                        // ineg
+					result(R_INEG, T_INT, false, popRegister(false));
+					return;
+				case 97: case 101: case 105: {   // ladd, lsub, lmul
+					auto b = popRegister(true);
+					auto a = popRegister(true);
+					result(opcode == 97 ? R_LADD : opcode == 101 ? R_LSUB : R_LMUL, T_LONG, true, a, b);
+					return;
+				}
+				case 99: case 103: case 107: case 111: { // dadd, dsub, dmul, ddiv
+					auto b = popRegister(true);
+					auto a = popRegister(true);
+					result(static_cast<u1>(R_DADD + (opcode - 99) / 4), T_DOUBLE, true, a, b);
+					return;
+				}
+				case 133:                        // i2l
+					result(R_I2L, T_LONG, true, popRegister(false));
+					return;
+				case 135:                        // i2d
+					result(R_I2D, T_DOUBLE, true, popRegister(false));
+					return;
+				case 136:                        // l2i
+					result(R_L2I, T_INT, false, popRegister(true));
+					return;
+				case 46: {                       // iaload
+					auto index = popRegister(false);
+					auto array = popRegister(false);
+					result(R_IALOAD, T_INT, false, array, index);
+					return;
+				}
+				case 79: {                       // iastore
+					auto value = popRegister(false);
+					auto index = popRegister(false);
+					auto array = popRegister(false);
+					emit(R_IASTORE, 0, value, array, index);
+					return;
+				}
+				case 190:                        // arraylength
+					result(R_ARRAYLENGTH, T_INT, false, popRegister(false));
+					return;
+				case 153: case 154: case 155: case 156: case 157: case 158: // if<cond>
+					branch(static_cast<u1>(R_IFEQ + (opcode - 153)), instruction.target, popRegister(false));
+					reset(pc + instruction.jmp + 1);
+					return;
+				case 159: case 160: case 161: case 162: case 163: case 164: { // if_icmp<cond>
+					auto b = pop(false);
+					auto a = popRegister(false);
+					if (b.kind == StackValue::CONSTANT) {
+						branch(static_cast<u1>(R_IF_ICMPEQ_CONST + (opcode - 159)), instruction.target, a, 0, b.value);
+					} else {
+						branch(static_cast<u1>(R_IF_ICMPEQ + (opcode - 159)), instruction.target, a, b.reg);
+					}
+					reset(pc + instruction.jmp + 1);
+					return;
+				}
+				case 165: case 166: {            // if_acmp<cond>
+					auto b = popRegister(false);
+					auto a = popRegister(false);
+					branch(static_cast<u1>(R_IF_ACMPEQ + (opcode - 165)), instruction.target, a, b);
+					reset(pc + instruction.jmp + 1);
+					return;
+				}
+				case 198: case 199:              // ifnull, ifnonnull
+					branch(static_cast<u1>(R_IFNULL + (opcode - 198)), instruction.target, popRegister(false));
+					reset(pc + instruction.jmp + 1);
+					return;
+				case 167:                        // goto, goto_w
+					branch(R_GOTO, instruction.target);
+					reset(pc + instruction.jmp + 1);
+					return;
+				default:
+					break;
+			}
+
+			// The stack handler finds every operand in the operand stack
+			flush();
+			auto &stackInstruction = emit(R_STACK, 0, 0);
+			stackInstruction.pc = pc;
+			stackInstruction.depth = instruction.depth;
+			reset(pc + instruction.jmp + 1);
+		}
+
+		RegisterInstruction &Translator::emit(u1 opcode, u1 type, u2 dst, u2 a, u2 b, i4 value) {
+			out.push_back({opcode, type, dst, a, b, 0, value, 0, 0});
+			producer = false;
+			return out.back();
+		}
+
+		void Translator::result(u1 opcode, u1 type, bool wide, u2 a, u2 b, i4 value) {
+			auto dst = slot(static_cast<u4>(stack.size()));
+			emit(opcode, type, dst, a, b, value);
+			push({StackValue::SLOT, type, wide, dst, 0});
+			producer = true;
+		}
+
+		void Translator::branch(u1 opcode, u4 target, u2 a, u2 b, i4 value) {
+			flush();
+			branches.push_back(static_cast<u4>(out.size()));
+			emit(opcode, 0, 0, a, b, value).target = target;
+		}
+
+		void Translator::store(u2 local, bool wide) {
+			auto value = pop(wide);
+			clobber(local, wide); // any instruction it appends comes after the producer, which keeps writing the slot
+
+			if (value.kind == StackValue::SLOT && producer && out.back().dst == value.reg) {
+				out.back().dst = local;
+				producer = false;
+			} else if (value.kind == StackValue::CONSTANT) {
+				emit(wide ? R_CONST2 : R_CONST, 0, local, 0, 0, value.value);
+			} else if (value.reg != local) {
+				emit(wide ? R_MOVE2 : R_MOVE, 0, local, value.reg);
+			}
+		}
+
+		void Translator::clobber(u2 local, bool wide) {
+			for (u4 i = 0; i < stack.size(); i++) {
+				auto &value = stack[i];
+				if (value.kind == StackValue::LOCAL && value.reg < local + (wide ? 2 : 1) && local < value.reg + (value.wide ? 2 : 1)) {
+					materialize(i);
+				}
+			}
+		}
+
+		void Translator::materialize(u4 depth) {
+			auto &value = stack[depth];
+
+			if (value.kind == StackValue::LOCAL) {
+				emit(value.wide ? R_MOVE2 : R_MOVE, value.type, slot(depth), value.reg);
+			} else if (value.kind == StackValue::CONSTANT) {
+				emit(value.wide ? R_CONST2 : R_CONST, value.type, slot(depth), 0, 0, value.value);
+			}
+
+			value.kind = StackValue::SLOT;
+			value.reg = slot(depth);
+		}
+
+		void Translator::flush() {
+			for (u4 i = 0; i < stack.size(); i++) {
+				materialize(i);
+			}
+		}
+
+		void Translator::reset(u4 pc) {
+			stack.clear();
+			if (pc < code.size() && code[pc].depth != Instruction::UNREACHABLE) {
+				for (u4 i = 0; i < code[pc].depth; i++) {
+					stack.push_back({StackValue::SLOT, 0, false, slot(i), 0});
+				}
+			}
+			producer = false;
+		}
+
+		void Translator::push(StackValue value) {
+			stack.push_back(value);
+			if (value.wide) {
+				stack.push_back({StackValue::SLOT, value.type, false, slot(static_cast<u4>(stack.size())), 0});
+			}
+		}
+
+		StackValue Translator::pop(bool wide) {
+			if (wide) {
+				stack.pop_back(); // the second half
+			}
+			auto value = stack.back();
+			stack.pop_back();
+			return value;
+		}
+
+		u2 Translator::popRegister(bool wide) {
+			auto value = pop(wide);
+			if (value.kind == StackValue::CONSTANT) {
+				stack.push_back(value);
+				materialize(static_cast<u4>(stack.size() - 1));
+				stack.pop_back();
+				return slot(static_cast<u4>(stack.size()));
+			}
+			return value.reg;
+		}
+	}
+
+	void RegisterCode::translate(AttrCode &codeAttr, RuntimeConstantPool &runtime) {
+		clear();
+		locals = codeAttr.max_locals;
+		Translator(codeAttr, runtime, *this, entries).run();
+	}
+
+}
@@ -0,0 +1,95 @@
+#include "class_loader/runtime_constant_pool.hpp"
+
+namespace jvm {
+
+	void RuntimeConstantPool::build(ConstantPool &cp) {
+		clear();
+		resize(cp.size() + 1);
+
+		auto symbol = [&cp](u2 index) { return static_cast<CP_Utf8 *>(cp[index])->symbol; };
+
+		for (size_type i = 1; i <= cp.size(); i++) {
+			auto entry = cp[i];
+			if (entry == nullptr) { // second slot of Long and Double
+				continue;
+			}
+
+			auto &slot = (*this)[i];
+			slot.tag = entry->getTag();
+
+			switch (slot.tag) {
+				case CP_TAGS::Utf8:
+					slot.text = static_cast<CP_Utf8 *>(entry)->symbol;
+					break;
+				case CP_TAGS::Integer:
+					slot.value.ull = static_cast<CP_Integer *>(entry)->_bytes;
+					break;
+				case CP_TAGS::Float:
+					slot.value.ull = static_cast<CP_Float *>(entry)->_bytes;
+					break;
+				case CP_TAGS::Long: {
+					auto number = static_cast<CP_Long *>(entry);
+					slot.value.ull = static_cast<u8>(number->high_bytes) << 32 | number->low_bytes;
+					break;
+				}
+				case CP_TAGS::Double: {
+					auto number = static_cast<CP_Double *>(entry);
+					slot.value.ull = static_cast<u8>(number->high_bytes) << 32 | number->low_bytes;
+					break;
+				}
+				case CP_TAGS::String:
+					slot.text = symbol(static_cast<CP_String *>(entry)->string_index);
+					break;
+				case CP_TAGS::Class:
+					slot.text = symbol(static_cast<CP_Class *>(entry)->name_index);
+					break;
+				case CP_TAGS::NameAndType: {
+					auto nameAndType = static_cast<CP_NameAndType *>(entry);
+					slot.text = symbol(nameAndType->name_index);
+					slot.descriptor = symbol(nameAndType->descriptor_index);
+					break;
+				}
+				case CP_TAGS::MethodType:
+					slot.descriptor = symbol(static_cast<CP_MethodType *>(entry)->descriptor_index);
+					break;
+				default:
+					break;
+			}
+		}
+
+		// References point to entries resolved above
+		for (size_type i = 1; i <= cp.size(); i++) {
+			auto entry = cp[i];
+			if (entry == nullptr) {
+				continue;
+			}
+
+			auto &slot = (*this)[i];
+			u2 nameAndType = 0;
+
+			switch (slot.tag) {
+				case CP_TAGS::FieldRef:
+					slot.classIndex = static_cast<CP_Fieldref *>(entry)->class_index;
+					nameAndType = static_cast<CP_Fieldref *>(entry)->name_and_type_index;
+					break;
+				case CP_TAGS::MethodRef:
+					slot.classIndex = static_cast<CP_Methodref *>(entry)->class_index;
+					nameAndType = static_cast<CP_Methodref *>(entry)->name_and_type_index;
+					break;
+				case CP_TAGS::InterfaceMethodRef:
+					slot.classIndex = static_cast<CP_InterfaceMethodref *>(entry)->class_index;
+					nameAndType = static_cast<CP_InterfaceMethodref *>(entry)->name_and_class_index;
+					break;
+				case CP_TAGS::InvokeDynamic:
+					nameAndType = static_cast<CP_InvokeDynamic *>(entry)->name_and_type_index;
+					break;
+				default:
+					continue;
+			}
+
+			slot.text = (*this)[nameAndType].text;
+			slot.descriptor = (*this)[nameAndType].descriptor;
+		}
+	}
+
+}
@@ -0,0 +1,563 @@
+#include "class_loader/verifier.hpp"
+#include "class_loader/instruction_info.hpp"
+
+namespace jvm {
+
+	namespace {
+		const u1 ARRAY_TYPES[] = { V_INT, V_LONG, V_FLOAT, V_DOUBLE, V_REF, V_INT, V_INT, V_INT }; ///< [ilfdabcs]aload and [ilfdabcs]astore
+		const u1 LOCAL_TYPES[] = { V_INT, V_LONG, V_FLOAT, V_DOUBLE, V_REF };                       ///< [ilfda]load and [ilfda]store
+		const u1 CONVERSIONS[][2] = {                                                              ///< From and to of i2l (133) to i2s (147)
+			{V_INT, V_LONG}, {V_INT, V_FLOAT}, {V_INT, V_DOUBLE},
+			{V_LONG, V_INT}, {V_LONG, V_FLOAT}, {V_LONG, V_DOUBLE},
+			{V_FLOAT, V_INT}, {V_FLOAT, V_LONG}, {V_FLOAT, V_DOUBLE},
+			{V_DOUBLE, V_INT}, {V_DOUBLE, V_LONG}, {V_DOUBLE, V_FLOAT},
+			{V_INT, V_INT}, {V_INT, V_INT}, {V_INT, V_INT}
+		};
+
+		bool isWide(u1 type) {
+			return type == V_LONG || type == V_DOUBLE;
+		}
+
+		bool isGcPoint(u1 opcode) {
+			// ldc, ldc_w, getstatic, putstatic, invoke*, new, newarray, anewarray, multianewarray
+			return opcode == 18 || opcode == 19 || opcode == 178 || opcode == 179 || (opcode >= 182 && opcode <= 189) || opcode == 197;
+		}
+	}
+
+	void Verifier::verify(ClassLoader &classLoader) {
+		for (auto &pair : classLoader.methods) {
+			verify(classLoader, pair.second);
+		}
+	}
+
+	void Verifier::verify(ClassLoader &classLoader, MethodInfo &method) {
+		if (method.attributes.Codes.empty()) { // native and abstract methods have no code
+			return;
+		}
+
+		Verifier verifier(classLoader, method, *method.attributes.Codes[0]);
+		verifier.run();
+	}
+
+	Verifier::Verifier(ClassLoader &cl, MethodInfo &mt, AttrCode &codeAttr) : cl(cl), mt(mt), codeAttr(codeAttr) {
+		frames.resize(codeAttr.code.size());
+	}
+
+	void Verifier::run() {
+		if (codeAttr.code.empty()) {
+			fail("empty code");
+		}
+
+		// Entry frame: this, then the arguments of the descriptor
+		VerifierFrame entry;
+		entry.locals.assign(codeAttr.max_locals, V_TOP);
+
+		auto descriptor = cl.constant_pool[mt.descriptor_index]->toString(cl.constant_pool);
+		u4 local = 0;
+		std::vector<u1> arguments;
+
+		if (not (mt.access_flags & methods::STATIC)) {
+			arguments.push_back(V_REF);
+		}
+
+		for (u4 i = 1; descriptor[i] != ')'; i++) {
+			arguments.push_back(typeOf(descriptor, i));
+			while (descriptor[i] == '[') i++;
+			if (descriptor[i] == 'L') {
+				while (descriptor[i] != ';') i++;
+			}
+		}
+
+		for (auto type : arguments) {
+			if (local + (isWide(type) ? 2 : 1) > codeAttr.max_locals) {
+				fail("arguments do not fit in max_locals");
+			}
+			entry.locals[local++] = type;
+			if (isWide(type)) {
+				entry.locals[local++] = V_TOP;
+			}
+		}
+
+		merge(0, entry);
+
+		while (not pending.empty()) {
+			pc = pending.back(); pending.pop_back();
+			auto &instruction = codeAttr.code[pc];
+
+			VerifierFrame frame = frames[pc];
+			VerifierFrame thrown = frame;
+
+			execute(frame);
+
+			if (frame.stack.size() > codeAttr.max_stack) {
+				fail("max_stack exceeded");
+			}
+
+			// Handlers see the locals before and after the instruction with only the exception on the stack
+			thrown.stack.assign(1, V_REF);
+			for (auto &handler : codeAttr.exception_table) {
+				if (pc >= handler.start_pc && pc < handler.end_pc) {
+					merge(handler.handler_pc, thrown);
+					std::swap(thrown.locals, frame.locals);
+					merge(handler.handler_pc, thrown);
+					std::swap(thrown.locals, frame.locals);
+				}
+			}
+
+			auto next = pc + instruction.jmp + 1;
+
+			switch (instruction.opcode) {
+				case 153: case 154: case 155: case 156: case 157: case 158: // if<cond>
+				case 159: case 160: case 161: case 162: case 163: case 164: // if_icmp<cond>
+				case 165: case 166:          // if_acmp<cond>
+				case 198: case 199:          // ifnull, ifnonnull
+					merge(instruction.target, frame);
+					merge(next, frame);
+					break;
+				case 167: case 200:          // goto, goto_w
+					merge(instruction.target, frame);
+					break;
+				case 170: {                  // tableswitch
+					merge(instruction.target, frame);
+					auto table = static_cast<OPINFOtableswitch *>(instruction.info);
+					for (auto offset : table->jumpOffsets) {
+						merge(static_cast<u4>(static_cast<i4>(pc) + offset), frame);
+					}
+					break;
+				}
+				case 171: {                  // lookupswitch
+					merge(instruction.target, frame);
+					auto table = static_cast<OPINFOlookupswitch *>(instruction.info);
+					for (auto &pair : table->pairs) {
+						merge(static_cast<u4>(static_cast<i4>(pc) + pair.second), frame);
+					}
+					break;
+				}
+				case 172: case 173: case 174: case 175: case 176: case 177: // returns
+				case 191:                    // athrow
+					break;
+				default:
+					merge(next, frame);
+					break;
+			}
+		}
+		// Reference maps where the collector may run: allocations, and invokes, where the callers wait.
+		// A frame also waits on its first instruction or on a static access while a <clinit> runs
+		for (u4 i = 0; i < frames.size(); i++) {
+			auto &frame = frames[i];
+			if (codeAttr.code[i].info != nullptr) { // the register translation maps the operand stack slots by it
+				codeAttr.code[i].depth = frame.visited ? static_cast<u2>(frame.stack.size()) : Instruction::UNREACHABLE;
+			}
+
+			if (frame.visited && (i == 0 || isGcPoint(codeAttr.code[i].opcode))) {
+				std::vector<bool> map;
+				for (auto type : frame.locals) {
+					map.push_back(type == V_REF);
+				}
+				for (auto type : frame.stack) {
+					map.push_back(type == V_REF);
+				}
+				mt.gcMaps[i] = map;
+			}
+		}
+	}
+
+	void Verifier::execute(VerifierFrame &frame) {
+		auto &instruction = codeAttr.code[pc];
+		auto &cp = cl.constant_pool;
+		auto opcode = instruction.opcode;
+
+		switch (opcode) {
+			case 0:                          // nop
+				break;
+			case 1:                          // aconst_null
+				push(frame, V_REF);
+				break;
+			case 2: case 3: case 4: case 5: case 6: case 7: case 8: // iconst_<i>
+			case 16: case 17:                // bipush, sipush
+				push(frame, V_INT);
+				break;
+			case 9: case 10:                 // lconst_<l>
+				push(frame, V_LONG);
+				break;
+			case 11: case 12: case 13:       // fconst_<f>
+				push(frame, V_FLOAT);
+				break;
+			case 14: case 15:                // dconst_<d>
+				push(frame, V_DOUBLE);
+				break;
+			case 18: case 19: case 20: {     // ldc, ldc_w, ldc2_w
+				u1 type;
+				switch (cp[instruction.index]->getTag()) {
+					case CP_TAGS::Integer: type = V_INT; break;
+					case CP_TAGS::Float:   type = V_FLOAT; break;
+					case CP_TAGS::Long:    type = V_LONG; break;
+					case CP_TAGS::Double:  type = V_DOUBLE; break;
+					case CP_TAGS::String: case CP_TAGS::Class:
+					case CP_TAGS::MethodType: case CP_TAGS::MethodHandle:
+						type = V_REF;
+						break;
+					default:
+						fail("invalid constant for ldc");
+				}
+				if (isWide(type) != (opcode == 20)) {
+					fail("invalid constant size for ldc");
+				}
+				push(frame, type);
+				break;
+			}
+			case 21: case 22: case 23: case 24: case 25: // [ilfda]load
+				load(frame, instruction.index, LOCAL_TYPES[opcode - 21]);
+				break;
+			case 26: case 27: case 28: case 29: case 30: case 31: case 32: case 33: case 34: case 35:
+			case 36: case 37: case 38: case 39: case 40: case 41: case 42: case 43: case 44: case 45: // [ilfda]load_<n>
+				load(frame, (opcode - 26) % 4, LOCAL_TYPES[(opcode - 26) / 4]);
+				break;
+			case 46: case 47: case 48: case 49: case 50: case 51: case 52: case 53: // [ilfdabcs]aload
+				pop(frame, V_INT);
+				pop(frame, V_REF);
+				push(frame, ARRAY_TYPES[opcode - 46]);
+				break;
+			case 54: case 55: case 56: case 57: case 58: // [ilfda]store
+				store(frame, instruction.index, LOCAL_TYPES[opcode - 54]);
+				break;
+			case 59: case 60: case 61: case 62: case 63: case 64: case 65: case 66: case 67: case 68:
+			case 69: case 70: case 71: case 72: case 73: case 74: case 75: case 76: case 77: case 78: // [ilfda]store_<n>
+				store(frame, (opcode - 59) % 4, LOCAL_TYPES[(opcode - 59) / 4]);
+				break;
+			case 79: case 80: case 81: case 82: case 83: case 84: case 85: case 86: // [ilfdabcs]astore
+				pop(frame, ARRAY_TYPES[opcode - 79]);
+				pop(frame, V_INT);
+				pop(frame, V_REF);
+				break;
+			case 87:                         // pop
+				if (pop(frame) == V_TOP) fail("pop of half a long or double");
+				break;
+			case 88:                         // pop2
+				pop(frame);
+				pop(frame);
+				break;
+			case 89: case 90: case 91:       // dup, dup_x1, dup_x2
+			case 92: case 93: case 94:       // dup2, dup2_x1, dup2_x2
+			case 95: {                       // swap
+				u1 v1 = pop(frame), v2 = V_TOP, v3 = V_TOP, v4 = V_TOP;
+				auto &stack = frame.stack;
+				switch (opcode) {
+					case 89:
+						if (v1 == V_TOP) fail("dup of half a long or double");
+						stack.insert(stack.end(), {v1, v1});
+						break;
+					case 90:
+						v2 = pop(frame);
+						if (v1 == V_TOP || v2 == V_TOP) fail("dup_x1 of a long or double");
+						stack.insert(stack.end(), {v1, v2, v1});
+						break;
+					case 91:
+						v2 = pop(frame); v3 = pop(frame);
+						if (v1 == V_TOP) fail("dup_x2 of half a long or double");
+						stack.insert(stack.end(), {v1, v3, v2, v1});
+						break;
+					case 92:
+						v2 = pop(frame);
+						stack.insert(stack.end(), {v2, v1, v2, v1});
+						break;
+					case 93:
+						v2 = pop(frame); v3 = pop(frame);
+						stack.insert(stack.end(), {v2, v1, v3, v2, v1});
+						break;
+					case 94:
+						v2 = pop(frame); v3 = pop(frame); v4 = pop(frame);
+						stack.insert(stack.end(), {v2, v1, v4, v3, v2, v1});
+						break;
+					default:
+						v2 = pop(frame);
+						if (v1 == V_TOP || v2 == V_TOP) fail("swap of a long or double");
+						stack.insert(stack.end(), {v1, v2});
+						break;
+				}
+				break;
+			}
+			case 96: case 97: case 98: case 99: case 100: case 101: case 102: case 103: case 104: case 105:
+			case 106: case 107: case 108: case 109: case 110: case 111: case 112: case 113: case 114: case 115: { // add, sub, mul, div, rem
+				auto type = LOCAL_TYPES[(opcode - 96) % 4];
+				pop(frame, type);
+				pop(frame, type);
+				push(frame, type);
+				break;
+			}
+			case 116: case 117: case 118: case 119: { // neg
+				auto type = LOCAL_TYPES[opcode - 116];
+				pop(frame, type);
+				push(frame, type);
+				break;
+			}
+			case 120: case 121: case 122: case 123: case 124: case 125: { // shl, shr, ushr
+				auto type = LOCAL_TYPES[(opcode - 120) % 2];
+				pop(frame, V_INT);
+				pop(frame, type);
+				push(frame, type);
+				break;
+			}
+			case 126: case 127: case 128: case 129: case 130: case 131: { // and, or, xor
+				auto type = LOCAL_TYPES[(opcode - 126) % 2];
+				pop(frame, type);
+				pop(frame, type);
+				push(frame, type);
+				break;
+			}
+			case 132:                        // iinc
+				load(frame, instruction.index, V_INT);
+				pop(frame, V_INT);
+				break;
+			case 133: case 134: case 135: case 136: case 137: case 138: case 139: case 140:
+			case 141: case 142: case 143: case 144: case 145: case 146: case 147: // conversions
+				pop(frame, CONVERSIONS[opcode - 133][0]);
+				push(frame, CONVERSIONS[opcode - 133][1]);
+				break;
+			case 148: case 149: case 150: case 151: case 152: { // lcmp, fcmp<op>, dcmp<op>
+				auto type = opcode == 148 ? V_LONG : opcode < 151 ? V_FLOAT : V_DOUBLE;
+				pop(frame, type);
+				pop(frame, type);
+				push(frame, V_INT);
+				break;
+			}
+			case 153: case 154: case 155: case 156: case 157: case 158: // if<cond>
+			case 170: case 171:              // tableswitch, lookupswitch
+				pop(frame, V_INT);
+				break;
+			case 159: case 160: case 161: case 162: case 163: case 164: // if_icmp<cond>
+				pop(frame, V_INT);
+				pop(frame, V_INT);
+				break;
+			case 165: case 166:              // if_acmp<cond>
+				pop(frame, V_REF);
+				pop(frame, V_REF);
+				break;
+			case 167: case 200:              // goto, goto_w
+				break;
+			case 172: case 173: case 174: case 175: case 176: // [ilfda]return
+				pop(frame, opcode == 176 ? V_REF : LOCAL_TYPES[opcode - 172]);
+				break;
+			case 177:                        // return
+				break;
+			case 178:                        // getstatic
+				pushDescriptor(frame, getDescriptor(instruction.index));
+				break;
+			case 179:                        // putstatic
+				pop(frame, typeOf(getDescriptor(instruction.index)));
+				break;
+			case 180:                        // getfield
+				pop(frame, V_REF);
+				pushDescriptor(frame, getDescriptor(instruction.index));
+				break;
+			case 181:                        // putfield
+				pop(frame, typeOf(getDescriptor(instruction.index)));
+				pop(frame, V_REF);
+				break;
+			case 182: case 183: case 184: case 185: case 186: { // invokes
+				auto descriptor = getDescriptor(instruction.index);
+				popArguments(frame, descriptor);
+				if (opcode != 184 && opcode != 186) { // the receiver
+					pop(frame, V_REF);
+				}
+				pushDescriptor(frame, descriptor.substr(descriptor.find(')') + 1));
+				break;
+			}
+			case 187:                        // new
+				push(frame, V_REF);
+				break;
+			case 188: case 189:              // newarray, anewarray
+				pop(frame, V_INT);
+				push(frame, V_REF);
+				break;
+			case 190:                        // arraylength
+			case 193:                        // instanceof
+				pop(frame, V_REF);
+				push(frame, V_INT);
+				break;
+			case 191:                        // athrow
+			case 194: case 195:              // monitorenter, monitorexit
+			case 198: case 199:              // ifnull, ifnonnull
+				pop(frame, V_REF);
+				break;
+			case 192:                        // checkcast
+				pop(frame, V_REF);
+				push(frame, V_REF);
+				break;
+			case 197:                        // multianewarray
+				for (i4 i = 0; i < instruction.value; i++) {
+					pop(frame, V_INT);
+				}
+				push(frame, V_REF);
+				break;
+			case 168: case 169: case 201:    // jsr, ret, jsr_w
+				fail("jsr and ret are not supported");
+			default:
+				fail("invalid opcode " + std::to_string(opcode));
+		}
+	}
+
+	void Verifier::merge(u4 pc, const VerifierFrame &frame) {
+		if (pc >= frames.size() || codeAttr.code[pc].info == nullptr) {
+			fail("jump to the middle of an instruction or out of the code");
+		}
+
+		auto &target = frames[pc];
+
+		if (not target.visited) {
+			target = frame;
+			target.visited = true;
+			pending.push_back(pc);
+			return;
+		}
+
+		if (target.stack != frame.stack) {
+			fail("inconsistent operand stack");
+		}
+
+		bool changed = false;
+		for (u4 i = 0; i < target.locals.size(); i++) {
+			if (target.locals[i] != frame.locals[i] && target.locals[i] != V_TOP) {
+				target.locals[i] = V_TOP;
+				changed = true;
+			}
+		}
+
+		if (changed) {
+			pending.push_back(pc);
+		}
+	}
+
+	void Verifier::push(VerifierFrame &frame, u1 type) {
+		frame.stack.push_back(type);
+		if (isWide(type)) {
+			frame.stack.push_back(V_TOP);
+		}
+	}
+
+	u1 Verifier::pop(VerifierFrame &frame) {
+		if (frame.stack.empty()) {
+			fail("not enough operands on stack");
+		}
+		auto type = frame.stack.back();
+		frame.stack.pop_back();
+		return type;
+	}
+
+	void Verifier::pop(VerifierFrame &frame, u1 type) {
+		if (isWide(type) && pop(frame) != V_TOP) {
+			fail("expected a long or double on the stack");
+		}
+		if (pop(frame) != type) {
+			fail("operand of the wrong type on the stack");
+		}
+	}
+
+	void Verifier::load(VerifierFrame &frame, u4 index, u1 type) {
+		if (index + (isWide(type) ? 1 : 0) >= frame.locals.size()) {
+			fail("local variable out of max_locals");
+		}
+		if (frame.locals[index] != type) {
+			fail("local variable of the wrong type");
+		}
+		push(frame, type);
+	}
+
+	void Verifier::store(VerifierFrame &frame, u4 index, u1 type) {
+		if (index + (isWide(type) ? 1 : 0) >= frame.locals.size()) {
+			fail("local variable out of max_locals");
+		}
+
+		if (type == V_REF) { // astore also stores return addresses
+			type = pop(frame);
+			if (type != V_REF && type != V_RETURN_ADDRESS) {
+				fail("astore of a value that is not a reference");
+			}
+		} else {
+			pop(frame, type);
+		}
+
+		if (index > 0 && isWide(frame.locals[index - 1])) { // the value below is now broken
+			frame.locals[index - 1] = V_TOP;
+		}
+
+		frame.locals[index] = type;
+		if (isWide(type)) {
+			frame.locals[index + 1] = V_TOP;
+		}
+	}
+
+	void Verifier::pushDescriptor(VerifierFrame &frame, const std::string &descriptor) {
+		auto type = typeOf(descriptor);
+		if (type != V_TOP) {
+			push(frame, type);
+		}
+	}
+
+	void Verifier::popArguments(VerifierFrame &frame, const std::string &descriptor) {
+		std::vector<u1> arguments;
+
+		for (u4 i = 1; descriptor[i] != ')'; i++) {
+			arguments.push_back(typeOf(descriptor, i));
+			while (descriptor[i] == '[') i++;
+			if (descriptor[i] == 'L') {
+				while (descriptor[i] != ';') i++;
+			}
+		}
+
+		for (auto it = arguments.rbegin(); it != arguments.rend(); it++) {
+			pop(frame, *it);
+		}
+	}
+
+	std::string Verifier::getDescriptor(u2 index) {
+		auto &cp = cl.constant_pool;
+		auto entry = cp[index];
+		u2 nameAndType;
+
+		switch (entry->getTag()) {
+			case CP_TAGS::FieldRef:
+				nameAndType = entry->as<CP_Fieldref>().name_and_type_index;
+				break;
+			case CP_TAGS::MethodRef:
+				nameAndType = entry->as<CP_Methodref>().name_and_type_index;
+				break;
+			case CP_TAGS::InterfaceMethodRef:
+				nameAndType = entry->as<CP_InterfaceMethodref>().name_and_class_index;
+				break;
+			case CP_TAGS::InvokeDynamic:
+				nameAndType = entry->as<CP_InvokeDynamic>().name_and_type_index;
+				break;
+			default:
+				throw JvmException("VerifyError: constant " + std::to_string(index) + " is not a field or method");
+		}
+
+		auto &descriptor = cp[nameAndType]->as<CP_NameAndType>();
+		return cp[descriptor.descriptor_index]->toString(cp);
+	}
+
+	u1 Verifier::typeOf(const std::string &descriptor, u4 i) {
+		switch (descriptor[i]) {
+			case 'B': case 'C': case 'I': case 'S': case 'Z':
+				return V_INT;
+			case 'F':
+				return V_FLOAT;
+			case 'J':
+				return V_LONG;
+			case 'D':
+				return V_DOUBLE;
+			case 'L': case '[':
+				return V_REF;
+			case 'V':
+				return V_TOP;
+			default:
+				throw JvmException("VerifyError: invalid descriptor " + descriptor);
+		}
+	}
+
+	void Verifier::fail(const std::string &message) {
+		auto name = cl.constant_pool[mt.name_index]->toString(cl.constant_pool);
+		throw JvmException("VerifyError: " + message + " in " + name + " at " + std::to_string(pc));
+	}
+
+};
@@ -0,0 +1,156 @@
+#include "engine/class_prefetcher.hpp"
+#include "util/JvmException.hpp"
+
+#include <chrono>
+
+namespace jvm {
+
+	ClassPrefetcher::~ClassPrefetcher() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		pending.notify_all();
+
+		for (auto &worker : workers) {
+			worker.join();
+		}
+	}
+
+	void ClassPrefetcher::start(const std::string &path, u4 nworkers) {
+		this->path = path;
+		serial = nworkers == 0;
+
+		for (u4 i = 0; i < nworkers; i++) {
+			workers.emplace_back(&ClassPrefetcher::work, this);
+		}
+	}
+
+	void ClassPrefetcher::request(ClassLoader &classLoader) {
+		for (auto &className : references(classLoader)) {
+			request(className);
+		}
+	}
+
+	std::vector<std::string> ClassPrefetcher::references(ClassLoader &classLoader) {
+		auto &cp = classLoader.constant_pool;
+		std::vector<std::string> classNames;
+
+		for (auto &entry : cp) {
+			if (entry == nullptr || entry->getTag() != CP_TAGS::Class) {
+				continue;
+			}
+
+			auto className = entry->toString(cp);
+			if (className[0] != '[') { // arrays have no .class file
+				classNames.push_back(className);
+			}
+		}
+
+		return classNames;
+	}
+
+	void ClassPrefetcher::request(const std::string &className) {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+
+			if (entries.count(className) > 0) {
+				return;
+			}
+			entries[className];
+
+			if (not serial) {
+				queue.push_back(className);
+				pending.notify_one();
+				return;
+			}
+		}
+
+		load(className);
+	}
+
+	void ClassPrefetcher::load(const std::string &className) {
+		auto start = std::chrono::steady_clock::now();
+		std::unique_ptr<ClassLoader> classLoader(new ClassLoader());
+
+		try {
+			classLoader->read(path + className + ".class");
+		} catch (const JvmException &e) {
+			classLoader.reset(); // the engine loads it again and reports the error
+		}
+
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+		std::vector<std::string> classNames;
+		if (classLoader != nullptr) {
+			classNames = references(*classLoader); // once published, the engine may take the class at any time
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			auto &entry = entries[className];
+			entry.classLoader = std::move(classLoader);
+			entry.seconds = elapsed.count();
+			entry.done = true;
+		}
+		parsed.notify_all();
+
+		for (auto &name : classNames) {
+			request(name);
+		}
+	}
+
+	void ClassPrefetcher::work() {
+		while (true) {
+			std::string className;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				pending.wait(lock, [this] { return stopping || not queue.empty(); });
+
+				if (stopping) {
+					return;
+				}
+
+				className = queue.front();
+				queue.pop_front();
+			}
+
+			load(className);
+		}
+	}
+
+	std::unique_ptr<ClassLoader> ClassPrefetcher::take(const std::string &className) {
+		std::unique_lock<std::mutex> lock(mutex);
+
+		auto it = entries.find(className);
+		if (it == entries.end()) {
+			return nullptr;
+		}
+
+		auto &entry = it->second;
+		if (not entry.done) {
+			auto start = std::chrono::steady_clock::now();
+			parsed.wait(lock, [&entry] { return entry.done; });
+			std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+			waited += elapsed.count();
+		}
+
+		if (entry.classLoader != nullptr) {
+			taken++;
+			if (not serial) {
+				hidden += entry.seconds;
+			}
+		}
+
+		return std::move(entry.classLoader);
+	}
+
+	void ClassPrefetcher::printStats(std::ostream &os) {
+		std::lock_guard<std::mutex> lock(mutex);
+
+		double hiddenTime = hidden > waited ? hidden - waited : 0;
+		os << "prefetch: " << taken << " of " << entries.size() << " requested classes used, "
+		   << hiddenTime * 1000.0 << " ms of loading hidden, " << waited * 1000.0 << " ms waited" << std::endl;
+	}
+
+}
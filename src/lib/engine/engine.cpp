@@ -1,5 +1,11 @@
 #include "engine/engine.hpp"
+#include "class_loader/verifier.hpp"
 #include "util/JvmException.hpp"
+#include "util/number_format.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
 
 namespace jvm {
 
@@ -208,20 +214,20 @@ namespace jvm {
 				&Engine::exec_goto_w,            // 200
 				&Engine::exec_jsr_w,             // 201
 				&Engine::exec_breakpoint,        // 202
-				nullptr,                        // 203
-				nullptr,                        // 204
-				nullptr,                        // 205
-				nullptr,                        // 206
-				nullptr,                        // 207
-				nullptr,                        // 208
-				nullptr,                        // 209
-				nullptr,                        // 210
-				nullptr,                        // 211
-				nullptr,                        // 212
-				nullptr,                        // 213
-				nullptr,                        // 214
-				nullptr,                        // 215
-				nullptr,                        // 216
+				&Engine::exec_getstatic_quick,   // 203
+				&Engine::exec_putstatic_quick,   // 204
+				&Engine::exec_invokestatic_quick,// 205
+				&Engine::exec_ldc_quick,         // 206
+				&Engine::exec_ldc_string_quick,  // 207
+				&Engine::exec_ldc2_w_quick,      // 208
+				&Engine::exec_getfield_quick,    // 209
+				&Engine::exec_putfield_quick,    // 210
+				&Engine::exec_new_quick,         // 211
+				&Engine::exec_invokevirtual_quick,// 212
+				&Engine::exec_invokespecial_quick,// 213
+				&Engine::exec_invokenative_quick,// 214
+				&Engine::exec_new_builder_quick, // 215
+				&Engine::exec_multianewarray_quick, // 216
 				nullptr,                        // 217
 				nullptr,                        // 218
 				nullptr,                        // 219
@@ -235,16 +241,16 @@ namespace jvm {
 				nullptr,                        // 227
 				nullptr,                        // 228
 				nullptr,                        // 229
-				nullptr,                        // 230
-				nullptr,                        // 231
-				nullptr,                        // 232
-				nullptr,                        // 233
-				nullptr,                        // 234
-				nullptr,                        // 235
-				nullptr,                        // 236
-				nullptr,                        // 237
-				nullptr,                        // 238
-				nullptr,                        // 239
+				&Engine::exec_iload_iload,       // 230
+				&Engine::exec_iload_iload_iadd_istore, // 231
+				&Engine::exec_aload_iload_iaload, // 232
+				&Engine::exec_aload_iload_iload_iastore, // 233
+				&Engine::exec_iload_iload_if_icmplt, // 234
+				&Engine::exec_iload_iload_if_icmpge, // 235
+				&Engine::exec_iload_iconst_if_icmplt, // 236
+				&Engine::exec_iload_iconst_if_icmpge, // 237
+				&Engine::exec_iinc_goto,         // 238
+				&Engine::exec_iinc_iload_iload_if_icmplt, // 239
 				nullptr,                        // 240
 				nullptr,                        // 241
 				nullptr,                        // 242
@@ -263,7 +269,8 @@ namespace jvm {
 				&Engine::exec_impdep2            // 255
 		};
 
-		auto name = cl.constant_pool[cl.this_class]->toString(cl.constant_pool);
+		auto &classInfo = cl.constant_pool[cl.this_class]->as<CP_Class>();
+		auto name = cl.constant_pool[classInfo.name_index]->as<CP_Utf8>().symbol;
 		JavaClasses.insert({name, cl});
 		Entry_class_name = name;
 	}
@@ -279,91 +286,1188 @@ namespace jvm {
 	}
 
 	void Engine::execute () {
-		auto main_name = std::string("main([Ljava/lang/String;)V");
-		auto cl = JavaClasses[Entry_class_name];
-		auto mt = cl.methods[main_name]; //HARD-CODED SEARCH FOR MAIN, do not modify without notifying others
+		auto main_name = Symbols::key(Symbols::intern("main"), Symbols::intern("([Ljava/lang/String;)V"));
+		auto &cl = JavaClasses[Entry_class_name];
+		auto &mt = cl.methods[main_name]; //HARD-CODED SEARCH FOR MAIN, do not modify without notifying others
+
+#ifdef JVM_THREADED_DISPATCH
+		handlers = benchmark ? runThreaded<true>(false) : runThreaded<false>(false); // only the addresses, nothing runs
+#endif
+		link(cl); // once the options are set, the superinstructions among them
 
-		// run_clinit();
 		// run_init();
 
-		Frame frame(cl, mt);                                         // Create first frame
+		heap.reserve(heapSize, nurserySize);
+		heap.collector = [this] { collectGarbage(); };
+		natives.assignable = [this](u4 klass, u4 type) { return isAssignable(klass, type); };
+		natives.createObjects();
 
-		fs.push(frame);                                              // Init first frame in JVM
+		fs.push(cl, mt);                                             // Create the first frame in the frames arena
+		run_clinit(cl);                                              // The main class is initialized before main runs
 
-		while (not fs.empty()) {                                     // This will exit when instruction 'return' is executed
-			auto curFrame = fs.top();
-			auto& codes = curFrame.mt.attributes.Codes[0]->code;     // Get the current method's executable code
-			auto instruction = codes[curFrame.PC];                   // Get the current instruction
-			auto opcode = instruction->getOpCode();                  // Got op-code of the instruction
-			auto executor = getExecutor(opcode);                     // Get pointer to instruction execution
+		auto start = std::chrono::steady_clock::now();
+
+		if (prefetch) {
+			prefetcher.start(path, prefetchWorkers);
+			prefetcher.request(cl);
+		}
 
-			(this ->* executor)(instruction.get());                  // Access the instruction and execute it
+		if (sequences > 0) {
+			runProfiling();
+		} else if (registers) {
+			runRegisters();
+		} else if (threaded) {
+#ifdef JVM_THREADED_DISPATCH
+			benchmark ? runThreaded<true>(true) : runThreaded<false>(true);
+#else
+			throw JvmException("Threaded dispatch is not available in this build");
+#endif
+		} else if (benchmark) {
+			runProfiling(); // counts the instructions, run() does not
+		} else {
+			run();
 		}
+
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+		out.flush(); // before anything else is written
 		std::cout <<"Execução concluída" << std::endl;
+
+		if (benchmark) {
+			std::cerr << (registers ? "registers" : threaded ? "threaded" : "switch") << " dispatch: "
+			          << executed << " instructions in " << elapsed.count() * 1000.0 << " ms ("
+			          << static_cast<u8>(executed / elapsed.count()) << " instructions/s)" << std::endl;
+
+			if (prefetch) {
+				prefetcher.printStats(std::cerr);
+			}
+		}
+
+		if (benchmark || gcStats) {
+			heap.printStats(std::cerr);
+		}
+
+		if (sequences > 0) {
+			profiler.printStats(std::cerr, sequences);
+		}
 	}
 
-	void Engine::run_clinit () {
-		// Won't be needed
+	void Engine::run () {
+		while (not fs.empty()) {                                     // This will exit when instruction 'return' is executed
+			auto &curFrame = fs.top();
+			auto instruction = &curFrame.code[curFrame.PC];          // Get the current pre-decoded instruction
+			auto executor = getExecutor(instruction->opcode);        // Get pointer to instruction execution
+
+			(this ->* executor)(instruction);                        // Access the instruction and execute it
+		}
+	}
+
+	void Engine::runProfiling () {
+		while (not fs.empty()) {
+			auto &curFrame = fs.top();
+			auto instruction = &curFrame.code[curFrame.PC];
+
+			auto opcode = instruction->opcode;                       // before it is quickened
+
+			if (sequences > 0) {
+				profiler.record(instruction);
+			}
+			(this ->* getExecutor(opcode))(instruction);
+			executed += CodeInfo::sequenceLength(opcode);
+		}
+	}
+
+	void Engine::runRegisters () {
+		while (not fs.empty()) {
+			auto &frame = fs.top();
+			if (benchmark) {
+				runRegisters<true>(frame, frame.mt.attributes.Codes[0]->registers);
+			} else {
+				runRegisters<false>(frame, frame.mt.attributes.Codes[0]->registers);
+			}
+		}
+	}
+
+	template <bool counting>
+	void Engine::runRegisters (Frame &frame, const RegisterCode &code) {
+		auto r = frame.variables.begin();                            // the registers: the locals, then the operand stack
+#ifndef NDEBUG
+		auto tags = frame.operands.tags() - code.locals;
+#endif
+		auto ip = code.data() + code.entry(frame.PC);
+
+		for (;;) {
+			if (counting) {
+				executed++;
+			}
+#ifndef NDEBUG
+			if (ip->type != 0) {                                     // the stack handlers check the tags of their operands
+				tags[ip->dst] = ip->type;
+				if (ip->type == T_LONG || ip->type == T_DOUBLE) {
+					tags[ip->dst + 1] = ip->type;
+				}
+			}
+#endif
+
+			switch (ip->opcode) {
+				case R_STACK: {
+					auto instruction = &frame.code[ip->pc];
+					frame.PC = ip->pc;
+					if (ip->depth != Instruction::UNREACHABLE) {
+						frame.operands.resize(ip->depth);
+					}
+
+					(this ->* getExecutor(instruction->opcode))(instruction);
+
+					if (fs.empty() || &fs.top() != &frame) {
+						return;                                      // a call, a return or a <clinit>, the loop goes on with the frame on top
+					}
+					ip = code.data() + code.entry(frame.PC);
+					continue;
+				}
+				case R_MOVE:
+					r[ip->dst] = r[ip->a];
+					break;
+				case R_MOVE2: {
+					auto low = r[ip->a], high = r[ip->a + 1];                // the locals may overlap
+					r[ip->dst] = low;
+					r[ip->dst + 1] = high;
+					break;
+				}
+				case R_CONST:
+					r[ip->dst].i4 = ip->value;
+					break;
+				case R_CONST2:
+					frame.variables.set(ip->dst, op8 { .ll = ip->value });
+					break;
+				case R_IADD:
+					r[ip->dst].ui4 = r[ip->a].ui4 + r[ip->b].ui4;
+					break;
+				case R_ISUB:
+					r[ip->dst].ui4 = r[ip->a].ui4 - r[ip->b].ui4;
+					break;
+				case R_IMUL:
+					r[ip->dst].ui4 = r[ip->a].ui4 * r[ip->b].ui4;
+					break;
+				case R_IAND:
+					r[ip->dst].ui4 = r[ip->a].ui4 & r[ip->b].ui4;
+					break;
+				case R_IOR:
+					r[ip->dst].ui4 = r[ip->a].ui4 | r[ip->b].ui4;
+					break;
+				case R_IXOR:
+					r[ip->dst].ui4 = r[ip->a].ui4 ^ r[ip->b].ui4;
+					break;
+				case R_ISHL:
+					r[ip->dst].ui4 = r[ip->a].ui4 << (r[ip->b].ui4 & 0x1f);
+					break;
+				case R_ISHR:
+					r[ip->dst].i4 = r[ip->a].i4 >> (r[ip->b].ui4 & 0x1f);
+					break;
+				case R_IUSHR:
+					r[ip->dst].ui4 = r[ip->a].ui4 >> (r[ip->b].ui4 & 0x1f);
+					break;
+				case R_IADD_CONST:
+					r[ip->dst].ui4 = r[ip->a].ui4 + static_cast<u4>(ip->value);
+					break;
+				case R_INEG:
+					r[ip->dst].ui4 = 0u - r[ip->a].ui4;
+					break;
+				case R_LADD:
+					frame.variables.set(ip->dst, op8 { .ull = frame.variables.get8(ip->a).ull + frame.variables.get8(ip->b).ull });
+					break;
+				case R_LSUB:
+					frame.variables.set(ip->dst, op8 { .ull = frame.variables.get8(ip->a).ull - frame.variables.get8(ip->b).ull });
+					break;
+				case R_LMUL:
+					frame.variables.set(ip->dst, op8 { .ull = frame.variables.get8(ip->a).ull * frame.variables.get8(ip->b).ull });
+					break;
+				case R_DADD:
+					frame.variables.set(ip->dst, op8 { .lf = frame.variables.get8(ip->a).lf + frame.variables.get8(ip->b).lf });
+					break;
+				case R_DSUB:
+					frame.variables.set(ip->dst, op8 { .lf = frame.variables.get8(ip->a).lf - frame.variables.get8(ip->b).lf });
+					break;
+				case R_DMUL:
+					frame.variables.set(ip->dst, op8 { .lf = frame.variables.get8(ip->a).lf * frame.variables.get8(ip->b).lf });
+					break;
+				case R_DDIV:
+					frame.variables.set(ip->dst, op8 { .lf = frame.variables.get8(ip->a).lf / frame.variables.get8(ip->b).lf });
+					break;
+				case R_I2L:
+					frame.variables.set(ip->dst, op8 { .ll = r[ip->a].i4 });
+					break;
+				case R_L2I:
+					r[ip->dst].i4 = static_cast<i4>(frame.variables.get8(ip->a).ll);
+					break;
+				case R_I2D:
+					frame.variables.set(ip->dst, op8 { .lf = static_cast<double>(r[ip->a].i4) });
+					break;
+				case R_IINC:
+					r[ip->dst].ui4 += static_cast<u4>(ip->value);
+					break;
+				case R_IALOAD:
+					r[ip->dst].ui4 = *arrayElement<u4>(r[ip->a].ui4, r[ip->b].i4);
+					break;
+				case R_IASTORE:
+					*arrayElement<u4>(r[ip->a].ui4, r[ip->b].i4) = r[ip->dst].ui4;
+					break;
+				case R_ARRAYLENGTH:
+					if (r[ip->a].ui4 == 0) {
+						throw JvmException("NullPointerException");
+					}
+					r[ip->dst].ui4 = heap.get(r[ip->a].ui4)->length;
+					break;
+				case R_GOTO:
+					ip = code.data() + ip->target;
+					continue;
+				case R_IFEQ: if (r[ip->a].i4 == 0) { ip = code.data() + ip->target; continue; } break;
+				case R_IFNE: if (r[ip->a].i4 != 0) { ip = code.data() + ip->target; continue; } break;
+				case R_IFLT: if (r[ip->a].i4 < 0) { ip = code.data() + ip->target; continue; } break;
+				case R_IFGE: if (r[ip->a].i4 >= 0) { ip = code.data() + ip->target; continue; } break;
+				case R_IFGT: if (r[ip->a].i4 > 0) { ip = code.data() + ip->target; continue; } break;
+				case R_IFLE: if (r[ip->a].i4 <= 0) { ip = code.data() + ip->target; continue; } break;
+				case R_IF_ICMPEQ: if (r[ip->a].i4 == r[ip->b].i4) { ip = code.data() + ip->target; continue; } break;
+				case R_IF_ICMPNE: if (r[ip->a].i4 != r[ip->b].i4) { ip = code.data() + ip->target; continue; } break;
+				case R_IF_ICMPLT: if (r[ip->a].i4 < r[ip->b].i4) { ip = code.data() + ip->target; continue; } break;
+				case R_IF_ICMPGE: if (r[ip->a].i4 >= r[ip->b].i4) { ip = code.data() + ip->target; continue; } break;
+				case R_IF_ICMPGT: if (r[ip->a].i4 > r[ip->b].i4) { ip = code.data() + ip->target; continue; } break;
+				case R_IF_ICMPLE: if (r[ip->a].i4 <= r[ip->b].i4) { ip = code.data() + ip->target; continue; } break;
+				case R_IF_ICMPEQ_CONST: if (r[ip->a].i4 == ip->value) { ip = code.data() + ip->target; continue; } break;
+				case R_IF_ICMPNE_CONST: if (r[ip->a].i4 != ip->value) { ip = code.data() + ip->target; continue; } break;
+				case R_IF_ICMPLT_CONST: if (r[ip->a].i4 < ip->value) { ip = code.data() + ip->target; continue; } break;
+				case R_IF_ICMPGE_CONST: if (r[ip->a].i4 >= ip->value) { ip = code.data() + ip->target; continue; } break;
+				case R_IF_ICMPGT_CONST: if (r[ip->a].i4 > ip->value) { ip = code.data() + ip->target; continue; } break;
+				case R_IF_ICMPLE_CONST: if (r[ip->a].i4 <= ip->value) { ip = code.data() + ip->target; continue; } break;
+				case R_IF_ACMPEQ: if (r[ip->a].ui4 == r[ip->b].ui4) { ip = code.data() + ip->target; continue; } break;
+				case R_IF_ACMPNE: if (r[ip->a].ui4 != r[ip->b].ui4) { ip = code.data() + ip->target; continue; } break;
+				case R_IFNULL: if (r[ip->a].ui4 == 0) { ip = code.data() + ip->target; continue; } break;
+				case R_IFNONNULL: if (r[ip->a].ui4 != 0) { ip = code.data() + ip->target; continue; } break;
+				default:
+					throw JvmException("Register opcode with number " + std::to_string(ip->opcode) + " does not exist!");
+			}
+
+			ip++;
+		}
+	}
+
+#ifdef JVM_THREADED_DISPATCH
+	template <bool counting>
+	const void **Engine::runThreaded (bool run) {
+		static const void *labels[256] = {
+				&&op_nop,                 // 0
+				&&op_aconst_null,         // 1
+				&&op_iconst_m1,           // 2
+				&&op_iconst_0,            // 3
+				&&op_iconst_1,            // 4
+				&&op_iconst_2,            // 5
+				&&op_iconst_3,            // 6
+				&&op_iconst_4,            // 7
+				&&op_iconst_5,            // 8
+				&&op_lconst_0,            // 9
+				&&op_lconst_1,            // 10
+				&&op_fconst_0,            // 11
+				&&op_fconst_1,            // 12
+				&&op_fconst_2,            // 13
+				&&op_dconst_0,            // 14
+				&&op_dconst_1,            // 15
+				&&op_bipush,              // 16
+				&&op_sipush,              // 17
+				&&op_ldc,                 // 18
+				&&op_ldc_w,               // 19
+				&&op_ldc2_w,              // 20
+				&&op_iload,               // 21
+				&&op_lload,               // 22
+				&&op_fload,               // 23
+				&&op_dload,               // 24
+				&&op_aload,               // 25
+				&&op_iload_0,             // 26
+				&&op_iload_1,             // 27
+				&&op_iload_2,             // 28
+				&&op_iload_3,             // 29
+				&&op_lload_0,             // 30
+				&&op_lload_1,             // 31
+				&&op_lload_2,             // 32
+				&&op_lload_3,             // 33
+				&&op_fload_0,             // 34
+				&&op_fload_1,             // 35
+				&&op_fload_2,             // 36
+				&&op_fload_3,             // 37
+				&&op_dload_0,             // 38
+				&&op_dload_1,             // 39
+				&&op_dload_2,             // 40
+				&&op_dload_3,             // 41
+				&&op_aload_0,             // 42
+				&&op_aload_1,             // 43
+				&&op_aload_2,             // 44
+				&&op_aload_3,             // 45
+				&&op_iaload,              // 46
+				&&op_laload,              // 47
+				&&op_faload,              // 48
+				&&op_daload,              // 49
+				&&op_aaload,              // 50
+				&&op_baload,              // 51
+				&&op_caload,              // 52
+				&&op_saload,              // 53
+				&&op_istore,              // 54
+				&&op_lstore,              // 55
+				&&op_fstore,              // 56
+				&&op_dstore,              // 57
+				&&op_astore,              // 58
+				&&op_istore_0,            // 59
+				&&op_istore_1,            // 60
+				&&op_istore_2,            // 61
+				&&op_istore_3,            // 62
+				&&op_lstore_0,            // 63
+				&&op_lstore_1,            // 64
+				&&op_lstore_2,            // 65
+				&&op_lstore_3,            // 66
+				&&op_fstore_0,            // 67
+				&&op_fstore_1,            // 68
+				&&op_fstore_2,            // 69
+				&&op_fstore_3,            // 70
+				&&op_dstore_0,            // 71
+				&&op_dstore_1,            // 72
+				&&op_dstore_2,            // 73
+				&&op_dstore_3,            // 74
+				&&op_astore_0,            // 75
+				&&op_astore_1,            // 76
+				&&op_astore_2,            // 77
+				&&op_astore_3,            // 78
+				&&op_iastore,             // 79
+				&&op_lastore,             // 80
+				&&op_fastore,             // 81
+				&&op_dastore,             // 82
+				&&op_aastore,             // 83
+				&&op_bastore,             // 84
+				&&op_castore,             // 85
+				&&op_sastore,             // 86
+				&&op_pop,                 // 87
+				&&op_pop2,                // 88
+				&&op_dup,                 // 89
+				&&op_dup_x1,              // 90
+				&&op_dup_x2,              // 91
+				&&op_dup2,                // 92
+				&&op_dup2_x1,             // 93
+				&&op_dup2_x2,             // 94
+				&&op_swap,                // 95
+				&&op_iadd,                // 96
+				&&op_ladd,                // 97
+				&&op_fadd,                // 98
+				&&op_dadd,                // 99
+				&&op_isub,                // 100
+				&&op_lsub,                // 101
+				&&op_fsub,                // 102
+				&&op_dsub,                // 103
+				&&op_imul,                // 104
+				&&op_lmul,                // 105
+				&&op_fmul,                // 106
+				&&op_dmul,                // 107
+				&&op_idiv,                // 108
+				&&op_ldiv,                // 109
+				&&op_fdiv,                // 110
+				&&op_ddiv,                // 111
+				&&op_irem,                // 112
+				&&op_lrem,                // 113
+				&&op_frem,                // 114
+				&&op_drem,                // 115
+				&&op_ineg,                // 116
+				&&op_lneg,                // 117
+				&&op_fneg,                // 118
+				&&op_dneg,                // 119
+				&&op_ishl,                // 120
+				&&op_lshl,                // 121
+				&&op_ishr,                // 122
+				&&op_lshr,                // 123
+				&&op_iushr,               // 124
+				&&op_lushr,               // 125
+				&&op_iand,                // 126
+				&&op_land,                // 127
+				&&op_ior,                 // 128
+				&&op_lor,                 // 129
+				&&op_ixor,                // 130
+				&&op_lxor,                // 131
+				&&op_iinc,                // 132
+				&&op_i2l,                 // 133
+				&&op_i2f,                 // 134
+				&&op_i2d,                 // 135
+				&&op_l2i,                 // 136
+				&&op_l2f,                 // 137
+				&&op_l2d,                 // 138
+				&&op_f2i,                 // 139
+				&&op_f2l,                 // 140
+				&&op_f2d,                 // 141
+				&&op_d2i,                 // 142
+				&&op_d2l,                 // 143
+				&&op_d2f,                 // 144
+				&&op_i2b,                 // 145
+				&&op_i2c,                 // 146
+				&&op_i2s,                 // 147
+				&&op_lcmp,                // 148
+				&&op_fcmpl,               // 149
+				&&op_fcmpg,               // 150
+				&&op_dcmpl,               // 151
+				&&op_dcmpg,               // 152
+				&&op_ifeq,                // 153
+				&&op_ifne,                // 154
+				&&op_iflt,                // 155
+				&&op_ifge,                // 156
+				&&op_ifgt,                // 157
+				&&op_ifle,                // 158
+				&&op_if_icmpeq,           // 159
+				&&op_if_icmpne,           // 160
+				&&op_if_icmplt,           // 161
+				&&op_if_icmpge,           // 162
+				&&op_if_icmpgt,           // 163
+				&&op_if_icmple,           // 164
+				&&op_if_acmpeq,           // 165
+				&&op_if_acmpne,           // 166
+				&&op_goto,                // 167
+				&&op_jsr,                 // 168
+				&&op_ret,                 // 169
+				&&op_tableswitch,         // 170
+				&&op_lookupswitch,        // 171
+				&&op_ireturn,             // 172
+				&&op_lreturn,             // 173
+				&&op_freturn,             // 174
+				&&op_dreturn,             // 175
+				&&op_areturn,             // 176
+				&&op_return,              // 177
+				&&op_getstatic,           // 178
+				&&op_putstatic,           // 179
+				&&op_getfield,            // 180
+				&&op_putfield,            // 181
+				&&op_invokevirtual,       // 182
+				&&op_invokespecial,       // 183
+				&&op_invokestatic,        // 184
+				&&op_invokeinterface,     // 185
+				&&op_invokedynamic,       // 186
+				&&op_new,                 // 187
+				&&op_newarray,            // 188
+				&&op_anewarray,           // 189
+				&&op_arraylength,         // 190
+				&&op_athrow,              // 191
+				&&op_checkcast,           // 192
+				&&op_instanceof,          // 193
+				&&op_monitorenter,        // 194
+				&&op_monitorexit,         // 195
+				&&op_wide,                // 196
+				&&op_multianewarray,      // 197
+				&&op_ifnull,              // 198
+				&&op_ifnonnull,           // 199
+				&&op_goto_w,              // 200
+				&&op_jsr_w,               // 201
+				&&op_breakpoint,          // 202
+				&&op_getstatic_quick,     // 203
+				&&op_putstatic_quick,     // 204
+				&&op_invokestatic_quick,  // 205
+				&&op_ldc_quick,           // 206
+				&&op_ldc_string_quick,    // 207
+				&&op_ldc2_w_quick,        // 208
+				&&op_getfield_quick,      // 209
+				&&op_putfield_quick,      // 210
+				&&op_new_quick,           // 211
+				&&op_invokevirtual_quick, // 212
+				&&op_invokespecial_quick, // 213
+				&&op_invokenative_quick,  // 214
+				&&op_new_builder_quick,   // 215
+				&&op_multianewarray_quick, // 216
+				&&op_invalid,             // 217
+				&&op_invalid,             // 218
+				&&op_invalid,             // 219
+				&&op_invalid,             // 220
+				&&op_invalid,             // 221
+				&&op_invalid,             // 222
+				&&op_invalid,             // 223
+				&&op_invalid,             // 224
+				&&op_invalid,             // 225
+				&&op_invalid,             // 226
+				&&op_invalid,             // 227
+				&&op_invalid,             // 228
+				&&op_invalid,             // 229
+				&&op_iload_iload,         // 230
+				&&op_iload_iload_iadd_istore, // 231
+				&&op_aload_iload_iaload,  // 232
+				&&op_aload_iload_iload_iastore, // 233
+				&&op_iload_iload_if_icmplt, // 234
+				&&op_iload_iload_if_icmpge, // 235
+				&&op_iload_iconst_if_icmplt, // 236
+				&&op_iload_iconst_if_icmpge, // 237
+				&&op_iinc_goto,           // 238
+				&&op_iinc_iload_iload_if_icmplt, // 239
+				&&op_invalid,             // 240
+				&&op_invalid,             // 241
+				&&op_invalid,             // 242
+				&&op_invalid,             // 243
+				&&op_invalid,             // 244
+				&&op_invalid,             // 245
+				&&op_invalid,             // 246
+				&&op_invalid,             // 247
+				&&op_invalid,             // 248
+				&&op_invalid,             // 249
+				&&op_invalid,             // 250
+				&&op_invalid,             // 251
+				&&op_invalid,             // 252
+				&&op_invalid,             // 253
+				&&op_impdep1,             // 254
+				&&op_impdep2              // 255
+		};
+
+		if (not run) { // the addresses of the handlers, see link()
+			return labels;
+		}
+
+		Instruction *ip;
+
+		// Fetch the instruction of the frame on the top and jump straight to its handler
+		#define DISPATCH() do {                             \
+			auto &frame = fs.top();                          \
+			ip = &frame.code[frame.PC];                      \
+			if (counting) {                                  \
+				executed += CodeInfo::sequenceLength(ip->opcode); \
+			}                                                \
+			goto *ip->handler;                               \
+		} while (0)
+
+		// Returns may pop the last frame, which ends the execution
+		#define DISPATCH_RETURN() do {                      \
+			if (fs.empty()) {                                \
+				goto finish;                                 \
+			}                                                \
+			DISPATCH();                                      \
+		} while (0)
+
+		DISPATCH_RETURN();
+
+	op_nop:              exec_nop(ip); DISPATCH();
+	op_aconst_null:      exec_aconst_null(ip); DISPATCH();
+	op_iconst_m1:        exec_iconst_m1(ip); DISPATCH();
+	op_iconst_0:         exec_iconst_0(ip); DISPATCH();
+	op_iconst_1:         exec_iconst_1(ip); DISPATCH();
+	op_iconst_2:         exec_iconst_2(ip); DISPATCH();
+	op_iconst_3:         exec_iconst_3(ip); DISPATCH();
+	op_iconst_4:         exec_iconst_4(ip); DISPATCH();
+	op_iconst_5:         exec_iconst_5(ip); DISPATCH();
+	op_lconst_0:         exec_lconst_0(ip); DISPATCH();
+	op_lconst_1:         exec_lconst_1(ip); DISPATCH();
+	op_fconst_0:         exec_fconst_0(ip); DISPATCH();
+	op_fconst_1:         exec_fconst_1(ip); DISPATCH();
+	op_fconst_2:         exec_fconst_2(ip); DISPATCH();
+	op_dconst_0:         exec_dconst_0(ip); DISPATCH();
+	op_dconst_1:         exec_dconst_1(ip); DISPATCH();
+	op_bipush:           exec_bipush(ip); DISPATCH();
+	op_sipush:           exec_sipush(ip); DISPATCH();
+	op_ldc:              exec_ldc(ip); DISPATCH();
+	op_ldc_w:            exec_ldc_w(ip); DISPATCH();
+	op_ldc2_w:           exec_ldc2_w(ip); DISPATCH();
+	op_iload:            exec_iload(ip); DISPATCH();
+	op_lload:            exec_lload(ip); DISPATCH();
+	op_fload:            exec_fload(ip); DISPATCH();
+	op_dload:            exec_dload(ip); DISPATCH();
+	op_aload:            exec_aload(ip); DISPATCH();
+	op_iload_0:          exec_iload_0(ip); DISPATCH();
+	op_iload_1:          exec_iload_1(ip); DISPATCH();
+	op_iload_2:          exec_iload_2(ip); DISPATCH();
+	op_iload_3:          exec_iload_3(ip); DISPATCH();
+	op_lload_0:          exec_lload_0(ip); DISPATCH();
+	op_lload_1:          exec_lload_1(ip); DISPATCH();
+	op_lload_2:          exec_lload_2(ip); DISPATCH();
+	op_lload_3:          exec_lload_3(ip); DISPATCH();
+	op_fload_0:          exec_fload_0(ip); DISPATCH();
+	op_fload_1:          exec_fload_1(ip); DISPATCH();
+	op_fload_2:          exec_fload_2(ip); DISPATCH();
+	op_fload_3:          exec_fload_3(ip); DISPATCH();
+	op_dload_0:          exec_dload_0(ip); DISPATCH();
+	op_dload_1:          exec_dload_1(ip); DISPATCH();
+	op_dload_2:          exec_dload_2(ip); DISPATCH();
+	op_dload_3:          exec_dload_3(ip); DISPATCH();
+	op_aload_0:          exec_aload_0(ip); DISPATCH();
+	op_aload_1:          exec_aload_1(ip); DISPATCH();
+	op_aload_2:          exec_aload_2(ip); DISPATCH();
+	op_aload_3:          exec_aload_3(ip); DISPATCH();
+	op_iaload:           exec_iaload(ip); DISPATCH();
+	op_laload:           exec_laload(ip); DISPATCH();
+	op_faload:           exec_faload(ip); DISPATCH();
+	op_daload:           exec_daload(ip); DISPATCH();
+	op_aaload:           exec_aaload(ip); DISPATCH();
+	op_baload:           exec_baload(ip); DISPATCH();
+	op_caload:           exec_caload(ip); DISPATCH();
+	op_saload:           exec_saload(ip); DISPATCH();
+	op_istore:           exec_istore(ip); DISPATCH();
+	op_lstore:           exec_lstore(ip); DISPATCH();
+	op_fstore:           exec_fstore(ip); DISPATCH();
+	op_dstore:           exec_dstore(ip); DISPATCH();
+	op_astore:           exec_astore(ip); DISPATCH();
+	op_istore_0:         exec_istore_0(ip); DISPATCH();
+	op_istore_1:         exec_istore_1(ip); DISPATCH();
+	op_istore_2:         exec_istore_2(ip); DISPATCH();
+	op_istore_3:         exec_istore_3(ip); DISPATCH();
+	op_lstore_0:         exec_lstore_0(ip); DISPATCH();
+	op_lstore_1:         exec_lstore_1(ip); DISPATCH();
+	op_lstore_2:         exec_lstore_2(ip); DISPATCH();
+	op_lstore_3:         exec_lstore_3(ip); DISPATCH();
+	op_fstore_0:         exec_fstore_0(ip); DISPATCH();
+	op_fstore_1:         exec_fstore_1(ip); DISPATCH();
+	op_fstore_2:         exec_fstore_2(ip); DISPATCH();
+	op_fstore_3:         exec_fstore_3(ip); DISPATCH();
+	op_dstore_0:         exec_dstore_0(ip); DISPATCH();
+	op_dstore_1:         exec_dstore_1(ip); DISPATCH();
+	op_dstore_2:         exec_dstore_2(ip); DISPATCH();
+	op_dstore_3:         exec_dstore_3(ip); DISPATCH();
+	op_astore_0:         exec_astore_0(ip); DISPATCH();
+	op_astore_1:         exec_astore_1(ip); DISPATCH();
+	op_astore_2:         exec_astore_2(ip); DISPATCH();
+	op_astore_3:         exec_astore_3(ip); DISPATCH();
+	op_iastore:          exec_iastore(ip); DISPATCH();
+	op_lastore:          exec_lastore(ip); DISPATCH();
+	op_fastore:          exec_fastore(ip); DISPATCH();
+	op_dastore:          exec_dastore(ip); DISPATCH();
+	op_aastore:          exec_aastore(ip); DISPATCH();
+	op_bastore:          exec_bastore(ip); DISPATCH();
+	op_castore:          exec_castore(ip); DISPATCH();
+	op_sastore:          exec_sastore(ip); DISPATCH();
+	op_pop:              exec_pop(ip); DISPATCH();
+	op_pop2:             exec_pop2(ip); DISPATCH();
+	op_dup:              exec_dup(ip); DISPATCH();
+	op_dup_x1:           exec_dup_x1(ip); DISPATCH();
+	op_dup_x2:           exec_dup_x2(ip); DISPATCH();
+	op_dup2:             exec_dup2(ip); DISPATCH();
+	op_dup2_x1:          exec_dup2_x1(ip); DISPATCH();
+	op_dup2_x2:          exec_dup2_x2(ip); DISPATCH();
+	op_swap:             exec_swap(ip); DISPATCH();
+	op_iadd:             exec_iadd(ip); DISPATCH();
+	op_ladd:             exec_ladd(ip); DISPATCH();
+	op_fadd:             exec_fadd(ip); DISPATCH();
+	op_dadd:             exec_dadd(ip); DISPATCH();
+	op_isub:             exec_isub(ip); DISPATCH();
+	op_lsub:             exec_lsub(ip); DISPATCH();
+	op_fsub:             exec_fsub(ip); DISPATCH();
+	op_dsub:             exec_dsub(ip); DISPATCH();
+	op_imul:             exec_imul(ip); DISPATCH();
+	op_lmul:             exec_lmul(ip); DISPATCH();
+	op_fmul:             exec_fmul(ip); DISPATCH();
+	op_dmul:             exec_dmul(ip); DISPATCH();
+	op_idiv:             exec_idiv(ip); DISPATCH();
+	op_ldiv:             exec_ldiv(ip); DISPATCH();
+	op_fdiv:             exec_fdiv(ip); DISPATCH();
+	op_ddiv:             exec_ddiv(ip); DISPATCH();
+	op_irem:             exec_irem(ip); DISPATCH();
+	op_lrem:             exec_lrem(ip); DISPATCH();
+	op_frem:             exec_frem(ip); DISPATCH();
+	op_drem:             exec_drem(ip); DISPATCH();
+	op_ineg:             exec_ineg(ip); DISPATCH();
+	op_lneg:             exec_lneg(ip); DISPATCH();
+	op_fneg:             exec_fneg(ip); DISPATCH();
+	op_dneg:             exec_dneg(ip); DISPATCH();
+	op_ishl:             exec_ishl(ip); DISPATCH();
+	op_lshl:             exec_lshl(ip); DISPATCH();
+	op_ishr:             exec_ishr(ip); DISPATCH();
+	op_lshr:             exec_lshr(ip); DISPATCH();
+	op_iushr:            exec_iushr(ip); DISPATCH();
+	op_lushr:            exec_lushr(ip); DISPATCH();
+	op_iand:             exec_iand(ip); DISPATCH();
+	op_land:             exec_land(ip); DISPATCH();
+	op_ior:              exec_ior(ip); DISPATCH();
+	op_lor:              exec_lor(ip); DISPATCH();
+	op_ixor:             exec_ixor(ip); DISPATCH();
+	op_lxor:             exec_lxor(ip); DISPATCH();
+	op_iinc:             exec_iinc(ip); DISPATCH();
+	op_i2l:              exec_i2l(ip); DISPATCH();
+	op_i2f:              exec_i2f(ip); DISPATCH();
+	op_i2d:              exec_i2d(ip); DISPATCH();
+	op_l2i:              exec_l2i(ip); DISPATCH();
+	op_l2f:              exec_l2f(ip); DISPATCH();
+	op_l2d:              exec_l2d(ip); DISPATCH();
+	op_f2i:              exec_f2i(ip); DISPATCH();
+	op_f2l:              exec_f2l(ip); DISPATCH();
+	op_f2d:              exec_f2d(ip); DISPATCH();
+	op_d2i:              exec_d2i(ip); DISPATCH();
+	op_d2l:              exec_d2l(ip); DISPATCH();
+	op_d2f:              exec_d2f(ip); DISPATCH();
+	op_i2b:              exec_i2b(ip); DISPATCH();
+	op_i2c:              exec_i2c(ip); DISPATCH();
+	op_i2s:              exec_i2s(ip); DISPATCH();
+	op_lcmp:             exec_lcmp(ip); DISPATCH();
+	op_fcmpl:            exec_fcmpl(ip); DISPATCH();
+	op_fcmpg:            exec_fcmpg(ip); DISPATCH();
+	op_dcmpl:            exec_dcmpl(ip); DISPATCH();
+	op_dcmpg:            exec_dcmpg(ip); DISPATCH();
+	op_ifeq:             exec_ifeq(ip); DISPATCH();
+	op_ifne:             exec_ifne(ip); DISPATCH();
+	op_iflt:             exec_iflt(ip); DISPATCH();
+	op_ifge:             exec_ifge(ip); DISPATCH();
+	op_ifgt:             exec_ifgt(ip); DISPATCH();
+	op_ifle:             exec_ifle(ip); DISPATCH();
+	op_if_icmpeq:        exec_if_icmpeq(ip); DISPATCH();
+	op_if_icmpne:        exec_if_icmpne(ip); DISPATCH();
+	op_if_icmplt:        exec_if_icmplt(ip); DISPATCH();
+	op_if_icmpge:        exec_if_icmpge(ip); DISPATCH();
+	op_if_icmpgt:        exec_if_icmpgt(ip); DISPATCH();
+	op_if_icmple:        exec_if_icmple(ip); DISPATCH();
+	op_if_acmpeq:        exec_if_acmpeq(ip); DISPATCH();
+	op_if_acmpne:        exec_if_acmpne(ip); DISPATCH();
+	op_goto:             exec_goto(ip); DISPATCH();
+	op_jsr:              exec_jsr(ip); DISPATCH();
+	op_ret:              exec_ret(ip); DISPATCH();
+	op_tableswitch:      exec_tableswitch(ip); DISPATCH();
+	op_lookupswitch:     exec_lookupswitch(ip); DISPATCH();
+	op_ireturn:          exec_ireturn(ip); DISPATCH_RETURN();
+	op_lreturn:          exec_lreturn(ip); DISPATCH_RETURN();
+	op_freturn:          exec_freturn(ip); DISPATCH_RETURN();
+	op_dreturn:          exec_dreturn(ip); DISPATCH_RETURN();
+	op_areturn:          exec_areturn(ip); DISPATCH_RETURN();
+	op_return:           exec_return(ip); DISPATCH_RETURN();
+	op_getstatic:        exec_getstatic(ip); DISPATCH();
+	op_putstatic:        exec_putstatic(ip); DISPATCH();
+	op_getfield:         exec_getfield(ip); DISPATCH();
+	op_putfield:         exec_putfield(ip); DISPATCH();
+	op_invokevirtual:    exec_invokevirtual(ip); DISPATCH();
+	op_invokespecial:    exec_invokespecial(ip); DISPATCH();
+	op_invokestatic:     exec_invokestatic(ip); DISPATCH();
+	op_invokeinterface:  exec_invokeinterface(ip); DISPATCH();
+	op_invokedynamic:    exec_invokedynamic(ip); DISPATCH();
+	op_new:              exec_new(ip); DISPATCH();
+	op_newarray:         exec_newarray(ip); DISPATCH();
+	op_anewarray:        exec_anewarray(ip); DISPATCH();
+	op_arraylength:      exec_arraylength(ip); DISPATCH();
+	op_athrow:           exec_athrow(ip); DISPATCH();
+	op_checkcast:        exec_checkcast(ip); DISPATCH();
+	op_instanceof:       exec_instanceof(ip); DISPATCH();
+	op_monitorenter:     exec_monitorenter(ip); DISPATCH();
+	op_monitorexit:      exec_monitorexit(ip); DISPATCH();
+	op_wide:             exec_wide(ip); DISPATCH();
+	op_multianewarray:   exec_multianewarray(ip); DISPATCH();
+	op_ifnull:           exec_ifnull(ip); DISPATCH();
+	op_ifnonnull:        exec_ifnonnull(ip); DISPATCH();
+	op_goto_w:           exec_goto_w(ip); DISPATCH();
+	op_jsr_w:            exec_jsr_w(ip); DISPATCH();
+	op_breakpoint:       exec_breakpoint(ip); DISPATCH();
+	op_impdep1:          exec_impdep1(ip); DISPATCH();
+	op_impdep2:          exec_impdep2(ip); DISPATCH();
+	op_getstatic_quick:  exec_getstatic_quick(ip); DISPATCH();
+	op_putstatic_quick:  exec_putstatic_quick(ip); DISPATCH();
+	op_invokestatic_quick: exec_invokestatic_quick(ip); DISPATCH();
+	op_ldc_quick:        exec_ldc_quick(ip); DISPATCH();
+	op_ldc_string_quick: exec_ldc_string_quick(ip); DISPATCH();
+	op_ldc2_w_quick:     exec_ldc2_w_quick(ip); DISPATCH();
+	op_getfield_quick:   exec_getfield_quick(ip); DISPATCH();
+	op_putfield_quick:   exec_putfield_quick(ip); DISPATCH();
+	op_new_quick:        exec_new_quick(ip); DISPATCH();
+	op_invokevirtual_quick: exec_invokevirtual_quick(ip); DISPATCH();
+	op_invokespecial_quick: exec_invokespecial_quick(ip); DISPATCH();
+	op_invokenative_quick: exec_invokenative_quick(ip); DISPATCH();
+	op_new_builder_quick: exec_new_builder_quick(ip); DISPATCH();
+	op_multianewarray_quick: exec_multianewarray_quick(ip); DISPATCH();
+	op_iload_iload:      exec_iload_iload(ip); DISPATCH();
+	op_iload_iload_iadd_istore: exec_iload_iload_iadd_istore(ip); DISPATCH();
+	op_aload_iload_iaload: exec_aload_iload_iaload(ip); DISPATCH();
+	op_aload_iload_iload_iastore: exec_aload_iload_iload_iastore(ip); DISPATCH();
+	op_iload_iload_if_icmplt: exec_iload_iload_if_icmplt(ip); DISPATCH();
+	op_iload_iload_if_icmpge: exec_iload_iload_if_icmpge(ip); DISPATCH();
+	op_iload_iconst_if_icmplt: exec_iload_iconst_if_icmplt(ip); DISPATCH();
+	op_iload_iconst_if_icmpge: exec_iload_iconst_if_icmpge(ip); DISPATCH();
+	op_iinc_goto:        exec_iinc_goto(ip); DISPATCH();
+	op_iinc_iload_iload_if_icmplt: exec_iinc_iload_iload_if_icmplt(ip); DISPATCH();
+
+	op_invalid:
+		throw JvmException("Opcode with number " + std::to_string(ip->opcode) + " does not exist!");
+
+	finish:
+		return labels;
+
+		#undef DISPATCH
+		#undef DISPATCH_RETURN
+	}
+#endif
+
+	void Engine::link (ClassLoader &classLoader) {
+		Verifier::verify(classLoader);              // The engine trusts the operand types from here on
+		classLoader.runtime.build(classLoader.constant_pool);
+
+		classLoader.layout_fields(findSuper(classLoader)); // The library superclasses have no fields here
+		classLoader.apply_constant_values();
+		heap.setReferences(classLoader.runtime[classLoader.this_class].text, classLoader.reference_offsets);
+
+		if (registers) {                            // the register code runs the bytecodes it has no instruction for unfused
+			for (auto &pair : classLoader.methods) {
+				for (auto &codeAttr : pair.second.attributes.Codes) {
+					codeAttr->registers.translate(*codeAttr, classLoader.runtime);
+				}
+			}
+		} else if (not superinstructions.empty()) {
+			for (auto &pair : classLoader.methods) {
+				for (auto &codeAttr : pair.second.attributes.Codes) {
+					codeAttr->code.fuse(superinstructions);
+				}
+			}
+		}
+
+#ifdef JVM_THREADED_DISPATCH
+		for (auto &pair : classLoader.methods) {    // Thread the code of every method
+			for (auto &codeAttr : pair.second.attributes.Codes) {
+				for (auto &instruction : codeAttr->code) {
+					if (instruction.info != nullptr) {
+						instruction.handler = handlers[instruction.opcode];
+					}
+				}
+			}
+		}
+#endif
+	}
+
+	bool Engine::run_clinit (ClassLoader &classLoader) {
+		static const u8 clinit = Symbols::key(Symbols::intern("<clinit>"), Symbols::intern("()V"));
+
+		auto depth = fs.size();
+
+		// Single thread: marked before <clinit> runs, so its own uses of the class go through
+		for (auto klass = &classLoader; klass != nullptr && not klass->initialized; klass = findSuper(*klass)) {
+			klass->initialized = true;
+
+			for (auto &constant : klass->string_constants) { // the ConstantValue fields are set before <clinit> runs
+				auto ref = strings.literal(klass->runtime[constant.second]);
+				*reinterpret_cast<u4 *>(reinterpret_cast<u1 *>(klass->static_storage.data()) + constant.first) = ref;
+			}
+
+			auto method = klass->methods.find(clinit);
+			if (method != klass->methods.end() && not method->second.attributes.Codes.empty()) {
+				fs.push(*klass, method->second);
+			}
+		}
+
+		return fs.size() != depth;
 	}
 
 	void Engine::run_init () {
 		// Won't be needed
 	}
 
-	ClassAndMethod Engine::findMethod(CP_Methodref &ref) {
-		auto &currentClass = fs.top().cl;
-		auto &constantPool = currentClass.constant_pool;
+	ClassLoader *Engine::findSuper(ClassLoader &classLoader) {
+		if (classLoader.super_class == 0) {
+			return nullptr;
+		}
 
-		auto &classInfo = constantPool[ref.class_index] -> as<CP_Class>();
-		auto &nameAndType = constantPool[ref.name_and_type_index] -> as<CP_NameAndType>();
-		auto name = constantPool[nameAndType.name_index] -> toString(constantPool);
-		auto descriptor = constantPool[nameAndType.descriptor_index] -> toString(constantPool);
+		auto superName = classLoader.runtime[classLoader.super_class].text;
+		return Symbols::get(superName).find("java/") == 0 ? nullptr : &findClass(superName);
+	}
 
-		std::string methodKey = name + descriptor;
+	bool Engine::isAssignable(u4 klass, u4 type) {
+		static const u4 object = Symbols::intern("java/lang/Object");
+		// Supertypes of the library classes the natives create, besides java/lang/Object
+		static const std::multimap<u4, u4> library = {
+			{Symbols::intern("java/lang/String"), Symbols::intern("java/io/Serializable")},
+			{Symbols::intern("java/lang/String"), Symbols::intern("java/lang/CharSequence")},
+			{Symbols::intern("java/lang/String"), Symbols::intern("java/lang/Comparable")},
+			{Symbols::intern("java/lang/StringBuilder"), Symbols::intern("java/io/Serializable")},
+			{Symbols::intern("java/lang/StringBuilder"), Symbols::intern("java/lang/CharSequence")},
+			{Symbols::intern("java/lang/StringBuilder"), Symbols::intern("java/lang/Appendable")},
+		};
 
-		return findMethod(classInfo, methodKey);
-	}
+		if (klass == type || type == object) {
+			return true;
+		}
 
-	ClassAndMethod Engine::findMethod(CP_Class &classInfo, std::string &methodKey) {
-		auto &currentClass = fs.top().cl;
-		auto &constantPool = currentClass.constant_pool;
-		if (classInfo.toString(constantPool) == "java/lang/Object") {
-			throw JvmException("Method " + methodKey + " not found!");
+		const auto &name = Symbols::get(klass);
+		const auto &typeName = Symbols::get(type);
+		if (name[0] == '[') {
+			if (typeName[0] != '[') {
+				return typeName == "java/lang/Cloneable" || typeName == "java/io/Serializable";
+			}
+			// Arrays of references are assignable as their elements are, arrays of primitives only to themselves
+			auto element = name.substr(1);
+			auto typeElement = typeName.substr(1);
+			if ((element[0] != 'L' && element[0] != '[') || (typeElement[0] != 'L' && typeElement[0] != '[')) {
+				return false;
+			}
+			auto className = [](const std::string &descriptor) {
+				return descriptor[0] == 'L' ? descriptor.substr(1, descriptor.size() - 2) : descriptor;
+			};
+			return isAssignable(Symbols::intern(className(element)), Symbols::intern(className(typeElement)));
+		}
+		if (typeName[0] == '[') {
+			return false;
 		}
-		auto &methodClass = findClass(classInfo);
+
+		if (name.find("java/") == 0) {
+			auto supers = library.equal_range(klass);
+			for (auto super = supers.first; super != supers.second; super++) {
+				if (super->second == type) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		auto &classLoader = findClass(klass);
+		for (const auto &interface : classLoader.interfaces) {
+			if (isAssignable(classLoader.runtime[interface.info].text, type)) {
+				return true;
+			}
+		}
+		return classLoader.super_class != 0 && isAssignable(classLoader.runtime[classLoader.super_class].text, type);
+	}
+
+	void Engine::quicken(Instruction *data, u1 opcode) {
+		data->opcode = opcode;
+#ifdef JVM_THREADED_DISPATCH
+		data->handler = handlers[opcode];
+#endif
+	}
+
+	ClassAndMethod Engine::findMethod(ClassLoader &methodClass, u8 methodKey) {
+		static const u4 object = Symbols::intern("java/lang/Object");
+
 		auto pair = methodClass.methods.find(methodKey);
 
 		if (pair == methodClass.methods.end()) {
-			if (methodClass.super_class == 0) {
-				throw JvmException("Method " + methodKey + " not found!");
+			auto superName = methodClass.super_class == 0 ? object : methodClass.runtime[methodClass.super_class].text;
+			if (superName == object) {
+				return {nullptr, nullptr}; // java/lang/Object is not loaded, its methods are natives
+			}
+			return findMethod(findClass(superName), methodKey);
+		}
+
+		return {&methodClass, &pair->second};
+	}
+
+	void Engine::collectGarbage() {
+		static const u4 clinit = Symbols::intern("<clinit>");
+
+		heap.beginCollection();
+		strings.forwardRoots();
+		natives.forwardRoots();
+
+		for (auto &pair : JavaClasses) {
+			auto storage = reinterpret_cast<u1 *>(pair.second.static_storage.data());
+			for (auto offset : pair.second.static_reference_offsets) {
+				auto value = reinterpret_cast<u4 *>(storage + offset);
+				*value = heap.forward(*value);
+			}
+		}
+
+		for (auto frame = fs.begin(); frame != fs.end(); ++frame) {
+			// The callers wait on the invoke right before their PC, the top frame is on the allocation.
+			// A frame below a <clinit> waits on the instruction that started the initialization, still at its PC
+			auto pc = frame->PC;
+			auto callee = frame + 1;
+			if (callee != fs.end() && callee->cl.constant_pool[callee->mt.name_index]->as<CP_Utf8>().symbol != clinit) {
+				do pc--; while (frame->code[pc].info == nullptr);
+			}
+
+			auto map = frame->mt.gcMaps.find(pc);
+			if (map == frame->mt.gcMaps.end()) {
+				throw JvmException("InternalError: no GC map at " + std::to_string(pc));
+			}
+
+			auto &refs = map->second;
+			u4 locals = frame->mt.attributes.Codes[0]->max_locals;
+
+			for (u4 i = 0; i < locals; i++) {
+				if (refs[i]) {
+					frame->variables.set(i, heap.forward(frame->variables.get4(i).ui4));
+				}
+			}
+
+			auto operands = frame->operands.begin();
+			for (u4 i = 0; i < frame->operands.size() && locals + i < refs.size(); i++) {
+				if (refs[locals + i]) {
+					operands[i].ui4 = heap.forward(operands[i].ui4);
+				}
+			}
+		}
+
+		heap.endCollection();
+	}
+
+	CallSite &Engine::getCallSite(Instruction *data) {
+		static const u4 object = Symbols::intern("java/lang/Object");
+
+		if (data->cache != nullptr) {
+			return *static_cast<CallSite *>(data->cache);
+		}
+
+		auto &frame = fs.top();
+		auto &methodRef = frame.cl.runtime[data->index]; // get the method info from constant pool
+		auto classSymbol = frame.cl.runtime[methodRef.classIndex].text;
+		auto &className = Symbols::get(classSymbol);
+
+		CallSite site;
+		site.kind = CallSite::INVOKE;
+		site.native = nullptr;
+		site.nargs = static_cast<u2>(getArgumentsSize(Symbols::get(methodRef.descriptor)) + (data->opcode == 184 ? 0 : 1)); // and the receiver
+		site.receivers = 0;
+		site.methodKey = Symbols::key(methodRef.text, methodRef.descriptor);
+
+		// The natives are bound once, the call runs them without looking them up again.
+		// The virtual methods of java/lang/Object may be overridden, so they are looked up in the receiver classes
+		auto native = natives.find(classSymbol, methodRef.text, methodRef.descriptor);
+		if (data->opcode == 182 && classSymbol == object) {
+			site.receivers = 0;
+		} else if (native != nullptr) {
+			site.kind = CallSite::NATIVE;
+			site.native = native;
+		} else if (className.compare(0, 5, "java/") == 0) {
+			site.kind = CallSite::NATIVE;
+			site.native = Natives::ignore; // the library classes have no fields here, so nothing to initialize
+			if (Symbols::get(methodRef.text) != "<init>") {
+				site.native = natives.find(object, methodRef.text, methodRef.descriptor); // as the methods they inherit from java/lang/Object
+				if (site.native == nullptr) {
+					throw JvmException("UnsatisfiedLinkError: " + className + "." + Symbols::get(methodRef.text) + Symbols::get(methodRef.descriptor));
+				}
+			}
+		} else if (data->opcode == 185) { // interface methods are only looked up in the receiver classes
+			site.receivers = 0;
+		} else {
+			resolveClass(frame.cl, methodRef.classIndex);
+			bindReceiver(site, 0, classSymbol);
+			site.receivers = 1;
+
+			// Only a virtual call may reach an override of a method inherited from java/lang/Object
+			if (site.targetMethod[0] == nullptr && data->opcode != 182) {
+				site.kind = CallSite::NATIVE;
+				site.native = site.targetNative[0];
+			}
+		}
+
+		callSites.push_back(site);
+		data->cache = &callSites.back();
+
+		return callSites.back();
+	}
+
+	u1 Engine::lookupReceiver(CallSite &site, u4 receiver) {
+		for (u1 i = 0; i < site.receivers; i++) {
+			if (site.receiverClass[i] == receiver) {
+				return i;
+			}
+		}
+
+		// Miss: resolve for this receiver, replacing the last entry once the cache is full
+		u1 i = site.receivers < CallSite::MAX_RECEIVERS ? site.receivers : CallSite::MAX_RECEIVERS - 1;
+		bindReceiver(site, i, receiver);
+		if (i == site.receivers) {
+			site.receivers++;
+		}
+
+		return i;
+	}
+
+	void Engine::bindReceiver(CallSite &site, u1 i, u4 receiver) {
+		static const u4 object = Symbols::intern("java/lang/Object");
+
+		auto name = static_cast<u4>(site.methodKey >> 32), descriptor = static_cast<u4>(site.methodKey);
+		auto library = receiver;
+
+		if (Symbols::get(receiver).compare(0, 5, "java/") != 0) {
+			auto methodData = findMethod(findClass(receiver), site.methodKey);
+			if (methodData.method != nullptr) {
+				site.receiverClass[i] = receiver;
+				site.targetClass[i] = methodData.classLoader;
+				site.targetMethod[i] = methodData.method;
+				site.targetNative[i] = nullptr;
+				return;
+			}
+			library = object;
+		}
+
+		auto native = natives.find(library, name, descriptor);
+		if (native == nullptr && library != object) {
+			native = natives.find(object, name, descriptor);
+		}
+		if (native == nullptr) {
+			throw JvmException("UnsatisfiedLinkError: " + Symbols::get(library) + "." + Symbols::get(name) + Symbols::get(descriptor));
+		}
+
+		site.receiverClass[i] = receiver;
+		site.targetClass[i] = nullptr;
+		site.targetMethod[i] = nullptr;
+		site.targetNative[i] = native;
+	}
+
+	RuntimeEntry &Engine::resolveField(ClassLoader &classLoader, u2 index) {
+		auto &field = classLoader.runtime[index];
+
+		if (field.fieldType == 0) {
+			auto &fieldClass = resolveClass(classLoader, field.classIndex);
+			auto offset = fieldClass.field_offsets.find(Symbols::key(field.text, field.descriptor));
+			if (offset == fieldClass.field_offsets.end()) {
+				throw JvmException("NoSuchFieldError: " + Symbols::get(field.text));
+			}
+
+			field.offset = offset->second;
+			field.fieldType = Symbols::get(field.descriptor)[0];
+		}
+
+		return field;
+	}
+
+	RuntimeEntry &Engine::resolveStaticField(ClassLoader &classLoader, u2 index) {
+		auto &field = classLoader.runtime[index];
+
+		if (field.fieldType == 0) {
+			auto key = Symbols::key(field.text, field.descriptor);
+			auto fieldClass = findStaticField(resolveClass(classLoader, field.classIndex), key);
+			if (fieldClass == nullptr) {
+				throw JvmException("NoSuchFieldError: " + Symbols::get(field.text));
+			}
+
+			field.classLoader = fieldClass;
+			field.offset = fieldClass->static_offsets[key];
+			field.fieldType = Symbols::get(field.descriptor)[0];
+		}
+
+		return field;
+	}
+
+	ClassLoader *Engine::findStaticField(ClassLoader &classLoader, u8 fieldKey) {
+		if (classLoader.static_offsets.count(fieldKey) > 0) {
+			return &classLoader;
+		}
+
+		for (auto &interface : classLoader.interfaces) {
+			auto name = classLoader.runtime[interface.info].text;
+			if (Symbols::get(name).find("java/") != 0) {
+				auto fieldClass = findStaticField(findClass(name), fieldKey);
+				if (fieldClass != nullptr) {
+					return fieldClass;
+				}
 			}
-			auto& superClass = constantPool[methodClass.super_class]->as<CP_Class>();
-			return findMethod(superClass, methodKey);
 		}
 
-		return {methodClass, pair->second};
+		auto super = findSuper(classLoader);
+		return super == nullptr ? nullptr : findStaticField(*super, fieldKey);
 	}
 
-	ClassLoader & Engine::findClass(CP_Class &classInfo) {
-		auto &cl = fs.top().cl;
-		auto &cp = cl.constant_pool;
-		auto className = cp[classInfo.name_index]-> toString(cp);
-		return findClass(className);
+	ClassLoader &Engine::resolveClass(ClassLoader &classLoader, u2 index) {
+		auto &entry = classLoader.runtime[index];
+
+		if (entry.classLoader == nullptr) {
+			entry.classLoader = &findClass(entry.text);
+		}
+
+		return *entry.classLoader;
 	}
 
-	ClassLoader &Engine::findClass(std::string &className) {
+	ClassLoader &Engine::findClass(u4 className) {
 		if (JavaClasses.count(className) > 0) {  // If class was already loaded, return
 			return JavaClasses[className];
 		}
 
 		// Find the corresponding .class file and load
 
-		ClassLoader newClass;
+		auto &name = Symbols::get(className);
+		auto newClass = prefetcher.take(name);        // Already parsed by the prefetcher, if it is on
 
-		newClass.read(path + className + ".class"); // Load the correct class
-		JavaClasses.insert({ className, newClass }); // Add new class to the map
+		if (newClass == nullptr) {
+			newClass.reset(new ClassLoader());
+			newClass->read(path + name + ".class");  // Load the correct class
+		}
+
+		auto &loaded = JavaClasses.emplace(className, std::move(*newClass)).first->second; // Add new class to the map
 
-		return JavaClasses[className];
+		link(loaded);
+
+		return loaded;
 	}
 
 	u4 Engine::getArgumentsSize (std::string descriptor) {
@@ -377,7 +1481,7 @@ namespace jvm {
 					break;
 				case '[':
 					nargs++;
-					while(descriptor[++i] != '['); // jump description of how much dimentions it is
+					while(descriptor[++i] == '['); // jump description of how much dimentions it is
 					if (descriptor[i] == 'L') { // if array of type L
 						while(descriptor[++i] != ';');
 					}
@@ -395,14 +1499,12 @@ namespace jvm {
 		return nargs;
 	}
 
-	void Engine::exec_nop (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOnop *>(info); // get data in class
+	void Engine::exec_nop (Instruction * data) {
 		auto &frame = fs.top();
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_aconst_null (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOaconst_null *>(info); // get data in class
+	void Engine::exec_aconst_null (Instruction * data) {
 		auto &frame = fs.top();
 
 		op4 res { .ui4 = 0 };
@@ -411,8 +1513,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_iconst_m1 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOiconst_m1 *>(info); // get data in class
+	void Engine::exec_iconst_m1 (Instruction * data) {
 		auto &frame = fs.top();
 
 		op4 res = {.i4 = -1};
@@ -421,8 +1522,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_iconst_0 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOiconst_0 *>(info); // get data in class
+	void Engine::exec_iconst_0 (Instruction * data) {
 		auto &frame = fs.top();
 
 		op4 res { .ui4 = 0 };
@@ -431,8 +1531,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_iconst_1 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOiconst_1 *>(info); // get data in class
+	void Engine::exec_iconst_1 (Instruction * data) {
 		auto &frame = fs.top();
 
 		op4 res { .ui4 = 1 };
@@ -441,8 +1540,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_iconst_2 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOiconst_2 *>(info); // get data in class
+	void Engine::exec_iconst_2 (Instruction * data) {
 		auto &frame = fs.top();
 
 		op4 res { .ui4 = 2 };
@@ -451,8 +1549,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_iconst_3 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOiconst_3 *>(info); // get data in class
+	void Engine::exec_iconst_3 (Instruction * data) {
 		auto &frame = fs.top();
 
 		op4 res { .ui4 = 3 };
@@ -461,8 +1558,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_iconst_4 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOiconst_4 *>(info); // get data in class
+	void Engine::exec_iconst_4 (Instruction * data) {
 		auto &frame = fs.top();
 
 		op4 res { .ui4 = 4 };
@@ -471,8 +1567,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_iconst_5 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOiconst_5 *>(info); // get data in class
+	void Engine::exec_iconst_5 (Instruction * data) {
 		auto &frame = fs.top();
 
 		op4 res { .ui4 = 5 };
@@ -482,8 +1577,7 @@ namespace jvm {
 
 	}
 
-	void Engine::exec_lconst_0 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOlconst_0 *>(info); // get data in class
+	void Engine::exec_lconst_0 (Instruction * data) {
 		auto &frame = fs.top();
 
 		op8 res { .ull = 0 };
@@ -492,8 +1586,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_lconst_1 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOlconst_1 *>(info); // get data in class
+	void Engine::exec_lconst_1 (Instruction * data) {
 		auto &frame = fs.top();
 
 		op8 res { .ull = 1 };
@@ -502,32 +1595,28 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_fconst_0 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOfconst_0 *>(info); // get data in class
+	void Engine::exec_fconst_0 (Instruction * data) {
 		auto &frame = fs.top();
 		op4 res { .f = 0.0 };
 		frame.operands.push4(T_FLOAT, res);
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_fconst_1 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOfconst_1 *>(info); // get data in class
+	void Engine::exec_fconst_1 (Instruction * data) {
 		auto &frame = fs.top();
 		op4 res { .f = 1.0 };
 		frame.operands.push4(T_FLOAT, res);
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_fconst_2 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOfconst_2 *>(info); // get data in class
+	void Engine::exec_fconst_2 (Instruction * data) {
 		auto &frame = fs.top();
 		op4 res { .f = 2.0 };
 		frame.operands.push4(T_FLOAT, res);
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_dconst_0 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOdconst_0 *>(info); // get data in class
+	void Engine::exec_dconst_0 (Instruction * data) {
 		auto &frame = fs.top();
 
 		op8 res { .lf = 0.0 };
@@ -536,8 +1625,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_dconst_1 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOdconst_1 *>(info); // get data in class
+	void Engine::exec_dconst_1 (Instruction * data) {
 		auto &frame = fs.top();
 
 		op8 res { .lf = 1.0 };
@@ -546,111 +1634,89 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_bipush (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFObipush *>(info); // get data in class
+	void Engine::exec_bipush (Instruction * data) {
 		auto &frame = fs.top();
-		op4 res { .i1 = data->byte };
+		op4 res { .i4 = data->value };
 
 		frame.operands.push4(T_INT, res);
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_sipush (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOsipush *>(info); // get data in class
+	void Engine::exec_sipush (Instruction * data) {
 		auto &frame = fs.top();
-		op4 res { .i2 = data->value };
+		op4 res { .i4 = data->value };
 
 		frame.operands.push4(T_INT, res);
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_ldc (InstructionInfo * info) {
-	    auto data = reinterpret_cast<OPINFOldc *>(info); // get data in class
-	    auto &frame = fs.top();
-	    auto k = frame.cl.constant_pool[data->index];
-	    if (k->getTag() == Integer /* Integer */) {
-		    auto int_cp = k->as<CP_Integer>();
-		    op4 value{ .ui4 = int_cp._bytes };
-		    frame.operands.push4(T_INT, value);
-			frame.PC += data->jmp + 1;
-			return;
-	    } else if (k->getTag() == Float /* Float */) {
-		    auto float_cp = k->as<CP_Float>();
-		    op4 value{ .ui4 = float_cp._bytes };
-		    frame.operands.push4(T_FLOAT, value);
-			frame.PC += data->jmp + 1;
-			return;
-	    } else if (k->getTag() == String /* String */) {
-		    auto cp_str = k->as<CP_String>();
-			frame.operands.push4(T_STRING, cp_str.string_index );
-			frame.PC += data->jmp + 1;
-			return;
-	    }
-		throw JvmException("Error on ldc!");
-	}
-
-
-	// TODO: remove this frame.PC repeated
-	void Engine::exec_ldc_w (InstructionInfo * info) {
-		auto data = reinterpret_cast<OPINFOldc *>(info); // get data in class
+	void Engine::exec_ldc (Instruction * data) {
 		auto &frame = fs.top();
-		auto k = frame.cl.constant_pool[data->index];
-		if (k->getTag() == Integer /* Integer */) {
-			auto int_cp = k->as<CP_Integer>();
-			op4 value{ .ui4 = int_cp._bytes };
-			frame.operands.push4(T_INT, value);
-			frame.PC += data->jmp + 1;
-			return;
-		} else if (k->getTag() == Float /* Float */) {
-			auto float_cp = k->as<CP_Float>();
-			op4 value{ .ui4 = float_cp._bytes };
-			frame.operands.push4(T_FLOAT, value);
-			frame.PC += data->jmp + 1;
-			return;
-		} else if (k->getTag() == String /* String */) {
-			auto cp_str = k->as<CP_String>();
-			frame.operands.push4(T_STRING, cp_str.string_index);
-		}else{
-			throw JvmException("Error in ldc_w");
+		auto &k = frame.cl.runtime[data->index];
+
+		// The constant is resolved once, the quick forms push it without reading the pool again
+		switch (k.tag) {
+			case CP_TAGS::Integer:
+			case CP_TAGS::Float:
+				data->value = static_cast<i4>(k.value.ull);
+				data->type = k.tag == CP_TAGS::Integer ? 'I' : 'F';
+				quicken(data, LDC_QUICK);
+				exec_ldc_quick(data);
+				break;
+			case CP_TAGS::String:
+				data->value = static_cast<i4>(strings.literalIndex(k)); // interned the first time
+				quicken(data, LDC_STRING_QUICK);
+				exec_ldc_string_quick(data);
+				break;
+			default:
+				throw JvmException("Error on ldc!");
 		}
+	}
 
+	void Engine::exec_ldc_quick (Instruction * data) {
+		auto &frame = fs.top();
+		frame.operands.push4(data->type == 'F' ? T_FLOAT : T_INT, static_cast<u4>(data->value));
 		frame.PC += data->jmp + 1;
-
 	}
-	void Engine::exec_ldc2_w (InstructionInfo * info) {
 
-		auto data = reinterpret_cast<OPINFOldc *>(info); // get data in class
+	void Engine::exec_ldc_string_quick (Instruction * data) {
 		auto &frame = fs.top();
-		auto k = frame.cl.constant_pool[data->index];
+		frame.operands.push4(T_REF, strings.pooled(static_cast<u4>(data->value))); // the collector may move the string, not its place in the pool
+		frame.PC += data->jmp + 1;
+	}
 
-		if (k->getTag() == Long) {
-			auto long_cp = k->as<CP_Long>();
-			op4 value1 {.ui4 = static_cast<u4>(long_cp.low_bytes)};
-			op4 value2 {.ui4 = static_cast<u4>(long_cp.high_bytes)};
+	void Engine::exec_ldc_w (Instruction * data) {
+		exec_ldc(data); // the index was already decoded wide
+	}
 
-			auto res = Converter::to_op8(value1, value2);
-			frame.operands.push8(T_LONG, res);
-		} else if (k->getTag() == Double) {
-			auto double_cp = k->as<CP_Double>();
-			op4 value1 { .ui4 = static_cast<u4>(double_cp.low_bytes) };
-			op4 value2 { .ui4 = static_cast<u4>(double_cp.high_bytes) };
+	void Engine::exec_ldc2_w (Instruction * data) {
+		auto &frame = fs.top();
+		auto &k = frame.cl.runtime[data->index];
 
-			auto res = Converter::to_op8(value1, value2);
-			frame.operands.push8(T_DOUBLE, res);
+		if (k.tag != CP_TAGS::Long && k.tag != CP_TAGS::Double) {
+			throw JvmException("Error on ldc2_w!");
 		}
 
+		data->cache = &k.value;
+		data->type = k.tag == CP_TAGS::Long ? 'J' : 'D';
+		quicken(data, LDC2_W_QUICK);
+		exec_ldc2_w_quick(data);
+	}
+
+	void Engine::exec_ldc2_w_quick (Instruction * data) {
+		auto &frame = fs.top();
+		frame.operands.push8(data->type == 'D' ? T_DOUBLE : T_LONG, *static_cast<op8 *>(data->cache));
 		frame.PC += data->jmp + 1;
 	}
-	void Engine::exec_iload (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOiload *>(info); // get data in class
+
+	void Engine::exec_iload (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.variables.get4(data->index);
 		frame.operands.push4(T_INT, value);
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_lload (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOlload *>(info); // get data in class
+	void Engine::exec_lload (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.variables.get8(data->index);
 
@@ -658,24 +1724,21 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_fload (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOfload *>(info); // get data in class
+	void Engine::exec_fload (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.variables.get4(data->index);
 
 		frame.operands.push4(T_FLOAT, value);
 		frame.PC += data->jmp + 1;
 	}
-	void Engine::exec_dload (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOdload *>(info); // get data in class
+	void Engine::exec_dload (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.variables.get8(data->index);
 
 		frame.operands.push8(T_DOUBLE, value);
 		frame.PC += data->jmp + 1;
 	}
-	void Engine::exec_aload (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOaload *>(info); // get data in class
+	void Engine::exec_aload (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.variables.get4(data->index);
 
@@ -683,8 +1746,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_iload_0 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOiload_0 *>(info); // get data in class
+	void Engine::exec_iload_0 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.variables.get4(0);
 
@@ -692,8 +1754,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_iload_1 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOiload_1 *>(info); // get data in class
+	void Engine::exec_iload_1 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.variables.get4(1);
 
@@ -701,8 +1762,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_iload_2 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOiload_2 *>(info); // get data in class
+	void Engine::exec_iload_2 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.variables.get4(2);
 
@@ -710,8 +1770,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_iload_3 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOiload_3 *>(info); // get data in class
+	void Engine::exec_iload_3 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.variables.get4(3);
 
@@ -719,8 +1778,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_lload_0 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOlload_0 *>(info); // get data in class
+	void Engine::exec_lload_0 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.variables.get8(0);
 
@@ -728,119 +1786,105 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_lload_1 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOlload_1 *>(info); // get data in class
+	void Engine::exec_lload_1 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.variables.get8(1);
 		frame.operands.push8(T_LONG, value);
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_lload_2 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOlload_2 *>(info); // get data in class
+	void Engine::exec_lload_2 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.variables.get8(2);
 		frame.operands.push8(T_LONG, value);
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_lload_3 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOlload_3 *>(info); // get data in class
+	void Engine::exec_lload_3 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.variables.get8(3);
 		frame.operands.push8(T_LONG, value);
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_fload_0 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOfload_0 *>(info); // get data in class
+	void Engine::exec_fload_0 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.variables.get4(0);
 		frame.operands.push4(T_FLOAT, value);
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_fload_1 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOfload_1 *>(info); // get data in class
+	void Engine::exec_fload_1 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.variables.get4(1);
 		frame.operands.push4(T_FLOAT, value);
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_fload_2 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOfload_2 *>(info); // get data in class
+	void Engine::exec_fload_2 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.variables.get4(2);
 		frame.operands.push4(T_FLOAT, value);
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_fload_3 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOfload_3 *>(info); // get data in class
+	void Engine::exec_fload_3 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.variables.get4(3);
 		frame.operands.push4(T_FLOAT, value);
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_dload_0 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOdload_0 *>(info); // get data in class
+	void Engine::exec_dload_0 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.variables.get8(0);
 		frame.operands.push8(T_DOUBLE, value);
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_dload_1 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOdload_1 *>(info); // get data in class
+	void Engine::exec_dload_1 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.variables.get8(1);
 		frame.operands.push8(T_DOUBLE, value);
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_dload_2 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOdload_2 *>(info); // get data in class
+	void Engine::exec_dload_2 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.variables.get8(2);
 		frame.operands.push8(T_DOUBLE, value);
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_dload_3 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOdload_3 *>(info); // get data in class
+	void Engine::exec_dload_3 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.variables.get8(3);
 		frame.operands.push8(T_DOUBLE, value);
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_aload_0 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOaload_0 *>(info); // get data in class
+	void Engine::exec_aload_0 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.variables.get4(0);
 		frame.operands.push4(T_ARRAY, value);
+		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_aload_1 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOaload_1 *>(info); // get data in class
+	void Engine::exec_aload_1 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.variables.get4(1);
 		frame.operands.push4(T_ARRAY, value);
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_aload_2 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOaload_2 *>(info); // get data in class
+	void Engine::exec_aload_2 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.variables.get4(2);
 		frame.operands.push4(T_ARRAY, value);
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_aload_3 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOaload_3 *>(info); // get data in class
+	void Engine::exec_aload_3 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.variables.get4(3);
 		frame.operands.push4(T_ARRAY, value);
@@ -848,126 +1892,103 @@ namespace jvm {
 
 	}
 
-	void Engine::exec_iaload (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOiaload *>(info); // get data in class
-		auto &frame = fs.top();
-		auto val2 = frame.operands.pop4();
-		auto val1 = frame.operands.pop4();
+	template <typename T>
+	T *Engine::arrayElement(u4 arrayref, i4 index) {
+		if (arrayref == 0) {
+			throw JvmException("NullPointerException");
+		}
 
-		frame.PC += data->jmp + 1;
+		auto length = heap.get(arrayref)->length;
+		if (static_cast<u4>(index) >= length) { // negative indexes wrap above any length
+			throw JvmException("ArrayIndexOutOfBoundsException: Index " + std::to_string(index) + " out of bounds for length " + std::to_string(length));
+		}
 
+		return heap.data<T>(arrayref) + index;
 	}
-	// TODO VERIFY THIS INSTRUCTION
-	void Engine::exec_laload (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOlaload *>(info); // get data in class
+
+	void Engine::exec_iaload (Instruction * data) {
 		auto &frame = fs.top();
 		auto index = frame.operands.pop4();
 		auto arrayref = frame.operands.pop4();
-		long * ARP = static_cast<long*>(mem[arrayref.value.i4]);
-		op8 value;
-		value.lf = ARP[index.value.i4];
-		frame.operands.push8(T_LONG, value.ll);
+
+		frame.operands.push4(T_INT, *arrayElement<u4>(arrayref.value.ui4, index.value.i4));
 		frame.PC += data->jmp + 1;
 	}
-	// TODO VERIFY THIS INSTRUCTION
-	void Engine::exec_faload (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOfaload *>(info); // get data in class
+
+	void Engine::exec_laload (Instruction * data) {
 		auto &frame = fs.top();
 		auto index = frame.operands.pop4();
-		auto arrareyref = frame.operands.pop4();
-		float * ARP = static_cast<float*>(mem[arrareyref.value.i4]);
-		op4 value;
-		value.f = ARP[index.value.i4];
-		frame.operands.push4(T_FLOAT, value.f);
-		frame.PC += data->jmp + 1;
+		auto arrayref = frame.operands.pop4();
 
-		// throw JvmException("Not Implemented!");
+		frame.operands.push8(T_LONG, *arrayElement<u8>(arrayref.value.ui4, index.value.i4));
+		frame.PC += data->jmp + 1;
 	}
 
-	// TODO VERIFY THIS INSTRUCTION
-	void Engine::exec_daload (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOdaload *>(info); // get data in class
+	void Engine::exec_faload (Instruction * data) {
 		auto &frame = fs.top();
 		auto index = frame.operands.pop4();
-		auto arrareyref = frame.operands.pop4();
-		double * ARP = static_cast<double*>(mem[arrareyref.value.i4]);
-		op8 value;
-		value.lf = ARP[index.value.i4];
-		frame.operands.push8(T_DOUBLE, value.lf);
+		auto arrayref = frame.operands.pop4();
 
+		frame.operands.push4(T_FLOAT, *arrayElement<u4>(arrayref.value.ui4, index.value.i4)); // the bits of the float
 		frame.PC += data->jmp + 1;
-
-		// throw JvmException("Not Implemented!");
 	}
 
-	// TODO VERIFY THIS INSTRUCTION
-	void Engine::exec_aaload (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOaaload *>(info); // get data in class
+	void Engine::exec_daload (Instruction * data) {
 		auto &frame = fs.top();
 		auto index = frame.operands.pop4();
-		auto arreyref = frame.operands.pop4();
-		uint32_t * ARP = static_cast<uint32_t*>(mem[arreyref.value.i4]);
-		op4 value;
-		value.ui4 = static_cast<uint32_t >(ARP[index.value.i4]);
-		frame.operands.push4(T_ARRAY, value.ui4);
-		frame.PC += data->jmp + 1;
+		auto arrayref = frame.operands.pop4();
 
-		// throw JvmException("Not Implemented!");
+		frame.operands.push8(T_DOUBLE, *arrayElement<u8>(arrayref.value.ui4, index.value.i4)); // the bits of the double
+		frame.PC += data->jmp + 1;
 	}
 
-	// TODO: finish this function
-	void Engine::exec_baload (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFObaload *>(info); // get data in class
+	void Engine::exec_aaload (Instruction * data) {
 		auto &frame = fs.top();
 		auto index = frame.operands.pop4();
 		auto arrayref = frame.operands.pop4();
-		uint8_t * ARP = static_cast<uint8_t*>(mem[arrayref.value.i4]);
-		op4 value;
-		value.ui1 = static_cast<uint8_t>(ARP[index.value.i4]);
-		frame.operands.push4(T_BYTE, value);
-		frame.PC += data->jmp + 1;
 
-		// throw JvmException("Not Implemented!");
+		frame.operands.push4(T_REF, *arrayElement<u4>(arrayref.value.ui4, index.value.i4));
+		frame.PC += data->jmp + 1;
 	}
 
-	// TODO: finish this function
-	void Engine::exec_caload (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOcaload *>(info); // get data in class
+	void Engine::exec_baload (Instruction * data) {
 		auto &frame = fs.top();
 		auto index = frame.operands.pop4();
 		auto arrayref = frame.operands.pop4();
-		uint8_t * ARP = static_cast<uint8_t*>(mem[arrayref.value.i4]);
-		op4 value;
-		value.ui1 = static_cast<uint8_t>(ARP[index.value.i4]);
-		frame.operands.push4(T_BYTE, value);
-		frame.PC += data->jmp + 1;
 
-		// throw JvmException("Not Implemented!");
+		// byte and boolean arrays, sign extended
+		frame.operands.push4(T_INT, static_cast<u4>(*arrayElement<i1>(arrayref.value.ui4, index.value.i4)));
+		frame.PC += data->jmp + 1;
 	}
-	// TODO VERIFY THIS INSTRUCTION
-	void Engine::exec_saload (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOsaload *>(info); // get data in class
+
+	void Engine::exec_caload (Instruction * data) {
 		auto &frame = fs.top();
 		auto index = frame.operands.pop4();
 		auto arrayref = frame.operands.pop4();
-		int16_t * ARP = static_cast<int16_t *>(mem[arrayref.value.i4]);
-		op4 value;
-		value.i2 = static_cast<int16_t>(ARP[index.value.i4]);
-		frame.operands.push4(T_LONG, value.i2);
+
+		// zero extended
+		frame.operands.push4(T_INT, static_cast<u4>(*arrayElement<u2>(arrayref.value.ui4, index.value.i4)));
 		frame.PC += data->jmp + 1;
+	}
 
-		// throw JvmException("Not Implemented!");
+	void Engine::exec_saload (Instruction * data) {
+		auto &frame = fs.top();
+		auto index = frame.operands.pop4();
+		auto arrayref = frame.operands.pop4();
+
+		// sign extended
+		frame.operands.push4(T_INT, static_cast<u4>(*arrayElement<i2>(arrayref.value.ui4, index.value.i4)));
+		frame.PC += data->jmp + 1;
 	}
-	void Engine::exec_istore (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOistore *>(info); // get data in class
+
+	void Engine::exec_istore (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop4();
 		frame.variables.set(data->index, value.value);
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_lstore (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOlstore *>(info); // get data in class
+	void Engine::exec_lstore (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop8();
 
@@ -975,8 +1996,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_fstore (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOfstore *>(info); // get data in class
+	void Engine::exec_fstore (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop4();
 
@@ -984,8 +2004,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_dstore (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOdstore *>(info); // get data in class
+	void Engine::exec_dstore (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop8();
 
@@ -993,8 +2012,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_astore (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOastore *>(info); // get data in class
+	void Engine::exec_astore (Instruction * data) {
 		auto &frame = fs.top();
 		auto objectref = frame.operands.pop4();
 
@@ -1002,8 +2020,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_istore_0 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOistore_0 *>(info); // get data in class
+	void Engine::exec_istore_0 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop4();
 
@@ -1011,8 +2028,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_istore_1 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOistore_1 *>(info); // get data in class
+	void Engine::exec_istore_1 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop4();
 
@@ -1020,8 +2036,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_istore_2 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOistore_2 *>(info); // get data in class
+	void Engine::exec_istore_2 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop4();
 
@@ -1029,8 +2044,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_istore_3 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOistore_3 *>(info); // get data in class
+	void Engine::exec_istore_3 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop4();
 
@@ -1038,8 +2052,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_lstore_0 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOlstore_0 *>(info); // get data in class
+	void Engine::exec_lstore_0 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop8();
 
@@ -1047,8 +2060,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_lstore_1 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOlstore_1 *>(info); // get data in class
+	void Engine::exec_lstore_1 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop8();
 
@@ -1056,8 +2068,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_lstore_2 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOlstore_2 *>(info); // get data in class
+	void Engine::exec_lstore_2 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop8();
 
@@ -1065,8 +2076,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_lstore_3 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOlstore_3 *>(info); // get data in class
+	void Engine::exec_lstore_3 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop8();
 
@@ -1074,8 +2084,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_fstore_0 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOfstore_0 *>(info); // get data in class
+	void Engine::exec_fstore_0 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop4();
 
@@ -1083,8 +2092,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_fstore_1 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOfstore_1 *>(info); // get data in class
+	void Engine::exec_fstore_1 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop4();
 
@@ -1092,8 +2100,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_fstore_2 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOfstore_2 *>(info); // get data in class
+	void Engine::exec_fstore_2 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop4();
 
@@ -1101,8 +2108,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_fstore_3 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOfstore_3 *>(info); // get data in class
+	void Engine::exec_fstore_3 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop4();
 
@@ -1110,8 +2116,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_dstore_0 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOdstore_0 *>(info); // get data in class
+	void Engine::exec_dstore_0 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop8();
 
@@ -1119,8 +2124,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_dstore_1 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOdstore_2 *>(info); // get data in class
+	void Engine::exec_dstore_1 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop8();
 
@@ -1128,8 +2132,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_dstore_2 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOdstore_2 *>(info); // get data in class
+	void Engine::exec_dstore_2 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop8();
 
@@ -1137,8 +2140,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_dstore_3 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOdstore_3 *>(info); // get data in class
+	void Engine::exec_dstore_3 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop8();
 
@@ -1146,8 +2148,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_astore_0 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOastore_0 *>(info); // get data in class
+	void Engine::exec_astore_0 (Instruction * data) {
 		auto &frame = fs.top();
 		auto objectref = frame.operands.pop4();
 
@@ -1155,8 +2156,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_astore_1 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOastore_1 *>(info); // get data in class
+	void Engine::exec_astore_1 (Instruction * data) {
 		auto &frame = fs.top();
 		auto objectref = frame.operands.pop4();
 
@@ -1164,8 +2164,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_astore_2 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOastore_2 *>(info); // get data in class
+	void Engine::exec_astore_2 (Instruction * data) {
 		auto &frame = fs.top();
 		auto objectref = frame.operands.pop4();
 
@@ -1173,8 +2172,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_astore_3 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOastore_3 *>(info); // get data in class
+	void Engine::exec_astore_3 (Instruction * data) {
 		auto &frame = fs.top();
 		auto objectref = frame.operands.pop4();
 
@@ -1182,112 +2180,105 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_iastore (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOiastore *>(info); // get data in class
+	void Engine::exec_iastore (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop4();
 		auto index = frame.operands.pop4();
 		auto arrayref = frame.operands.pop4();
 
-		frame.variables.set(index.value.ui2,value.value);
+		*arrayElement<u4>(arrayref.value.ui4, index.value.i4) = value.value.ui4;
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_lastore (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOlastore *>(info); // get data in class
+	void Engine::exec_lastore (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop8();
 		auto index = frame.operands.pop4();
 		auto arrayref = frame.operands.pop4();
 
-		frame.variables.set(index.value.ui2, value.value);
+		*arrayElement<u8>(arrayref.value.ui4, index.value.i4) = value.value.ull;
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_fastore (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOfastore *>(info); // get data in class
+	void Engine::exec_fastore (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop4();
 		auto index = frame.operands.pop4();
 		auto arrayref = frame.operands.pop4();
 
-		frame.variables.set(index.value.ui2,value.value);
+		*arrayElement<u4>(arrayref.value.ui4, index.value.i4) = value.value.ui4; // the bits of the float
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_dastore (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOdastore *>(info); // get data in class
+	void Engine::exec_dastore (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop8();
 		auto index = frame.operands.pop4();
 		auto arrayref = frame.operands.pop4();
 
-		frame.variables.set(index.value.ui2,value.value);
+		*arrayElement<u8>(arrayref.value.ui4, index.value.i4) = value.value.ull; // the bits of the double
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_aastore (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOaastore *>(info); // get data in class
+	void Engine::exec_aastore (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop4();
 		auto index = frame.operands.pop4();
 		auto arrayref = frame.operands.pop4();
 
-		frame.variables.set(index.value.i2,value.value);
+		auto element = arrayElement<u4>(arrayref.value.ui4, index.value.i4);
+		*element = value.value.ui4;
+		heap.markCard(element); // the array may be old and the value young
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_bastore (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFObastore *>(info); // get data in class
+	void Engine::exec_bastore (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop4();
 		auto index = frame.operands.pop4();
 		auto arrayref = frame.operands.pop4();
 
-		frame.variables.set(index.value.i2,value.value);
+		auto element = arrayElement<u1>(arrayref.value.ui4, index.value.i4);
+		// boolean arrays keep only the lowest bit
+		*element = static_cast<u1>(heap.get(arrayref.value.ui4)->elementType == T_BOOL ? value.value.ui4 & 1 : value.value.ui4);
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_castore (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOcastore *>(info); // get data in class
+	void Engine::exec_castore (Instruction * data) {
 		auto &frame = fs.top();
-		auto index = frame.operands.pop4();
 		auto value = frame.operands.pop4();
+		auto index = frame.operands.pop4();
 		auto arrayref = frame.operands.pop4();
 
-		frame.variables.set(index.value.i2,value.value);
+		*arrayElement<u2>(arrayref.value.ui4, index.value.i4) = static_cast<u2>(value.value.ui4);
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_sastore (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOsastore *>(info); // get data in class
+	void Engine::exec_sastore (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop4();
 		auto index = frame.operands.pop4();
 		auto arrayref = frame.operands.pop4();
 
-		frame.variables.set(index.value.i2,value.value);
+		*arrayElement<u2>(arrayref.value.ui4, index.value.i4) = static_cast<u2>(value.value.ui4);
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_pop (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOpop *>(info); // get data in class
+	void Engine::exec_pop (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop4();
 
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_pop2 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOpop2 *>(info); // get data in class
+	void Engine::exec_pop2 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop8();
 
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_dup (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOdup *>(info); // get data in class
+	void Engine::exec_dup (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop4();
 
@@ -1299,8 +2290,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_dup_x1 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOdup_x1 *>(info); // get data in class
+	void Engine::exec_dup_x1 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value1 = frame.operands.pop4();
 		auto value2 = frame.operands.pop4();
@@ -1316,8 +2306,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_dup_x2 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOdup_x2 *>(info); // get data in class
+	void Engine::exec_dup_x2 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value1 = frame.operands.pop4();
 		auto value2 = frame.operands.pop8();
@@ -1328,8 +2317,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_dup2 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOdup2 *>(info); // get data in class
+	void Engine::exec_dup2 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop8();
 
@@ -1338,8 +2326,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_dup2_x1 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOdup2_x1 *>(info); // get data in class
+	void Engine::exec_dup2_x1 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value1 = frame.operands.pop8();
 		auto value2 = frame.operands.pop4();
@@ -1350,8 +2337,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_dup2_x2 (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOdup2_x2 *>(info); // get data in class
+	void Engine::exec_dup2_x2 (Instruction * data) {
 		auto &frame = fs.top();
 		auto value1 = frame.operands.pop8();
 		auto value2 = frame.operands.pop8();
@@ -1362,8 +2348,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_swap (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOswap *>(info); // get data in class
+	void Engine::exec_swap (Instruction * data) {
 		auto &frame = fs.top();
 		auto value1 = frame.operands.pop4();
 		auto value2 = frame.operands.pop4();
@@ -1373,8 +2358,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_iadd (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOiadd *>(info); // get data in class
+	void Engine::exec_iadd (Instruction * data) {
 		auto &frame = fs.top();
 		auto value1 = frame.operands.pop4();
 		auto value2 = frame.operands.pop4();
@@ -1385,8 +2369,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_ladd (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOladd *>(info); // get data in class
+	void Engine::exec_ladd (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop8();
 		auto value1 = frame.operands.pop8();
@@ -1397,8 +2380,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_fadd (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOfadd *>(info); // get data in class
+	void Engine::exec_fadd (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop4();
 		auto value1 = frame.operands.pop4();
@@ -1409,8 +2391,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_dadd (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOdadd *>(info); // get data in class
+	void Engine::exec_dadd (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop8();
 		auto value1 = frame.operands.pop8();
@@ -1421,8 +2402,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_isub (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOisub *>(info); // get data in class
+	void Engine::exec_isub (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop4();
 		auto value1 = frame.operands.pop4();
@@ -1433,8 +2413,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_lsub (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOlsub *>(info); // get data in class
+	void Engine::exec_lsub (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop8();
 		auto value1 = frame.operands.pop8();
@@ -1445,8 +2424,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_fsub (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOfsub *>(info); // get data in class
+	void Engine::exec_fsub (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop4();
 		auto value1 = frame.operands.pop4();
@@ -1457,8 +2435,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_dsub (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOdsub *>(info); // get data in class
+	void Engine::exec_dsub (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop8();
 		auto value1 = frame.operands.pop8();
@@ -1469,8 +2446,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_imul (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOimul *>(info); // get data in class
+	void Engine::exec_imul (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop4();
 		auto value1 = frame.operands.pop4();
@@ -1481,8 +2457,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_lmul (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOlmul *>(info); // get data in class
+	void Engine::exec_lmul (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop8();
 		auto value1 = frame.operands.pop8();
@@ -1493,8 +2468,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_fmul (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOfmul *>(info); // get data in class
+	void Engine::exec_fmul (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop4();
 		auto value1 = frame.operands.pop4();
@@ -1505,8 +2479,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_dmul (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOdmul *>(info); // get data in class
+	void Engine::exec_dmul (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop8();
 		auto value1 = frame.operands.pop8();
@@ -1517,8 +2490,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_idiv (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOidiv *>(info); // get data in class
+	void Engine::exec_idiv (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop4();
 		auto value1 = frame.operands.pop4();
@@ -1533,8 +2505,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_ldiv (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOldiv *>(info); // get data in class
+	void Engine::exec_ldiv (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop8();
 		auto value1 = frame.operands.pop8();
@@ -1549,8 +2520,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_fdiv (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOfdiv *>(info); // get data in class
+	void Engine::exec_fdiv (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop4();
 		auto value1 = frame.operands.pop4();
@@ -1565,8 +2535,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_ddiv (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOddiv *>(info); // get data in class
+	void Engine::exec_ddiv (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop8();
 		auto value1 = frame.operands.pop8();
@@ -1581,8 +2550,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_irem (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOirem *>(info); // get data in class
+	void Engine::exec_irem (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop4();
 		auto value1 = frame.operands.pop4();
@@ -1597,8 +2565,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_lrem (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOlrem *>(info); // get data in class
+	void Engine::exec_lrem (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop8();
 		auto value1 = frame.operands.pop8();
@@ -1613,8 +2580,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_frem (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOfrem *>(info); // get data in class
+	void Engine::exec_frem (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop4();
 		auto value1 = frame.operands.pop4();
@@ -1629,8 +2595,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_drem (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOdrem *>(info); // get data in class
+	void Engine::exec_drem (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop8();
 		auto value1 = frame.operands.pop8();
@@ -1645,8 +2610,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_ineg (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOineg *>(info); // get data in class
+	void Engine::exec_ineg (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop4();
 
@@ -1656,8 +2620,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_lneg (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOlneg *>(info); // get data in class
+	void Engine::exec_lneg (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop8();
 
@@ -1667,8 +2630,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_fneg (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOfneg *>(info); // get data in class
+	void Engine::exec_fneg (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop4();
 
@@ -1678,8 +2640,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_dneg (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOdneg *>(info); // get data in class
+	void Engine::exec_dneg (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop8();
 
@@ -1689,8 +2650,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_ishl (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOishl *>(info); // get data in class
+	void Engine::exec_ishl (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop4();
 		auto value1 = frame.operands.pop4();
@@ -1702,8 +2662,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_lshl (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOlshl *>(info); // get data in class
+	void Engine::exec_lshl (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop4();
 		auto value1 = frame.operands.pop8();
@@ -1715,8 +2674,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_ishr (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOishr *>(info); // get data in class
+	void Engine::exec_ishr (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop4();
 		auto value1 = frame.operands.pop4();
@@ -1728,8 +2686,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_lshr (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOlshr *>(info); // get data in class
+	void Engine::exec_lshr (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop4();
 		auto value1 = frame.operands.pop8();
@@ -1741,8 +2698,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_iushr (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOiushr *>(info); // get data in class
+	void Engine::exec_iushr (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop4();
 		auto value1 = frame.operands.pop4();
@@ -1759,8 +2715,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_lushr (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOlushr *>(info); // get data in class
+	void Engine::exec_lushr (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop4();
 		auto value1 = frame.operands.pop8();
@@ -1777,8 +2732,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_iand (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOiand *>(info); // get data in class
+	void Engine::exec_iand (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop4();
 		auto value1 = frame.operands.pop4();
@@ -1789,8 +2743,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_land (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOland *>(info); // get data in class
+	void Engine::exec_land (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop8();
 		auto value1 = frame.operands.pop8();
@@ -1801,8 +2754,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_ior (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOior *>(info); // get data in class
+	void Engine::exec_ior (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop4();
 		auto value1 = frame.operands.pop4();
@@ -1814,8 +2766,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_lor (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOlor *>(info); // get data in class
+	void Engine::exec_lor (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop8();
 		auto value1 = frame.operands.pop8();
@@ -1827,8 +2778,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_ixor (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOixor *>(info); // get data in class
+	void Engine::exec_ixor (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop4();
 		auto value1 = frame.operands.pop4();
@@ -1839,8 +2789,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_lxor (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOlxor *>(info); // get data in class
+	void Engine::exec_lxor (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop8();
 		auto value1 = frame.operands.pop8();
@@ -1851,19 +2800,17 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_iinc (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOiinc *>(info); // get data in class
+	void Engine::exec_iinc (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.variables.get4(data->index);
 
-		value.i4 += data->constant;
+		value.i4 += data->value;
 
 		frame.variables.set(data->index,value.ui4);
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_i2l (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOi2l *>(info); // get data in class
+	void Engine::exec_i2l (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop4();
 
@@ -1875,8 +2822,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_i2f (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOi2f *>(info); // get data in class
+	void Engine::exec_i2f (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop4();
 
@@ -1888,8 +2834,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_i2d (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOi2d *>(info); // get data in class
+	void Engine::exec_i2d (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop4();
 
@@ -1901,8 +2846,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_l2i (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOl2i *>(info); // get data in class
+	void Engine::exec_l2i (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop8();
 
@@ -1914,8 +2858,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_l2f (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOl2f *>(info); // get data in class
+	void Engine::exec_l2f (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop8();
 
@@ -1927,8 +2870,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_l2d (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOl2d *>(info); // get data in class
+	void Engine::exec_l2d (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop8();
 
@@ -1940,8 +2882,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_f2i (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOf2i *>(info); // get data in class
+	void Engine::exec_f2i (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop4();
 
@@ -1953,8 +2894,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_f2l (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOf2l *>(info); // get data in class
+	void Engine::exec_f2l (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop4();
 
@@ -1966,8 +2906,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_f2d (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOf2d *>(info); // get data in class
+	void Engine::exec_f2d (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop4();
 
@@ -1979,8 +2918,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_d2i (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOd2i *>(info); // get data in class
+	void Engine::exec_d2i (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop8();
 
@@ -1992,8 +2930,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_d2l (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOd2l *>(info); // get data in class
+	void Engine::exec_d2l (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop8();
 
@@ -2006,8 +2943,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_d2f (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOd2f *>(info); // get data in class
+	void Engine::exec_d2f (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop8();
 
@@ -2019,8 +2955,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_i2b (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOi2b *>(info); // get data in class
+	void Engine::exec_i2b (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop4();
 
@@ -2032,8 +2967,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_i2c (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOi2c *>(info); // get data in class
+	void Engine::exec_i2c (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop4();
 
@@ -2045,8 +2979,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_i2s (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOi2s *>(info); // get data in class
+	void Engine::exec_i2s (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop4();
 
@@ -2058,8 +2991,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_lcmp (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOlcmp *>(info); // get data in class
+	void Engine::exec_lcmp (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop8();
 		auto value1 = frame.operands.pop8();
@@ -2082,8 +3014,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_fcmpl (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOfcmpl *>(info); // get data in class
+	void Engine::exec_fcmpl (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop4();
 		auto value1 = frame.operands.pop4();
@@ -2108,8 +3039,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_fcmpg (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOfcmpg *>(info); // get data in class
+	void Engine::exec_fcmpg (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop4();
 		auto value1 = frame.operands.pop4();
@@ -2134,8 +3064,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_dcmpl (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOdcmpl *>(info); // get data in class
+	void Engine::exec_dcmpl (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop8();
 		auto value1 = frame.operands.pop8();
@@ -2160,8 +3089,7 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_dcmpg (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOdcmpg *>(info); // get data in class
+	void Engine::exec_dcmpg (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop8();
 		auto value1 = frame.operands.pop8();
@@ -2186,92 +3114,85 @@ namespace jvm {
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_ifeq (InstructionInfo * info) {
-		auto data = reinterpret_cast<OPINFOifeq *>(info); // get data in class
+	void Engine::exec_ifeq (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop4();
 
 		assert(value.type == T_INT);
 
 		if (value.value.i4 == 0) {
-			frame.PC += data->branchoffset; // Execution then proceeds at that offset from the address of the opcode of this if<cond> instruction.
+			frame.PC = data->target; // Execution then proceeds at that offset from the address of the opcode of this if<cond> instruction.
 		} else {
 			frame.PC += data->jmp + 1;
 		}
 	}
 
-	void Engine::exec_ifne (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOifne *>(info); // get data in class
+	void Engine::exec_ifne (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop4();
 
 		assert(value.type == T_INT);
 
 		if (value.value.i4 != 0) {
-			frame.PC += data->branchoffset; // Execution then proceeds at that offset from the address of the opcode of this if<cond> instruction.
+			frame.PC = data->target; // Execution then proceeds at that offset from the address of the opcode of this if<cond> instruction.
 		} else {
 			frame.PC += data->jmp + 1;
 		}
 	}
 
-	void Engine::exec_iflt (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOiflt *>(info); // get data in class
+	void Engine::exec_iflt (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop4();
 
 		assert(value.type == T_INT);
 
 		if (value.value.i4 < 0) {
-			frame.PC += data->branchoffset; // Execution then proceeds at that offset from the address of the opcode of this if<cond> instruction.
+			frame.PC = data->target; // Execution then proceeds at that offset from the address of the opcode of this if<cond> instruction.
 		} else {
 			frame.PC += data->jmp + 1;
 		}
 	}
 
-	void Engine::exec_ifge (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOifge *>(info); // get data in class
+	void Engine::exec_ifge (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop4();
 
 		assert(value.type == T_INT);
 
 		if (value.value.i4 >= 0) {
-			frame.PC += data->branchoffset; // Execution then proceeds at that offset from the address of the opcode of this if<cond> instruction.
+			frame.PC = data->target; // Execution then proceeds at that offset from the address of the opcode of this if<cond> instruction.
 		} else {
 			frame.PC += data->jmp + 1;
 		}
 	}
 
-	void Engine::exec_ifgt (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOifgt *>(info); // get data in class
+	void Engine::exec_ifgt (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop4();
 
 		assert(value.type == T_INT);
 
 		if (value.value.i4 > 0) {
-			frame.PC += data->branchoffset;
+			frame.PC = data->target;
 		} else {
 			frame.PC += data->jmp + 1;
 		}
 	}
 
-	void Engine::exec_ifle (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOifle *>(info); // get data in class
+	void Engine::exec_ifle (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop4();
 
 		assert(value.type == T_INT);
 
 		if (value.value.i4 <= 0) {
-			frame.PC += data->branchoffset; // Execution then proceeds at that offset from the address of the opcode of this if<cond> instruction.
+			frame.PC = data->target; // Execution then proceeds at that offset from the address of the opcode of this if<cond> instruction.
 		} else {
 			frame.PC += data->jmp + 1;
 		}
 	}
 
-	void Engine::exec_if_icmpeq (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOif_icmpeq *>(info); // get data in class
+	void Engine::exec_if_icmpeq (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop4();
 		auto value1 = frame.operands.pop4();
@@ -2280,14 +3201,13 @@ namespace jvm {
 		assert(value2.type == T_INT);
 
 		if (value1.value.i4 == value2.value.i4) {
-			frame.PC += data->branchoffset;
+			frame.PC = data->target;
 		} else {
 			frame.PC += data->jmp + 1;
 		}
 	}
 
-	void Engine::exec_if_icmpne (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOif_icmpne *>(info); // get data in class
+	void Engine::exec_if_icmpne (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop4();
 		auto value1 = frame.operands.pop4();
@@ -2296,14 +3216,13 @@ namespace jvm {
 		assert(value2.type == T_INT);
 
 		if (value1.value.i4 != value2.value.i4) {
-			frame.PC += data->branchoffset;
+			frame.PC = data->target;
 		} else {
 			frame.PC += data->jmp + 1;
 		}
 	}
 
-	void Engine::exec_if_icmplt (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOif_icmplt *>(info); // get data in class
+	void Engine::exec_if_icmplt (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop4();
 		auto value1 = frame.operands.pop4();
@@ -2312,14 +3231,13 @@ namespace jvm {
 		assert(value2.type == T_INT);
 
 		if (value1.value.i4 < value2.value.i4) {
-			frame.PC += data->branchoffset;
+			frame.PC = data->target;
 		} else {
 			frame.PC += data->jmp + 1;
 		}
 	}
 
-	void Engine::exec_if_icmpge (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOif_icmpge *>(info); // get data in class
+	void Engine::exec_if_icmpge (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop4();
 		auto value1 = frame.operands.pop4();
@@ -2328,14 +3246,13 @@ namespace jvm {
 		assert(value2.type == T_INT);
 
 		if (value1.value.i4 >= value2.value.i4) {
-			frame.PC += data->branchoffset;
+			frame.PC = data->target;
 		} else {
 			frame.PC += data->jmp + 1;
 		}
 	}
 
-	void Engine::exec_if_icmpgt (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOif_icmpgt *>(info); // get data in class
+	void Engine::exec_if_icmpgt (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop4();
 		auto value1 = frame.operands.pop4();
@@ -2344,14 +3261,13 @@ namespace jvm {
 		assert(value2.type == T_INT);
 
 		if (value1.value.i4 > value2.value.i4) {
-			frame.PC += data->branchoffset;
+			frame.PC = data->target;
 		} else {
 			frame.PC += data->jmp + 1;
 		}
 	}
 
-	void Engine::exec_if_icmple (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOif_icmple *>(info); // get data in class
+	void Engine::exec_if_icmple (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop4();
 		auto value1 = frame.operands.pop4();
@@ -2360,14 +3276,13 @@ namespace jvm {
 		assert(value2.type == T_INT);
 
 		if (value1.value.i4 <= value2.value.i4) {
-			frame.PC += data->branchoffset;
+			frame.PC = data->target;
 		} else {
 			frame.PC += data->jmp + 1;
 		}
 	}
 
-	void Engine::exec_if_acmpeq (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOif_acmpeq *>(info); // get data in class
+	void Engine::exec_if_acmpeq (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop4();
 		auto value1 = frame.operands.pop4();
@@ -2376,14 +3291,13 @@ namespace jvm {
 		assert(value2.type == T_REF);
 
 		if (value1.value.ui4 == value2.value.ui4) {
-			frame.PC += data->branchoffset;
+			frame.PC = data->target;
 		} else {
 			frame.PC += data->jmp + 1;
 		}
 	}
 
-	void Engine::exec_if_acmpne (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOif_acmpne *>(info); // get data in class
+	void Engine::exec_if_acmpne (Instruction * data) {
 		auto &frame = fs.top();
 		auto value2 = frame.operands.pop4();
 		auto value1 = frame.operands.pop4();
@@ -2392,30 +3306,24 @@ namespace jvm {
 		assert(value2.type == T_REF);
 
 		if (value1.value.ui4 != value2.value.ui4) {
-			frame.PC += data->branchoffset;
+			frame.PC = data->target;
 		} else {
 			frame.PC += data->jmp + 1;
 		}
 	}
 
-	void Engine::exec_goto (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOgoto *>(info); // get data in class
+	void Engine::exec_goto (Instruction * data) {
 		auto &frame = fs.top();
-		auto newPC = static_cast<i4>(frame.PC) + data->branchoffset;
-		frame.PC = static_cast<u4>(newPC);
+		frame.PC = data->target;
 	}
 
-	void Engine::exec_jsr (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOjsr *>(info); // get data in class
+	void Engine::exec_jsr (Instruction * data) {
 		auto &frame = fs.top();
-		auto newPC = static_cast<i4>(frame.PC) + data->branchoffset;
-
 		frame.operands.push4(T_RET, frame.PC + data->jmp + 1); // insert address of the next instruction as type ReturnAddress
-		frame.PC = static_cast<u4>(newPC); // jump to procedure
+		frame.PC = data->target; // jump to procedure
 	}
 
-	void Engine::exec_ret (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOret *>(info); // get data in class
+	void Engine::exec_ret (Instruction * data) {
 		auto &frame = fs.top();
 		auto newPC  = frame.variables.get4(data->index); // remove the next PC of type returnAddress
 
@@ -2424,42 +3332,42 @@ namespace jvm {
 		frame.PC = newPC.ui4;
 	}
 
-	void Engine::exec_tableswitch (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOtableswitch *>(info); // get data in class
+	void Engine::exec_tableswitch (Instruction * data) {
+		auto table  = static_cast<OPINFOtableswitch *>(data->info); // get the jump table
 		auto &frame = fs.top();
 		auto value = frame.operands.pop4(); // get index
 
 		assert(value.type == T_INT);
 
-		if (value.value.i4 < data->low || value.value.i4 > data->high) {
-			frame.PC += data->defaultbyte;
+		if (value.value.i4 < table->low || value.value.i4 > table->high) {
+			frame.PC = data->target;
+		} else {
+			frame.PC += table->jumpOffsets[value.value.i4 - table->low];
 		}
-
-		frame.PC += data->jumpOffsets[value.value.i4 - data->low];
 	}
 
-	void Engine::exec_lookupswitch (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOlookupswitch *>(info); // get data in class
+	void Engine::exec_lookupswitch (Instruction * data) {
+		auto table  = static_cast<OPINFOlookupswitch *>(data->info); // get the match-offset pairs
 		auto &frame = fs.top();
 		auto value = frame.operands.pop4(); // get key
 
+		auto pair = table->pairs.find(value.value.i4);
+
 		assert(value.type == T_INT);
 
-		if (data->pairs.count(value.value.i4) > 0) {
-			frame.PC += data->pairs[value.value.i4];
+		if (pair != table->pairs.end()) {
+			frame.PC += pair->second;
 		} else {
-			frame.PC += data->defaultbyte;
+			frame.PC = data->target;
 		}
 	}
 
-	void Engine::exec_ireturn (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOireturn *>(info); // get data in class
+	void Engine::exec_ireturn (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop4(); // return value
 
 		assert(value.type == T_INT);
 
-		while (!frame.operands.empty()) frame.operands.pop(); // empty operand stack
 		fs.pop();
 
 		auto &frameInvoker = fs.top();
@@ -2468,14 +3376,12 @@ namespace jvm {
 
 	}
 
-	void Engine::exec_lreturn (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOlreturn *>(info); // get data in class
+	void Engine::exec_lreturn (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop8(); // return value
 
 		assert(value.type == T_LONG);
 
-		while (!frame.operands.empty()) frame.operands.pop(); // empty operand stack
 		fs.pop();
 
 		auto &frameInvoker = fs.top();
@@ -2483,14 +3389,12 @@ namespace jvm {
 		frameInvoker.operands.push8(T_LONG, value.value);
 	}
 
-	void Engine::exec_freturn (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOfreturn *>(info); // get data in class
+	void Engine::exec_freturn (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop4(); // return value
 
 		assert(value.type == T_FLOAT);
 
-		while (!frame.operands.empty()) frame.operands.pop(); // empty operand stack
 		fs.pop();
 
 		auto &frameInvoker = fs.top();
@@ -2498,14 +3402,12 @@ namespace jvm {
 		frameInvoker.operands.push4(T_FLOAT, value.value);
 	}
 
-	void Engine::exec_dreturn (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOdreturn *>(info); // get data in class
+	void Engine::exec_dreturn (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop8(); // return value
 
 		assert(value.type == T_DOUBLE);
 
-		while (!frame.operands.empty()) frame.operands.pop(); // empty operand stack
 		fs.pop();
 
 		auto &frameInvoker = fs.top();
@@ -2513,14 +3415,12 @@ namespace jvm {
 		frameInvoker.operands.push8(T_DOUBLE, value.value);
 	}
 
-	void Engine::exec_areturn (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOareturn *>(info); // get data in class
+	void Engine::exec_areturn (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop4(); // return value
 
 		assert(value.type == T_REF);
 
-		while (!frame.operands.empty()) frame.operands.pop(); // empty operand stack
 		fs.pop();
 
 		auto &frameInvoker = fs.top();
@@ -2528,351 +3428,531 @@ namespace jvm {
 		frameInvoker.operands.push4(T_REF, value.value);
 	}
 
-	void Engine::exec_return (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOreturn *>(info); // get data in class
-		auto &frame = fs.top();
-
-		while (!frame.operands.empty()) frame.operands.pop(); // empty operand stack
+	void Engine::exec_return (Instruction * data) {
 		fs.pop();
 	}
 
-	// TODO: finish this function
-	void Engine::exec_getstatic (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOgetstatic *>(info); // get data in class
-		auto &frame = fs.top();
-		auto value = reinterpret_cast<CP_Fieldref*>(frame.cl.constant_pool[data->index]);
-		auto classname = frame.cl.constant_pool[value->class_index]->toString(frame.cl.constant_pool);
-		auto name_type = reinterpret_cast<CP_NameAndType*>(frame.cl.constant_pool[value->name_and_type_index]);
-		auto name = frame.cl.constant_pool[name_type->name_index]->toString(frame.cl.constant_pool);
-		auto descriptor = frame.cl.constant_pool[name_type->descriptor_index]->toString(frame.cl.constant_pool);
-		auto signature = name + descriptor;
-
-		//Ignoring print to stream
-		if (classname == "java/lang/System" && signature == "outLjava/io/PrintStream;") {
-			frame.PC += data->jmp + 1;
+	void Engine::exec_getstatic (Instruction * data) {
+		auto &frame = fs.top();
+		auto &fieldRef = frame.cl.runtime[data->index];
+
+		// The static fields of the library classes are registered with the natives
+		auto value = natives.findField(frame.cl.runtime[fieldRef.classIndex].text, fieldRef.text);
+		if (value != nullptr) {
+			data->cache = value;
+			data->value = static_cast<u1>(Symbols::get(fieldRef.descriptor)[0]);
+			quicken(data, GETSTATIC_QUICK);
+			exec_getstatic_quick(data);
 			return;
 		}
 
-		frame.PC += data->jmp + 1;
+		auto &field = resolveStaticField(frame.cl, data->index);
+		if (run_clinit(*field.classLoader)) {
+			return; // runs again once <clinit> returns
+		}
 
-		// throw JvmException("Not Implemented!");
+		data->cache = reinterpret_cast<u1 *>(field.classLoader->static_storage.data()) + field.offset;
+		data->value = field.fieldType;
+		quicken(data, GETSTATIC_QUICK);
+		exec_getstatic_quick(data);
 	}
 
-	// TODO: finish this function
-	void Engine::exec_putstatic (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOputstatic *>(info); // get data in class
+	void Engine::exec_putstatic (Instruction * data) {
 		auto &frame = fs.top();
+		auto &field = resolveStaticField(frame.cl, data->index);
 
+		if (run_clinit(*field.classLoader)) {
+			return; // runs again once <clinit> returns
+		}
 
-		frame.PC += data->jmp + 1;
+		data->cache = reinterpret_cast<u1 *>(field.classLoader->static_storage.data()) + field.offset;
+		data->value = field.fieldType;
+		quicken(data, PUTSTATIC_QUICK);
+		exec_putstatic_quick(data);
+	}
 
-		// throw JvmException("Not Implemented!");
+	void Engine::exec_getstatic_quick (Instruction * data) {
+		auto &frame = fs.top();
+		auto value = static_cast<u1 *>(data->cache);
+
+		switch (data->value) {
+			case 'Z': frame.operands.push4(T_INT, static_cast<u4>(*value)); break;
+			case 'B': frame.operands.push4(T_INT, static_cast<u4>(*reinterpret_cast<i1 *>(value))); break;
+			case 'C': frame.operands.push4(T_INT, static_cast<u4>(*reinterpret_cast<u2 *>(value))); break;
+			case 'S': frame.operands.push4(T_INT, static_cast<u4>(*reinterpret_cast<i2 *>(value))); break;
+			case 'I': frame.operands.push4(T_INT, *reinterpret_cast<u4 *>(value)); break;
+			case 'F': frame.operands.push4(T_FLOAT, *reinterpret_cast<u4 *>(value)); break;
+			case 'L': frame.operands.push4(T_REF, *reinterpret_cast<u4 *>(value)); break;
+			case '[': frame.operands.push4(T_ARRAY, *reinterpret_cast<u4 *>(value)); break;
+			case 'J': frame.operands.push8(T_LONG, *reinterpret_cast<u8 *>(value)); break;
+			case 'D': frame.operands.push8(T_DOUBLE, *reinterpret_cast<u8 *>(value)); break;
+		}
+
+		frame.PC += data->jmp + 1;
 	}
 
-	// TODO: finish this function
-	void Engine::exec_getfield (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOgetfield *>(info); // get data in class
+	void Engine::exec_putstatic_quick (Instruction * data) {
 		auto &frame = fs.top();
+		auto slot = static_cast<u1 *>(data->cache);
+
+		// The static fields are roots of the collector, storing a reference needs no barrier
+		switch (data->value) {
+			case 'Z': case 'B': *slot = static_cast<u1>(frame.operands.pop4().value.ui4); break;
+			case 'C': case 'S': *reinterpret_cast<u2 *>(slot) = static_cast<u2>(frame.operands.pop4().value.ui4); break;
+			case 'J': case 'D': *reinterpret_cast<u8 *>(slot) = frame.operands.pop8().value.ull; break;
+			default:            *reinterpret_cast<u4 *>(slot) = frame.operands.pop4().value.ui4; break;
+		}
 
 		frame.PC += data->jmp + 1;
+	}
 
-		// throw JvmException("Not Implemented!");
+	void Engine::exec_getfield (Instruction * data) {
+		auto &frame = fs.top();
+		auto &field = resolveField(frame.cl, data->index);
+
+		data->value = static_cast<i4>(field.offset);
+		data->type = field.fieldType;
+		quicken(data, GETFIELD_QUICK);
+		exec_getfield_quick(data);
 	}
 
-	// TODO: finish this function
-	void Engine::exec_putfield (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOputfield *>(info); // get data in class
+	void Engine::exec_getfield_quick (Instruction * data) {
 		auto &frame = fs.top();
+		auto objectref = frame.operands.pop4().value.ui4;
 
-		frame.PC += data->jmp + 1;
+		if (objectref == 0) {
+			throw JvmException("NullPointerException");
+		}
 
-		// throw JvmException("Not Implemented!");
+		auto value = heap.data<u1>(objectref) + data->value;
+
+		switch (data->type) {
+			case 'Z': frame.operands.push4(T_INT, static_cast<u4>(*value)); break;
+			case 'B': frame.operands.push4(T_INT, static_cast<u4>(*reinterpret_cast<i1 *>(value))); break;
+			case 'C': frame.operands.push4(T_INT, static_cast<u4>(*reinterpret_cast<u2 *>(value))); break;
+			case 'S': frame.operands.push4(T_INT, static_cast<u4>(*reinterpret_cast<i2 *>(value))); break;
+			case 'I': frame.operands.push4(T_INT, *reinterpret_cast<u4 *>(value)); break;
+			case 'F': frame.operands.push4(T_FLOAT, *reinterpret_cast<u4 *>(value)); break;
+			case 'L': frame.operands.push4(T_REF, *reinterpret_cast<u4 *>(value)); break;
+			case '[': frame.operands.push4(T_ARRAY, *reinterpret_cast<u4 *>(value)); break;
+			case 'J': frame.operands.push8(T_LONG, *reinterpret_cast<u8 *>(value)); break;
+			case 'D': frame.operands.push8(T_DOUBLE, *reinterpret_cast<u8 *>(value)); break;
+		}
+
+		frame.PC += data->jmp + 1;
 	}
 
-	// TODO: finish this function
-	void Engine::exec_invokevirtual (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOinvokestatic *>(info); // get data in class
+	void Engine::exec_putfield (Instruction * data) {
 		auto &frame = fs.top();
-		auto &cp = frame.cl.constant_pool;
+		auto &field = resolveField(frame.cl, data->index);
 
-		auto methodRef = reinterpret_cast<CP_Methodref*>(cp[data->index]); // get the method info from constant pool
-		auto &classInfo = cp[methodRef->class_index]->as<CP_Class>();
-		auto className = cp[classInfo.name_index]->toString(cp);
-		auto &methodNameAndType = cp[methodRef->name_and_type_index]->as<CP_NameAndType>();
-		auto methodName = cp[methodNameAndType.name_index] -> toString(cp);
-		auto methodDescriptor = cp[methodNameAndType.descriptor_index] -> toString(cp);
-
-		if (methodName == "println" && className == "java/io/PrintStream") {
-			auto to_print = frame.operands.pop4();
-			auto print_type = to_print.type;
-			auto print_value = to_print.value;
-			double db;
-
-			long lng;
-			if(print_type == T_STRING){
-				std::string str = reinterpret_cast<CP_String *>(cp[print_value.ui4])->toString(cp);
-				std::cout << str << std::endl;
-			}
+		data->value = static_cast<i4>(field.offset);
+		data->type = field.fieldType;
+		quicken(data, PUTFIELD_QUICK);
+		exec_putfield_quick(data);
+	}
 
-			if(print_type == T_DOUBLE){
-				auto aux = Converter::to_op8(frame.operands.pop4().value, to_print.value);
-				db = aux.lf;
-			}
+	void Engine::exec_putfield_quick (Instruction * data) {
+		auto &frame = fs.top();
+		auto wide = data->type == 'J' || data->type == 'D';
+		auto value = wide ? frame.operands.pop8().value : op8 { .ull = frame.operands.pop4().value.ui4 };
+		auto objectref = frame.operands.pop4().value.ui4;
 
-			if(print_type == T_LONG){
-				auto aux = Converter::to_op8(frame.operands.pop4().value, to_print.value);
-				lng = aux.ll;
-			}
-			switch(print_type) {
-				case T_INT:
-					std::cout << print_value.i4 << std::endl;
-					break;
-				case T_FLOAT:
-					std::cout << print_value.f << std::endl;
-					break;
-				case T_BOOL:
-					if(print_value.ui1 == 1)
-						std::cout << "true"<< std::endl;
-					else if(print_value.ui1 == 0)
-						std::cout << "false"<< std::endl;
-					break;
-				case T_STRING:
-					break;
-				case T_DOUBLE:
-					std::cout << db << std::endl;
-					break;
-				case T_LONG:
-					std::cout << lng << std::endl;
-					break;
-				default:
-					throw JvmException("Type not recognized");
-			}
-			frame.PC += data->jmp + 1;
-			return;
+		if (objectref == 0) {
+			throw JvmException("NullPointerException");
 		}
 
-		if (methodName == "registerNatives" && className == "java/lang/Object") { // ignore registerNatives
-			frame.PC += data->jmp + 1;
-			return;
+		auto slot = heap.data<u1>(objectref) + data->value;
+
+		switch (data->type) {
+			case 'Z': case 'B': *slot = static_cast<u1>(value.ull); break;
+			case 'C': case 'S': *reinterpret_cast<u2 *>(slot) = static_cast<u2>(value.ull); break;
+			case 'I': case 'F': *reinterpret_cast<u4 *>(slot) = static_cast<u4>(value.ull); break;
+			case 'J': case 'D': *reinterpret_cast<u8 *>(slot) = value.ull; break;
+			case 'L': case '[':
+				*reinterpret_cast<u4 *>(slot) = static_cast<u4>(value.ull);
+				heap.markCard(slot); // the object may be old and the value young
+				break;
 		}
 
-		if (className.find("java/") == 0) { // calling something that start with java/, this should not happen
-			throw JvmException("Invalid call to" + className);
+		frame.PC += data->jmp + 1;
+	}
+
+	void Engine::exec_invokevirtual (Instruction * data) {
+		auto &site = getCallSite(data);
+
+		if (site.kind == CallSite::NATIVE) {
+			quicken(data, INVOKENATIVE_QUICK);
+			exec_invokenative_quick(data);
+		} else {
+			quicken(data, INVOKEVIRTUAL_QUICK);
+			exec_invokevirtual_quick(data);
 		}
+	}
 
-		auto methodData = findMethod(*methodRef);
+	void Engine::exec_invokevirtual_quick (Instruction * data) {
+		static const u4 arrayClass = Symbols::intern("java/lang/Object");
 
-		Frame newFrame(methodData.classLoader, methodData.method);
+		auto &frame = fs.top();
+		auto &site = *static_cast<CallSite *>(data->cache);
+		auto objectref = (frame.operands.end() - site.nargs)->ui4; // the receiver is below the arguments
 
-		auto nargs = getArgumentsSize(methodDescriptor);
-		std::stack<op4> args;
-		for (u2 i = 0; i < nargs; i++) {
-			auto value = frame.operands.pop4();
-			args.push(value.value);
+		if (objectref == 0) {
+			throw JvmException("NullPointerException");
 		}
 
-		for (u2 i = 0; i < nargs; i++) {
-			auto value = args.top(); args.pop();
-			newFrame.variables.set(i, value);
+		auto object = heap.get(objectref);
+		auto receiver = object->kind == T_ARRAY ? arrayClass : object->klass; // the arrays have the methods of java/lang/Object
+		auto i = site.receivers > 0 && site.receiverClass[0] == receiver ? 0 : lookupReceiver(site, receiver);
+		if (site.targetMethod[i] == nullptr) { // a library class or a method of java/lang/Object
+			NativeArgs args(frame.operands, site.nargs);
+			site.targetNative[i](natives, args);
+		} else {
+			fs.push(*site.targetClass[i], *site.targetMethod[i], site.nargs); // The arguments on the stack become the callee locals
 		}
-
-		fs.push(newFrame);
-
 		frame.PC += data->jmp + 1;
-		// throw JvmException("Not Implemented!");
 	}
 
-	// TODO: finish this function
-	void Engine::exec_invokespecial (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOinvokespecial *>(info); // get data in class
+	void Engine::exec_invokenative_quick (Instruction * data) {
 		auto &frame = fs.top();
+		auto &site = *static_cast<CallSite *>(data->cache);
 
+		NativeArgs args(frame.operands, site.nargs);
+		site.native(natives, args);
 		frame.PC += data->jmp + 1;
+	}
 
-		// throw JvmException("Not Implemented!");
+	void Engine::exec_invokespecial (Instruction * data) {
+		auto &site = getCallSite(data);
+
+		if (site.kind == CallSite::NATIVE) {
+			quicken(data, INVOKENATIVE_QUICK);
+			exec_invokenative_quick(data);
+		} else {
+			quicken(data, INVOKESPECIAL_QUICK);
+			exec_invokespecial_quick(data);
+		}
 	}
 
-	// TODO: verify corretude
-	void Engine::exec_invokestatic (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOinvokestatic *>(info); // get data in class
+	void Engine::exec_invokespecial_quick (Instruction * data) {
 		auto &frame = fs.top();
-		auto &cp = frame.cl.constant_pool;
+		auto &site = *static_cast<CallSite *>(data->cache);
 
-		auto methodRef = reinterpret_cast<CP_Methodref*>(cp[data->index]); // get the method info from constant pool
-		auto &classInfo = cp[methodRef->class_index]->as<CP_Class>();
-		auto className = cp[classInfo.name_index]->toString(cp);
-		auto &methodNameAndType = cp[methodRef->name_and_type_index]->as<CP_NameAndType>();
-		auto methodName = cp[methodNameAndType.name_index] -> toString(cp);
-		auto methodDescriptor = cp[methodNameAndType.descriptor_index] -> toString(cp);
+		fs.push(*site.targetClass[0], *site.targetMethod[0], site.nargs); // constructors, private and superclass methods do not depend on the receiver
+		frame.PC += data->jmp + 1;
+	}
 
-		if (methodName == "registerNatives" && className == "java/lang/Object") { // ignore registerNatives
-			frame.PC += data->jmp + 1;
+	void Engine::exec_invokestatic (Instruction * data) {
+		auto &site = getCallSite(data);
+
+		if (site.kind == CallSite::NATIVE) {
+			quicken(data, INVOKENATIVE_QUICK);
+			exec_invokenative_quick(data);
 			return;
 		}
 
-		if (className.find("java/") == 0) { // calling something that start with java/, this should not happen
-			throw JvmException("Invalid call to" + className);
+		if (run_clinit(*site.targetClass[0])) {
+			return; // runs again once <clinit> returns
 		}
 
-		auto methodData = findMethod(*methodRef);
+		quicken(data, INVOKESTATIC_QUICK);
+		exec_invokestatic_quick(data);
+	}
+
+	void Engine::exec_invokestatic_quick (Instruction * data) {
+		auto &frame = fs.top();
+		auto &site = *static_cast<CallSite *>(data->cache);
+
+		fs.push(*site.targetClass[0], *site.targetMethod[0], site.nargs); // The arguments on the stack become the callee locals
+		frame.PC += data->jmp + 1;
+	}
+
+	void Engine::exec_invokeinterface (Instruction * data) {
+		exec_invokevirtual(data); // the method is looked up in the class of the receiver as well
+	}
+
+	void Engine::exec_invokedynamic (Instruction * data) {
+		auto &frame = fs.top();
+		auto &site = getConcatSite(data);
+		auto args = frame.operands.end() - site.nargs;
 
-		Frame newFrame(methodData.classLoader, methodData.method);
+		// The text of the arguments and the length of the result, before anything is allocated
+		u8 length = 0;
+		u1 coder = site.coder;
 
-		auto nargs = getArgumentsSize(methodDescriptor);
-		std::stack<op4> args;
-		for (u2 i = 0; i < nargs; i++) {
-			auto value = frame.operands.pop4();
-			args.push(value.value);
+		for (size_t i = 0; i < site.pieces.size(); i++) {
+			auto &piece = site.pieces[i];
+			length += piece.constant;
+
+			switch (piece.type) {
+				case 0:
+					continue;
+				case 'C':
+					length += 1;
+					coder |= args[piece.slot].ui2 < 0x100 ? StringObject::LATIN1 : StringObject::UTF16;
+					continue;
+				case 'L': case '[': {
+					auto ref = args[piece.slot].ui4;
+					if (ref == 0) {
+						std::memcpy(&site.texts[i * NumberFormat::MAX_LENGTH], "null", 4);
+						site.lengths[i] = 4;
+					} else if (strings.isText(ref)) {
+						length += strings.length(ref);
+						coder |= strings.coder(ref);
+						continue;
+					} else {
+						site.objects[i] = strings.objectText(ref);
+						site.lengths[i] = static_cast<u4>(site.objects[i].size());
+					}
+					break;
+				}
+				default:
+					site.lengths[i] = Strings::valueOf(piece.type, args + piece.slot, &site.texts[i * NumberFormat::MAX_LENGTH]);
+					break;
+			}
+			length += site.lengths[i];
 		}
 
-		for (u2 i = 0; i < nargs; i++) {
-			auto value = args.top(); args.pop();
-			newFrame.variables.set(i, value);
+		if (length > std::numeric_limits<u4>::max()) {
+			throw JvmException("OutOfMemoryError: String length " + std::to_string(length));
 		}
 
-		fs.push(newFrame);
+		// A single allocation of the exact size, the arguments still on the stack are updated if it collects
+		auto result = strings.create(static_cast<u4>(length), coder);
+		auto to = strings.latin1(result);
+		auto constant = site.constants.data();
+
+		for (size_t i = 0; i < site.pieces.size(); i++) {
+			auto &piece = site.pieces[i];
+			Strings::copyChars(constant, site.coder, piece.constant, to, coder);
+			constant += piece.constant << site.coder;
+			to += piece.constant << coder;
+
+			if (piece.type == 'C') {
+				auto c = args[piece.slot].ui2;
+				if (coder == StringObject::LATIN1) {
+					*to = static_cast<u1>(c);
+				} else {
+					*reinterpret_cast<u2 *>(to) = c;
+				}
+				to += 1 << coder;
+			} else if ((piece.type == 'L' || piece.type == '[') && args[piece.slot].ui4 != 0) {
+				auto ref = args[piece.slot].ui4;
+				if (strings.isText(ref)) {
+					strings.getChars(ref, to, coder);
+					to += strings.length(ref) << coder;
+				} else {
+					Strings::copyChars(reinterpret_cast<const u1 *>(site.objects[i].data()), StringObject::LATIN1, site.lengths[i], to, coder);
+					to += site.lengths[i] << coder;
+				}
+			} else if (piece.type != 0) {
+				Strings::copyChars(reinterpret_cast<const u1 *>(&site.texts[i * NumberFormat::MAX_LENGTH]), StringObject::LATIN1, site.lengths[i], to, coder);
+				to += site.lengths[i] << coder;
+			}
+		}
 
+		frame.operands.drop(site.nargs);
+		frame.operands.push4(T_REF, result);
 		frame.PC += data->jmp + 1;
 	}
 
-	// TODO: finish this function
-	void Engine::exec_invokeinterface (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOinvokeinterface *>(info); // get data in class
+	ConcatSite &Engine::getConcatSite(Instruction *data) {
+		if (data->cache != nullptr) {
+			return *static_cast<ConcatSite *>(data->cache);
+		}
+
 		auto &frame = fs.top();
+		auto &cp = frame.cl.constant_pool;
+		auto &runtime = frame.cl.runtime;
+		auto &bootstraps = frame.cl.attributes.BootstrapMethods;
+		auto attrIndex = cp[data->index]->as<CP_InvokeDynamic>().bootstrap_method_attr_index;
 
-		frame.PC += data->jmp + 1;
+		if (bootstraps.empty() || attrIndex >= bootstraps[0]->bootstrap_methods.size()) {
+			throw JvmException("BootstrapMethodError: no bootstrap method " + std::to_string(attrIndex));
+		}
 
-		// throw JvmException("Not Implemented!");
+		auto &bootstrap = bootstraps[0]->bootstrap_methods[attrIndex];
+		auto &factory = runtime[cp[bootstrap.bootstrap_method_ref]->as<CP_MethodHandle>().reference_index];
+		auto &className = Symbols::get(runtime[factory.classIndex].text);
+		auto &methodName = Symbols::get(factory.text);
+
+		// Only the string concatenation of javac is linked, lambdas need java/lang/invoke
+		auto withConstants = methodName == "makeConcatWithConstants";
+		if (className != "java/lang/invoke/StringConcatFactory" || (not withConstants && methodName != "makeConcat")) {
+			throw JvmException("BootstrapMethodError: " + className + "." + methodName + " is not supported");
+		}
+
+		// Type and slot of each argument, from the descriptor of the call site
+		auto &descriptor = Symbols::get(runtime[data->index].descriptor);
+		std::vector<std::pair<char, u2>> arguments;
+		u2 slots = 0;
+		for (size_t i = 1; descriptor[i] != ')'; i++) {
+			arguments.emplace_back(descriptor[i], slots);
+			slots += descriptor[i] == 'J' || descriptor[i] == 'D' ? 2 : 1;
+			i = descriptor.find_first_not_of('[', i);
+			if (descriptor[i] == 'L') {
+				i = descriptor.find(';', i);
+			}
+		}
+
+		// In the recipe \1 stands for the next argument and \2 for the next bootstrap argument
+		std::u16string recipe(arguments.size(), u'\1');
+		if (withConstants) {
+			if (bootstrap.bootstrap_arguments.empty() || runtime[bootstrap.bootstrap_arguments[0]].tag != CP_TAGS::String) {
+				throw JvmException("BootstrapMethodError: makeConcatWithConstants without a recipe");
+			}
+			recipe = Strings::decode(Symbols::get(runtime[bootstrap.bootstrap_arguments[0]].text));
+		}
+
+		ConcatSite site;
+		site.nargs = slots;
+		std::u16string constants;
+		size_t argument = 0, constant = 1;
+		u4 run = 0;
+
+		for (auto c : recipe) {
+			if (c == u'\1') {
+				if (argument >= arguments.size()) {
+					throw JvmException("BootstrapMethodError: the recipe has more arguments than the call site");
+				}
+				site.pieces.push_back({run, arguments[argument].first, arguments[argument].second});
+				argument++;
+				run = 0;
+			} else if (c == u'\2') {
+				if (constant >= bootstrap.bootstrap_arguments.size()) {
+					throw JvmException("BootstrapMethodError: the recipe has more constants than the bootstrap method");
+				}
+
+				auto &entry = runtime[bootstrap.bootstrap_arguments[constant++]];
+				std::u16string text;
+				switch (entry.tag) {
+					case CP_TAGS::String:
+						text = Strings::decode(Symbols::get(entry.text));
+						break;
+					case CP_TAGS::Integer: {
+						auto number = std::to_string(static_cast<i4>(entry.value.ull));
+						text.assign(number.begin(), number.end());
+						break;
+					}
+					case CP_TAGS::Long: {
+						auto number = std::to_string(entry.value.ll);
+						text.assign(number.begin(), number.end());
+						break;
+					}
+					default:
+						throw JvmException("BootstrapMethodError: unsupported constant in a string concatenation");
+				}
+				constants += text;
+				run += static_cast<u4>(text.size());
+			} else {
+				constants += c;
+				run++;
+			}
+		}
+		site.pieces.push_back({run, 0, 0});
+
+		// The constants are kept in the coder of the strings, so they are copied as they are
+		auto latin1 = std::all_of(constants.begin(), constants.end(), [](char16_t c) { return c < 0x100; });
+		site.coder = latin1 ? StringObject::LATIN1 : StringObject::UTF16;
+		site.constants.resize(constants.size() << site.coder);
+		if (latin1) {
+			std::copy(constants.begin(), constants.end(), site.constants.begin());
+		} else {
+			std::memcpy(site.constants.data(), constants.data(), site.constants.size());
+		}
+
+		// Scratch of the text of the arguments, so a concatenation only allocates its result
+		site.texts.resize(site.pieces.size() * NumberFormat::MAX_LENGTH);
+		site.lengths.resize(site.pieces.size());
+		site.objects.resize(site.pieces.size());
+
+		concatSites.push_back(site);
+		data->cache = &concatSites.back();
+
+		return concatSites.back();
 	}
 
-	// TODO: finish this function
-	void Engine::exec_invokedynamic (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOinvokedynamic *>(info); // get data in class
+	void Engine::exec_new (Instruction * data) {
 		auto &frame = fs.top();
+		auto &classRef = frame.cl.runtime[data->index];
+		if (classRef.text == Strings::builderClass()) {
+			quicken(data, NEW_BUILDER_QUICK);
+			exec_new_builder_quick(data);
+			return;
+		}
 
-		frame.PC += data->jmp + 1;
+		// The library classes have no fields here
+		u4 size = 0;
+		if (Symbols::get(classRef.text).find("java/") != 0) {
+			auto &objectClass = resolveClass(frame.cl, data->index);
+			if (run_clinit(objectClass)) {
+				return; // runs again once <clinit> returns
+			}
+			size = objectClass.instance_size;
+		}
 
-		// throw JvmException("Not Implemented!");
+		data->value = static_cast<i4>(size);
+		data->cache = &classRef;
+		quicken(data, NEW_QUICK);
+		exec_new_quick(data);
 	}
 
-	// TODO: finish this function
-	void Engine::exec_new (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOinvokestatic *>(info); // get data in class
+	void Engine::exec_new_quick (Instruction * data) {
 		auto &frame = fs.top();
-		auto &cp = frame.cl.constant_pool;
+		auto &classRef = *static_cast<RuntimeEntry *>(data->cache);
 
-		auto classInfo = reinterpret_cast<CP_Class*>(cp[data->index]); // get the method info from constant pool
-		auto className = cp[classInfo->name_index]->toString(cp);
-		if (className == "java/lang/StringBuilder") {
-			frame.PC += data->jmp + 1;
-			throw JvmException("Not Implemented String Builder!");
-			return;
-		}
+		frame.operands.push4(T_REF, heap.newObject(static_cast<u4>(data->value), classRef.text));
+		frame.PC += data->jmp + 1;
+	}
 
-		// throw JvmException("Not Implemented!");
+	void Engine::exec_new_builder_quick (Instruction * data) {
+		auto &frame = fs.top();
+		frame.operands.push4(T_REF, strings.newBuilder());
+		frame.PC += data->jmp + 1;
 	}
 
-	// TODO: verificar corretude
-	void Engine::exec_newarray (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOnewarray *>(info); // get data in class
+	void Engine::exec_newarray (Instruction * data) {
 		auto &frame = fs.top();
-		auto type = data->atype;
-		auto vector_ptr = static_cast<u2>(mem.size());
 		auto value = frame.operands.pop4();
 
 		assert(value.type == T_INT);
 
-		auto arr = new Array;
-
-		arr->size = value.value.ui4;
-
-		if (type == T_BOOL) {
-			arr->type = T_BOOL;
-			arr->array = new bool[value.value.ui4];
-		} else if (type == T_CHAR) {
-			arr->type = T_CHAR;
-			arr->array = new char[value.value.ui4];
-		} else if (type == T_FLOAT) {
-			arr->type = T_FLOAT;
-			arr->array = new float[value.value.ui4];
-		} else if (type == T_DOUBLE) {
-			arr->type = T_DOUBLE;
-			arr->array = new double[value.value.ui4];
-		} else if (type == T_BYTE) {
-			arr->type = T_BYTE;
-			arr->array = new u1[value.value.ui4];
-		} else if (type == T_SHORT) {
-			arr->type = T_SHORT;
-			arr->array = new short[value.value.ui4];
-		} else if (type == T_INT) {
-			arr->type = T_INT;
-			arr->array = new int[value.value.ui4];
-		} else if (type == T_LONG) {
-			arr->type = T_LONG;
-			arr->array = new long[value.value.ui4];
-		} else {
-			throw JvmException("Invalid atype!");
-		}
-
-		mem.push_back(arr);
-		op4 res { .ui4 = vector_ptr };
+		op4 res { .ui4 = heap.newArray(static_cast<u1>(data->value), value.value.i4) };
 
 		frame.operands.push4(T_ARRAY, res);
 		frame.PC += data->jmp + 1;
 	}
 
 	// TODO: need to set array to null and corretude
-	void Engine::exec_anewarray (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOanewarray *>(info); // get data in class
+	void Engine::exec_anewarray (Instruction * data) {
 		auto &frame = fs.top();
-		auto cpRef = frame.cl.constant_pool[data->index];
-		auto vector_ptr = static_cast<u2>(mem.size());
+		auto &cpRef = frame.cl.runtime[data->index];
 		auto value = frame.operands.pop4();
 
 		assert(value.type == T_INT);
 
-		auto arr = new Array;
-
-		arr->size = value.value.ui4;
-		arr->array = new i4[value.value.ui4];
-
-		auto cl = dynamic_cast<CP_Class*>(cpRef);
-		if (cl != nullptr) { // array of type Class
-			arr->type = T_OBJ;
-		}
-
-		auto mr = dynamic_cast<CP_Methodref*>(cpRef);
-		if (mr != nullptr) { // array of type method ref
-			arr->type = T_METHOD;
-		}
-
-		auto ir = dynamic_cast<CP_InterfaceMethodref*>(cpRef);
-		if (ir != nullptr) { // array of type interface ref
-			arr->type = T_INTERFACE;
-		}
-
-		mem.push_back(arr);
-		op4 res { .ui4 = vector_ptr };
+		op4 res { .ui4 = heap.newArray(T_REF, value.value.i4, cpRef.text) };
 
 		frame.operands.push4(T_ARRAY, res);
 		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_arraylength (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOarraylength *>(info); // get data in class
+	void Engine::exec_arraylength (Instruction * data) {
 		auto &frame = fs.top();
 		auto value = frame.operands.pop4();
-		auto arr = static_cast<Array*>(mem[value.value.ui4]);
 
-		op4 res { .ui4 = arr->size };
+		if (value.value.ui4 == 0) {
+			throw JvmException("NullPointerException");
+		}
+
+		op4 res { .ui4 = heap.get(value.value.ui4)->length };
 
 		frame.operands.push4(T_INT, res);
 		frame.PC += data->jmp + 1;
 	}
 
 	// TODO: finish this function
-	void Engine::exec_athrow (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOathrow *>(info); // get data in class
+	void Engine::exec_athrow (Instruction * data) {
 		auto &frame = fs.top();
 
 		frame.PC += data->jmp + 1;
@@ -2881,16 +3961,14 @@ namespace jvm {
 	}
 
 	// TODO: finish this function
-	void Engine::exec_checkcast (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOcheckcast *>(info); // get data in class
+	void Engine::exec_checkcast (Instruction * data) {
 		auto &frame = fs.top();
 		frame.PC += data->jmp + 1;
 		// throw JvmException("Not Implemented!");
 	}
 
 	// TODO: finish this function
-	void Engine::exec_instanceof (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOinstanceof *>(info); // get data in class
+	void Engine::exec_instanceof (Instruction * data) {
 		auto &frame = fs.top();
 
 		frame.PC += data->jmp + 1;
@@ -2898,17 +3976,16 @@ namespace jvm {
 		// throw JvmException("Not Implemented!");
 	}
 
-	void Engine::exec_monitorenter (InstructionInfo * info) {
+	void Engine::exec_monitorenter (Instruction * data) {
 		// This JVM does not have support for multiple threads
 	}
 
-	void Engine::exec_monitorexit (InstructionInfo * info) {
+	void Engine::exec_monitorexit (Instruction * data) {
 		// This JVM does not have support for multiple threads
 	}
 
 	// TODO: finish this function
-	void Engine::exec_wide (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOwide *>(info); // get data in class
+	void Engine::exec_wide (Instruction * data) {
 		auto &frame = fs.top();
 
 		frame.PC += data->jmp + 1;
@@ -2916,71 +3993,215 @@ namespace jvm {
 		// throw JvmException("Not Implemented!");
 	}
 
-	// TODO: finish this function
-	void Engine::exec_multianewarray (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOmultianewarray *>(info); // get data in class
+	void Engine::exec_multianewarray (Instruction * data) {
 		auto &frame = fs.top();
+		auto &descriptor = Symbols::get(frame.cl.runtime[data->index].text); // as [[I or [[Ljava/lang/String;
+		auto dimensions = static_cast<u4>(data->value);
 
-		frame.PC += data->jmp + 1;
+		multiArraySites.emplace_back();
+		auto &site = multiArraySites.back();
 
-		// throw JvmException("Not Implemented!");
+		// The elements of the arrays of a level are described by the descriptor without its first level+1 brackets
+		for (u4 level = 0; level < dimensions; level++) {
+			auto element = descriptor.substr(level + 1);
+			site.elementTypes[level] = Heap::elementType(element[0]);
+			site.klasses[level] = 0;
+			if (element[0] == 'L') {
+				site.klasses[level] = Symbols::intern(element.substr(1, element.size() - 2));
+			} else if (element[0] == '[') {
+				site.klasses[level] = Symbols::intern(element);
+			}
+		}
+
+		data->cache = &site;
+		quicken(data, MULTIANEWARRAY_QUICK);
+		exec_multianewarray_quick(data);
+	}
+
+	void Engine::exec_multianewarray_quick (Instruction * data) {
+		auto &frame = fs.top();
+		auto &site = *static_cast<MultiArraySite *>(data->cache);
+		auto dimensions = static_cast<u4>(data->value);
+		i4 lengths[Heap::MAX_DIMENSIONS];
+
+		for (u4 level = dimensions; level-- > 0;) { // the last dimension is on the top
+			lengths[level] = frame.operands.pop4().value.i4;
+		}
+
+		op4 res { .ui4 = heap.newMultiArray(site.elementTypes, site.klasses, lengths, dimensions) };
+
+		frame.operands.push4(T_ARRAY, res);
+		frame.PC += data->jmp + 1;
 	}
 
-	void Engine::exec_ifnull (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOifnull *>(info); // get data in class
+	void Engine::exec_ifnull (Instruction * data) {
 		auto &frame = fs.top();
 		auto ref = frame.operands.pop4();
 
 		assert(ref.type == T_REF);
 
 		if (ref.value.ui4 == 0) {
-			frame.PC = static_cast<u4>(static_cast<i4>(frame.PC) + data->branchoffset);
+			frame.PC = data->target;
 		} else {
 			frame.PC += data->jmp + 1;
 		}
 	}
 
-	void Engine::exec_ifnonnull (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOifnonnull *>(info); // get data in class
+	void Engine::exec_ifnonnull (Instruction * data) {
 		auto &frame = fs.top();
 		auto ref = frame.operands.pop4();
 
 		assert(ref.type == T_REF);
 
 		if (ref.value.ui4 != 0) { // if not null
-			auto newPC = static_cast<i4>(frame.PC) + data->branchoffset;
-			frame.PC = static_cast<u4>(newPC);
+			frame.PC = data->target;
 		} else {
 			frame.PC += data->jmp + 1;
 		}
 	}
 
-	void Engine::exec_goto_w (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOgoto_w *>(info); // get data in class
+	void Engine::exec_goto_w (Instruction * data) {
 		auto &frame = fs.top();
 
-		frame.PC = static_cast<u4>(static_cast<i4>(frame.PC) + data->branchoffset);
+		frame.PC = data->target;
 	}
 
-	void Engine::exec_jsr_w (InstructionInfo * info) {
-		auto data   = reinterpret_cast<OPINFOjsr_w *>(info); // get data in class
+	void Engine::exec_jsr_w (Instruction * data) {
 		auto &frame = fs.top();
 
 		frame.operands.push4(T_RET, frame.PC + data->jmp + 1); // insert address of the next instruction as type ReturnAddress
 
-		frame.PC = static_cast<u4>(static_cast<i4>(frame.PC) + data->branchoffset); // jump to procedure
+		frame.PC = data->target; // jump to procedure
 	}
 
-	void Engine::exec_breakpoint (InstructionInfo * info) {
+	void Engine::exec_breakpoint (Instruction * data) {
 		// This JVM will not need reserved instructions for debuggers or back door
 	}
 
-	void Engine::exec_impdep1 (InstructionInfo * info) {
+	void Engine::exec_impdep1 (Instruction * data) {
 		// This JVM will not need reserved instructions for debuggers or back door
 	}
 
-	void Engine::exec_impdep2 (InstructionInfo * info) {
+	void Engine::exec_impdep2 (Instruction * data) {
 		// This JVM will not need reserved instructions for debuggers or back door
 	}
 
+	// The superinstructions run the instructions of their sequence, whose operands they read
+
+	void Engine::exec_iload_iload (Instruction * data) {
+		auto &frame = fs.top();
+		auto second = data->next();
+
+		frame.operands.push4(T_INT, frame.variables.get4(data->index));
+		frame.operands.push4(T_INT, frame.variables.get4(second->index));
+		frame.PC += data->jmp + second->jmp + 2;
+	}
+
+	void Engine::exec_iload_iload_iadd_istore (Instruction * data) {
+		auto &frame = fs.top();
+		auto second = data->next();
+		auto add = second->next();
+		auto store = add->next();
+
+		op4 sum;
+		sum.ui4 = frame.variables.get4(data->index).ui4 + frame.variables.get4(second->index).ui4; // wraps as iadd
+		frame.variables.set(store->index, sum);
+		frame.PC += data->jmp + second->jmp + add->jmp + store->jmp + 4;
+	}
+
+	void Engine::exec_aload_iload_iaload (Instruction * data) {
+		auto &frame = fs.top();
+		auto index = data->next();
+		auto load = index->next();
+
+		auto element = arrayElement<u4>(frame.variables.get4(data->index).ui4, frame.variables.get4(index->index).i4);
+		frame.operands.push4(T_INT, *element);
+		frame.PC += data->jmp + index->jmp + load->jmp + 3;
+	}
+
+	void Engine::exec_aload_iload_iload_iastore (Instruction * data) {
+		auto &frame = fs.top();
+		auto index = data->next();
+		auto value = index->next();
+		auto store = value->next();
+
+		auto element = arrayElement<u4>(frame.variables.get4(data->index).ui4, frame.variables.get4(index->index).i4);
+		*element = frame.variables.get4(value->index).ui4;
+		frame.PC += data->jmp + index->jmp + value->jmp + store->jmp + 4;
+	}
+
+	void Engine::exec_iload_iload_if_icmplt (Instruction * data) {
+		auto &frame = fs.top();
+		auto second = data->next();
+		auto branch = second->next();
+
+		if (frame.variables.get4(data->index).i4 < frame.variables.get4(second->index).i4) {
+			frame.PC = branch->target;
+		} else {
+			frame.PC += data->jmp + second->jmp + branch->jmp + 3;
+		}
+	}
+
+	void Engine::exec_iload_iload_if_icmpge (Instruction * data) {
+		auto &frame = fs.top();
+		auto second = data->next();
+		auto branch = second->next();
+
+		if (frame.variables.get4(data->index).i4 >= frame.variables.get4(second->index).i4) {
+			frame.PC = branch->target;
+		} else {
+			frame.PC += data->jmp + second->jmp + branch->jmp + 3;
+		}
+	}
+
+	void Engine::exec_iload_iconst_if_icmplt (Instruction * data) {
+		auto &frame = fs.top();
+		auto constant = data->next();
+		auto branch = constant->next();
+
+		if (frame.variables.get4(data->index).i4 < constant->value) {
+			frame.PC = branch->target;
+		} else {
+			frame.PC += data->jmp + constant->jmp + branch->jmp + 3;
+		}
+	}
+
+	void Engine::exec_iload_iconst_if_icmpge (Instruction * data) {
+		auto &frame = fs.top();
+		auto constant = data->next();
+		auto branch = constant->next();
+
+		if (frame.variables.get4(data->index).i4 >= constant->value) {
+			frame.PC = branch->target;
+		} else {
+			frame.PC += data->jmp + constant->jmp + branch->jmp + 3;
+		}
+	}
+
+	void Engine::exec_iinc_goto (Instruction * data) {
+		auto &frame = fs.top();
+		auto value = frame.variables.get4(data->index);
+
+		value.ui4 += static_cast<u4>(data->value);
+		frame.variables.set(data->index, value);
+		frame.PC = data->next()->target;
+	}
+
+	void Engine::exec_iinc_iload_iload_if_icmplt (Instruction * data) {
+		auto &frame = fs.top();
+		auto first = data->next();
+		auto second = first->next();
+		auto branch = second->next();
+
+		auto value = frame.variables.get4(data->index);
+		value.ui4 += static_cast<u4>(data->value);
+		frame.variables.set(data->index, value);
+
+		if (frame.variables.get4(first->index).i4 < frame.variables.get4(second->index).i4) {
+			frame.PC = branch->target;
+		} else {
+			frame.PC += data->jmp + first->jmp + second->jmp + branch->jmp + 4;
+		}
+	}
+
 }
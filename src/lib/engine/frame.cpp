@@ -2,9 +2,10 @@
 
 namespace jvm {
 
-	Frame::Frame(ClassLoader &cl, MethodInfo& mt) : cl(cl), mt(mt), PC(0), Return_value(0) {
-		auto codeAttr = mt.attributes.Codes[0];
-		variables.setSize(codeAttr->max_locals);
-		operands.setSize(codeAttr->max_stack);
+	Frame::Frame(ClassLoader &cl, MethodInfo& mt, op4 *slots, u1 *tags) : cl(cl), mt(mt), PC(0), Return_value(0) {
+		auto &codeAttr = mt.attributes.Codes[0];
+		variables.bind(slots);
+		operands.bind(slots + codeAttr->max_locals, tags + codeAttr->max_locals, codeAttr->max_stack);
+		code = codeAttr->code.data();
 	}
 };
\ No newline at end of file
@@ -1,3 +1,29 @@
 #include "engine/frames_stack.hpp"
+#include "util/JvmException.hpp"
 
-namespace jvm {};
\ No newline at end of file
+namespace jvm {
+
+	FramesStack::FramesStack() : slots(MAX_SLOTS), tags(MAX_SLOTS) {
+		c.reserve(MAX_FRAMES); // frames never move, references to them stay valid
+	}
+
+	Frame &FramesStack::push(ClassLoader &cl, MethodInfo &mt, u2 nargs) {
+		auto &codeAttr = mt.attributes.Codes[0];
+		op4 *base = slots.data();
+
+		if (not empty()) {
+			auto &caller = top();
+			caller.operands.drop(nargs);
+			base = caller.operands.end(); // callee locals overlap the arguments
+		}
+
+		auto offset = base - slots.data();
+		if (size() == MAX_FRAMES || offset + codeAttr->max_locals + codeAttr->max_stack > MAX_SLOTS) {
+			throw JvmException("StackOverflowError");
+		}
+
+		c.emplace_back(cl, mt, base, tags.data() + offset);
+		return c.back();
+	}
+
+};
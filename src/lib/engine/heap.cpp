@@ -0,0 +1,345 @@
+#include <cstring>
+#include <cstdlib>
+
+#include "engine/heap.hpp"
+#include "util/JvmException.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+	#include <sys/mman.h>
+	#define JVM_MMAP_HEAP
+#endif
+
+namespace jvm {
+
+	namespace {
+		const u8 CARD_SIZE = u8(1) << Heap::CARD_SHIFT;
+	}
+
+	Heap::~Heap() {
+		if (base == nullptr) {
+			return;
+		}
+#ifdef JVM_MMAP_HEAP
+		munmap(base, capacity);
+#else
+		std::free(base);
+#endif
+	}
+
+	void Heap::reserve(u8 capacity, u8 nursery) {
+		this->capacity = std::min<u8>(std::max<u8>(capacity, 2 * RESERVED), u8(MAX_CAPACITY));
+#ifdef JVM_MMAP_HEAP
+		// pages are only backed by memory once they are touched
+		void *region = mmap(nullptr, this->capacity, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+		if (region == MAP_FAILED) {
+			throw JvmException("Couldn't reserve the heap");
+		}
+		base = static_cast<u1 *>(region);
+#else
+		base = static_cast<u1 *>(std::calloc(this->capacity, 1));
+		if (base == nullptr) {
+			throw JvmException("Couldn't reserve the heap");
+		}
+#endif
+		// Every space starts on a card, so the first object of a space starts its first card
+		nursery = std::min<u8>(nursery, (this->capacity - RESERVED) / 4) & ~(CARD_SIZE - 1);
+		youngStart = youngTop = RESERVED;
+		youngLimit = youngStart + nursery;
+
+		semispace = ((this->capacity - youngLimit) / 2) & ~(CARD_SIZE - 1);
+		start = top = youngLimit;
+		limit = start + semispace;
+
+		cards.assign((this->capacity >> CARD_SHIFT) + 1, 0);
+		if (nursery > 0) {
+			firstObject.assign(cards.size(), 0);
+		}
+	}
+
+	u4 Heap::allocate(u8 bytes) {
+		bytes = (bytes + ALIGNMENT - 1) & ~u8(ALIGNMENT - 1);
+		u4 ref = 0;
+
+		if (bytes <= (youngLimit - youngStart) / 2) { // large objects go straight to the old generation
+			if (bytes > youngLimit - youngTop && collector) {
+				collector();
+			}
+			if (bytes <= youngLimit - youngTop) {
+				ref = static_cast<u4>(youngTop);
+				youngTop += bytes;
+			}
+		}
+
+		if (ref == 0) {
+			if (bytes > limit - top && collector) {
+				full = true;
+				collector();
+			}
+			if (bytes > limit - top) {
+				throw JvmException("OutOfMemoryError: Java heap space");
+			}
+			ref = bumpOld(bytes);
+		}
+
+		count++;
+		allocated += bytes;
+
+		auto object = get(ref);
+		std::memset(object, 0, bytes);
+		object->size = static_cast<u4>(bytes);
+		return ref;
+	}
+
+	u4 Heap::bumpOld(u8 bytes) {
+		auto ref = top;
+		top += bytes;
+
+		recordObjects(ref, top);
+
+		return static_cast<u4>(ref);
+	}
+
+	void Heap::recordObjects(u8 ref, u8 end) {
+		if (not firstObject.empty()) {
+			for (u8 card = (ref + CARD_SIZE - 1) >> CARD_SHIFT; (card << CARD_SHIFT) < end; card++) {
+				firstObject[card] = static_cast<u4>(ref);
+			}
+		}
+	}
+
+	u4 Heap::newObject(u4 bytes, u4 klass) {
+		auto ref = allocate(u8(sizeof(HeapObject)) + bytes);
+		auto object = get(ref);
+		object->kind = T_OBJ;
+		object->klass = klass;
+		return ref;
+	}
+
+	u4 Heap::newArray(u1 elementType, i4 length, u4 klass) {
+		if (length < 0) {
+			throw JvmException("NegativeArraySizeException");
+		}
+
+		auto ref = allocate(u8(sizeof(HeapObject)) + u8(length) * elementSize(elementType));
+		auto object = get(ref);
+		object->kind = T_ARRAY;
+		object->elementType = elementType;
+		object->klass = klass;
+		object->length = static_cast<u4>(length);
+		return ref;
+	}
+
+	u4 Heap::newMultiArray(const u1 *elementTypes, const u4 *klasses, const i4 *lengths, u4 dimensions) {
+		for (u4 level = 0; level < dimensions; level++) {
+			if (lengths[level] < 0) {
+				throw JvmException("NegativeArraySizeException: " + std::to_string(lengths[level]));
+			}
+		}
+
+		// Arrays of each level and bytes taken by each one of them
+		u8 counts[MAX_DIMENSIONS], sizes[MAX_DIMENSIONS];
+		u8 total = 0, objects = 0;
+		for (u4 level = 0; level < dimensions; level++) {
+			counts[level] = level == 0 ? 1 : counts[level - 1] * u8(lengths[level - 1]);
+			sizes[level] = (sizeof(HeapObject) + u8(lengths[level]) * elementSize(elementTypes[level]) + ALIGNMENT - 1) & ~u8(ALIGNMENT - 1);
+			if (counts[level] > capacity || (counts[level] > 0 && sizes[level] > (capacity - total) / counts[level])) { // before it overflows
+				throw JvmException("OutOfMemoryError: Java heap space");
+			}
+			total += counts[level] * sizes[level];
+			objects += counts[level];
+		}
+
+		auto ref = allocate(total);
+		auto block = static_cast<u8>(ref);
+
+		// Each array of a level points, in order, to the next arrays of the level below
+		u8 next = block;
+		for (u4 level = 0; level < dimensions; level++) {
+			u8 below = next + counts[level] * sizes[level];
+			for (u8 i = 0; i < counts[level]; i++, next += sizes[level]) {
+				auto object = get(static_cast<u4>(next));
+				object->size = static_cast<u4>(sizes[level]);
+				object->kind = T_ARRAY;
+				object->elementType = elementTypes[level];
+				object->klass = klasses[level];
+				object->length = static_cast<u4>(lengths[level]);
+
+				if (level + 1 < dimensions) {
+					auto elements = data<u4>(static_cast<u4>(next));
+					for (i4 j = 0; j < lengths[level]; j++, below += sizes[level + 1]) {
+						elements[j] = static_cast<u4>(below);
+					}
+				}
+			}
+		}
+
+		// The cards of the old generation must start on a subarray, not on the block
+		if (block >= youngLimit) {
+			for (u8 object = block; object < block + total; object += get(static_cast<u4>(object))->size) {
+				recordObjects(object, object + get(static_cast<u4>(object))->size);
+			}
+		}
+
+		count += objects - 1; // allocate() counted the block as one object
+		return ref;
+	}
+
+	u1 Heap::elementType(char descriptor) {
+		switch (descriptor) {
+			case 'Z': return T_BOOL;
+			case 'C': return T_CHAR;
+			case 'F': return T_FLOAT;
+			case 'D': return T_DOUBLE;
+			case 'B': return T_BYTE;
+			case 'S': return T_SHORT;
+			case 'I': return T_INT;
+			case 'J': return T_LONG;
+			default:  return T_REF;
+		}
+	}
+
+	u1 Heap::elementSize(u1 elementType) {
+		switch (elementType) {
+			case T_BOOL:
+			case T_BYTE:
+				return 1;
+			case T_CHAR:
+			case T_SHORT:
+				return 2;
+			case T_INT:
+			case T_FLOAT:
+			case T_REF:
+				return 4;
+			case T_LONG:
+			case T_DOUBLE:
+				return 8;
+			default:
+				throw JvmException("Invalid atype!");
+		}
+	}
+
+	void Heap::beginCollection() {
+		pauseStart = std::chrono::steady_clock::now();
+
+		// The survivors of the nursery must fit in the old generation, or everything is collected
+		full = full || (limit - top) < (youngTop - youngStart);
+		collectedYoung = youngTop;
+
+		if (full) {
+			fromStart = start;
+			fromTop = top;
+			start = top = (start == youngLimit) ? youngLimit + semispace : youngLimit;
+			limit = start + semispace;
+		} else {
+			fromStart = fromTop = 0;
+		}
+
+		survivors = top;
+	}
+
+	u4 Heap::forward(u4 ref) {
+		bool young = ref >= youngStart && ref < collectedYoung;
+		if (not young && (ref < fromStart || ref >= fromTop)) { // null, or not a reference to the spaces being collected
+			return ref;
+		}
+
+		auto object = get(ref);
+		if (object->flags & HeapObject::FORWARDED) {
+			return object->klass;
+		}
+
+		if (object->size > limit - top) {
+			throw JvmException("OutOfMemoryError: Java heap space");
+		}
+
+		auto copy = bumpOld(object->size);
+		std::memcpy(base + copy, object, object->size);
+		if (young) {
+			promoted += object->size;
+		}
+
+		object->flags |= HeapObject::FORWARDED;
+		object->klass = copy;
+		return copy;
+	}
+
+	void Heap::scan(u4 ref, u8 from, u8 to) {
+		auto object = get(ref);
+
+		if (object->kind == T_ARRAY && object->elementType == T_REF) {
+			u8 first = ref + sizeof(HeapObject);
+			u4 begin = from > first ? static_cast<u4>((from - first) / 4) : 0;
+			u4 end = to > first ? static_cast<u4>(std::min<u8>(object->length, (to - first) / 4)) : 0;
+
+			auto elements = data<u4>(ref);
+			for (u4 i = begin; i < end; i++) {
+				elements[i] = forward(elements[i]);
+			}
+		} else if (object->kind == T_OBJ) {
+			auto layout = references.find(object->klass);
+			if (layout == references.end()) {
+				return;
+			}
+
+			u8 first = ref + sizeof(HeapObject);
+			for (auto offset : layout->second) {
+				if (first + offset >= from && first + offset < to) {
+					auto field = reinterpret_cast<u4 *>(base + first + offset);
+					*field = forward(*field);
+				}
+			}
+		}
+	}
+
+	void Heap::scanCards(u8 end) {
+		auto last = cards.begin() + static_cast<std::ptrdiff_t>((end + CARD_SIZE - 1) >> CARD_SHIFT);
+		auto card = std::find(cards.begin() + static_cast<std::ptrdiff_t>(start >> CARD_SHIFT), last, 1);
+
+		for (; card != last; card = std::find(card + 1, last, 1)) {
+			*card = 0;
+
+			u8 cardStart = static_cast<u8>(card - cards.begin()) << CARD_SHIFT;
+			u8 cardEnd = std::min(cardStart + CARD_SIZE, end);
+
+			for (u8 object = firstObject[cardStart >> CARD_SHIFT]; object < cardEnd; object += get(static_cast<u4>(object))->size) {
+				scan(static_cast<u4>(object), cardStart, cardEnd);
+			}
+		}
+	}
+
+	void Heap::endCollection() {
+		if (not full) {
+			scanCards(survivors); // the old objects that may point to the nursery
+		}
+
+		// Cheney scan: the copied objects between scan and top may still point to the spaces collected
+		for (u8 scanned = survivors; scanned < top; scanned += get(static_cast<u4>(scanned))->size) {
+			scan(static_cast<u4>(scanned), 0, top);
+		}
+
+		// Only the cards of the old generation in use may stay dirty
+		std::fill(cards.begin() + static_cast<std::ptrdiff_t>(youngStart >> CARD_SHIFT), cards.begin() + static_cast<std::ptrdiff_t>(youngLimit >> CARD_SHIFT), 0);
+		if (full) {
+			std::fill(cards.begin() + static_cast<std::ptrdiff_t>(fromStart >> CARD_SHIFT), cards.begin() + static_cast<std::ptrdiff_t>((fromTop + CARD_SIZE - 1) >> CARD_SHIFT), 0);
+		}
+
+		reclaimed += (fromTop - fromStart) + (collectedYoung - youngStart) - (top - survivors);
+		youngTop = youngStart;
+
+		std::chrono::duration<double> pause = std::chrono::steady_clock::now() - pauseStart;
+		collections[full]++;
+		pauseTotal[full] += pause.count();
+		pauseMax = std::max(pauseMax, pause.count());
+
+		full = false;
+	}
+
+	void Heap::printStats(std::ostream &os) const {
+		os << "heap: " << count << " objects, " << allocated << " bytes allocated, "
+		   << promoted << " bytes promoted, " << used() << " bytes in use" << std::endl;
+		os << "gc: " << collections[0] << " young collections (" << pauseTotal[0] * 1000.0 << " ms), "
+		   << collections[1] << " full collections (" << pauseTotal[1] * 1000.0 << " ms), "
+		   << reclaimed << " bytes reclaimed, max pause " << pauseMax * 1000.0 << " ms" << std::endl;
+	}
+
+}
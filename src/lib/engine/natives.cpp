@@ -0,0 +1,697 @@
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "engine/natives.hpp"
+#include "util/cpu_features.hpp"
+#include "util/number_format.hpp"
+#include "util/JvmException.hpp"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define JVM_X86_INTRINSICS
+#include <immintrin.h>
+#endif
+
+namespace jvm {
+
+	namespace {
+		JvmException outOfBounds(const std::string &what, i8 index, u4 length) {
+			return JvmException("ArrayIndexOutOfBoundsException: " + what + " " + std::to_string(index) + " out of bounds for length " + std::to_string(length));
+		}
+
+		// java/io/PrintStream of System.out, the only stream there is
+
+		/**
+		 * @return the stream of System.out, after checking it is the receiver
+		 */
+		PrintStream &printStream(Natives &natives, NativeArgs &args) {
+			if (args.getNonNull(0) != natives.systemOut) {
+				throw JvmException("UnsupportedOperationException: only System.out is a PrintStream");
+			}
+			return natives.out;
+		}
+
+		template <bool newLine>
+		void endPrint(Natives &natives, NativeArgs &args) {
+			auto &out = printStream(natives, args);
+			if (newLine) {
+				out.newLine();
+			}
+			args.returnVoid();
+		}
+
+		template <bool newLine>
+		void printObject(Natives &natives, NativeArgs &args) {
+			auto &out = printStream(natives, args);
+			auto ref = args.getRef(1);
+			if (ref == 0) {
+				out.write("null", 4);
+			} else if (natives.strings.isText(ref)) {
+				natives.strings.print(out, ref);
+			} else {
+				auto text = natives.strings.objectText(ref);
+				out.write(text.data(), text.size());
+			}
+			endPrint<newLine>(natives, args);
+		}
+
+		template <bool newLine>
+		void printChars(Natives &natives, NativeArgs &args) {
+			auto &out = printStream(natives, args);
+			auto ref = args.getNonNull(1);
+			out.printUtf16(natives.heap.data<u2>(ref), natives.heap.get(ref)->length);
+			endPrint<newLine>(natives, args);
+		}
+
+		template <bool newLine>
+		void printInt(Natives &natives, NativeArgs &args) {
+			auto &out = printStream(natives, args);
+			out.printLong(args.getInt(1));
+			endPrint<newLine>(natives, args);
+		}
+
+		template <bool newLine>
+		void printChar(Natives &natives, NativeArgs &args) {
+			auto &out = printStream(natives, args);
+			auto c = args.getChar(1);
+			out.printUtf16(&c, 1);
+			endPrint<newLine>(natives, args);
+		}
+
+		template <bool newLine>
+		void printBoolean(Natives &natives, NativeArgs &args) {
+			auto &out = printStream(natives, args);
+			out.printBoolean(args.getInt(1) != 0);
+			endPrint<newLine>(natives, args);
+		}
+
+		template <bool newLine>
+		void printFloat(Natives &natives, NativeArgs &args) {
+			auto &out = printStream(natives, args);
+			out.printFloat(args.getFloat(1));
+			endPrint<newLine>(natives, args);
+		}
+
+		template <bool newLine>
+		void printLong(Natives &natives, NativeArgs &args) {
+			auto &out = printStream(natives, args);
+			out.printLong(args.getLong(1));
+			endPrint<newLine>(natives, args);
+		}
+
+		template <bool newLine>
+		void printDouble(Natives &natives, NativeArgs &args) {
+			auto &out = printStream(natives, args);
+			out.printDouble(args.getDouble(1));
+			endPrint<newLine>(natives, args);
+		}
+
+		void flush(Natives &natives, NativeArgs &args) {
+			auto &out = printStream(natives, args);
+			out.flush();
+			args.returnVoid();
+		}
+
+		// java/lang/System and java/util/Arrays
+
+		/**
+		 * @return symbol of the name of the class of an object, or of the descriptor of an array
+		 */
+		u4 className(Heap &heap, u4 reference) {
+			auto object = heap.get(reference);
+			if (object->kind != T_ARRAY) {
+				return object->klass;
+			}
+			static const char primitives[] = {0, 0, 0, 0, 'Z', 'C', 'F', 'D', 'B', 'S', 'I', 'J'};
+			if (object->elementType != T_REF) {
+				return Symbols::intern(std::string("[") + primitives[object->elementType]);
+			}
+			const auto &element = Symbols::get(object->klass);
+			return Symbols::intern(element[0] == '[' ? "[" + element : "[L" + element + ";");
+		}
+
+		void arraycopy(Natives &natives, NativeArgs &args) {
+			auto &heap = natives.heap;
+			auto src = args.getRef(0);
+			auto srcPos = args.getInt(1);
+			auto dest = args.getRef(2);
+			auto destPos = args.getInt(3);
+			auto length = args.getInt(4);
+
+			if (src == 0 || dest == 0) {
+				throw JvmException("NullPointerException");
+			}
+
+			auto from = heap.get(src);
+			auto to = heap.get(dest);
+			if (from->kind != T_ARRAY || to->kind != T_ARRAY || from->elementType != to->elementType) {
+				throw JvmException("ArrayStoreException: arraycopy: type mismatch");
+			}
+			if (length < 0) {
+				throw JvmException("ArrayIndexOutOfBoundsException: arraycopy: length " + std::to_string(length) + " is negative");
+			}
+			if (srcPos < 0 || i8(srcPos) + length > from->length) {
+				throw outOfBounds("arraycopy: last source index", i8(srcPos) + length, from->length);
+			}
+			if (destPos < 0 || i8(destPos) + length > to->length) {
+				throw outOfBounds("arraycopy: last destination index", i8(destPos) + length, to->length);
+			}
+
+			auto size = Heap::elementSize(from->elementType);
+			auto target = heap.data<u1>(dest) + u8(destPos) * size;
+			if (to->elementType != T_REF || from->klass == to->klass || natives.assignable(from->klass, to->klass)) {
+				std::memmove(target, heap.data<u1>(src) + u8(srcPos) * size, u8(length) * size); // both may be the same array
+				if (to->elementType == T_REF) {
+					heap.markCards(target, target + u8(length) * size);
+				}
+				args.returnVoid();
+				return;
+			}
+
+			// Every element of the source may not fit the destination, the copy stops at the first one that does not
+			auto elements = heap.data<u4>(src) + srcPos;
+			auto targets = reinterpret_cast<u4 *>(target);
+			i4 copied = 0;
+			for (; copied < length; copied++) {
+				auto element = elements[copied];
+				if (element != 0 && not natives.assignable(className(heap, element), to->klass)) {
+					break;
+				}
+				targets[copied] = element;
+			}
+			heap.markCards(target, target + u8(copied) * size);
+			if (copied < length) {
+				throw JvmException("ArrayStoreException: arraycopy: element " + std::to_string(srcPos + copied) + " of type "
+						+ Symbols::get(className(heap, elements[copied])) + " can't be stored in an array of " + Symbols::get(to->klass));
+			}
+			args.returnVoid();
+		}
+
+		/**
+		 * Arrays.fill of a whole array, (array, value), or of a range, (array, from, to, value)
+		 * @tparam wide whether the value is a long or a double
+		 */
+		template <bool wide, bool range>
+		void arraysFill(Natives &natives, NativeArgs &args) {
+			auto &heap = natives.heap;
+			auto array = args.getNonNull(0);
+			auto header = heap.get(array);
+			u2 valueSlot = range ? 3 : 1;
+			auto value = wide ? static_cast<u8>(args.getLong(valueSlot)) : u8(args.getSlots()[valueSlot].ui4);
+			i4 fromIndex = range ? args.getInt(1) : 0;
+			i4 toIndex = range ? args.getInt(2) : static_cast<i4>(header->length);
+
+			if (fromIndex > toIndex) {
+				throw JvmException("IllegalArgumentException: fromIndex(" + std::to_string(fromIndex) + ") > toIndex(" + std::to_string(toIndex) + ")");
+			} else if (fromIndex < 0) {
+				throw outOfBounds("Array index", fromIndex, header->length);
+			} else if (u4(toIndex) > header->length) {
+				throw outOfBounds("Array index", toIndex, header->length);
+			}
+
+			auto size = Heap::elementSize(header->elementType);
+			auto first = heap.data<u1>(array) + u8(fromIndex) * size;
+			auto count = static_cast<size_t>(toIndex - fromIndex);
+			switch (size) {
+				case 1: std::memset(first, static_cast<u1>(value), count); break;
+				case 2: std::fill_n(reinterpret_cast<u2 *>(first), count, static_cast<u2>(value)); break;
+				case 4: std::fill_n(reinterpret_cast<u4 *>(first), count, static_cast<u4>(value)); break;
+				case 8: std::fill_n(reinterpret_cast<u8 *>(first), count, value); break;
+			}
+			if (header->elementType == T_REF) {
+				heap.markCards(first, first + count * size);
+			}
+			args.returnVoid();
+		}
+
+		/**
+		 * Arrays.equals of two primitive arrays
+		 */
+		void arraysEquals(Natives &natives, NativeArgs &args) {
+			auto &heap = natives.heap;
+			auto a = args.getRef(0);
+			auto b = args.getRef(1);
+			auto equal = a == b;
+
+			if (not equal && a != 0 && b != 0 && heap.get(a)->length == heap.get(b)->length) {
+				auto type = heap.get(a)->elementType;
+				auto length = heap.get(a)->length;
+				equal = std::memcmp(heap.data<u1>(a), heap.data<u1>(b), u8(length) * Heap::elementSize(type)) == 0;
+
+				// As floatToIntBits, every NaN is equal to every other NaN
+				if (not equal && type == T_FLOAT) {
+					auto x = heap.data<float>(a), y = heap.data<float>(b);
+					equal = std::equal(x, x + length, y, [](float i, float j) {
+						return std::memcmp(&i, &j, sizeof(float)) == 0 || (std::isnan(i) && std::isnan(j));
+					});
+				} else if (not equal && type == T_DOUBLE) {
+					auto x = heap.data<double>(a), y = heap.data<double>(b);
+					equal = std::equal(x, x + length, y, [](double i, double j) {
+						return std::memcmp(&i, &j, sizeof(double)) == 0 || (std::isnan(i) && std::isnan(j));
+					});
+				}
+			}
+
+			args.returnInt(equal ? 1 : 0);
+		}
+
+		// java/lang/Object, for the objects that inherit its methods
+
+		void objectEquals(Natives &, NativeArgs &args) {
+			args.returnInt(args.getNonNull(0) == args.getRef(1) ? 1 : 0);
+		}
+
+		void objectToString(Natives &natives, NativeArgs &args) {
+			auto text = natives.strings.objectText(args.getNonNull(0));
+			args.returnRef(natives.strings.create(std::u16string(text.begin(), text.end())));
+		}
+
+		// java/lang/String, the receiver is the first argument
+
+		void stringLength(Natives &natives, NativeArgs &args) {
+			args.returnInt(static_cast<i4>(natives.strings.length(args.getNonNull(0))));
+		}
+
+		void stringToString(Natives &, NativeArgs &args) {
+			args.returnRef(args.getNonNull(0));
+		}
+
+		void stringIsEmpty(Natives &natives, NativeArgs &args) {
+			args.returnInt(natives.strings.length(args.getNonNull(0)) == 0 ? 1 : 0);
+		}
+
+		void stringCharAt(Natives &natives, NativeArgs &args) {
+			args.returnInt(natives.strings.charAt(args.getNonNull(0), args.getInt(1)));
+		}
+
+		void stringHashCode(Natives &natives, NativeArgs &args) {
+			args.returnInt(natives.strings.hashCode(args.getNonNull(0)));
+		}
+
+		void stringEquals(Natives &natives, NativeArgs &args) {
+			auto string = args.getNonNull(0);
+			auto other = args.getRef(1);
+			auto equal = other != 0 && natives.heap.get(other)->klass == Strings::stringClass() && natives.strings.equals(string, other);
+			args.returnInt(equal ? 1 : 0);
+		}
+
+		void stringIntern(Natives &natives, NativeArgs &args) {
+			args.returnRef(natives.strings.intern(args.getNonNull(0)));
+		}
+
+		// java/lang/StringBuilder. The receiver and the arguments stay on the stack while the builder allocates,
+		// so they are updated if it collects
+
+		void builderInitCapacity(Natives &natives, NativeArgs &args) {
+			if (args.getInt(1) < 0) {
+				throw JvmException("NegativeArraySizeException: " + std::to_string(args.getInt(1)));
+			}
+			natives.strings.ensureCapacity(args.getRef(0), static_cast<u4>(args.getInt(1)));
+			args.returnVoid();
+		}
+
+		void builderInitText(Natives &natives, NativeArgs &args) {
+			natives.strings.append(args.getRef(0), args.getNonNull(1));
+			args.returnVoid();
+		}
+
+		void builderAppendObject(Natives &natives, NativeArgs &args) {
+			natives.strings.append(args.getNonNull(0), args.getRef(1));
+			args.returnRef(args.getRef(0)); // the builder, for the next append
+		}
+
+		void builderAppendChar(Natives &natives, NativeArgs &args) {
+			natives.strings.append(args.getNonNull(0), args.getChar(1));
+			args.returnRef(args.getRef(0));
+		}
+
+		/**
+		 * StringBuilder.append of a primitive other than char
+		 * @tparam type first character of the descriptor of the value
+		 */
+		template <char type>
+		void builderAppendValue(Natives &natives, NativeArgs &args) {
+			char text[NumberFormat::MAX_LENGTH];
+			auto length = Strings::valueOf(type, args.getSlots() + 1, text);
+			natives.strings.append(args.getNonNull(0), text, length);
+			args.returnRef(args.getRef(0));
+		}
+
+		void builderToString(Natives &natives, NativeArgs &args) {
+			args.returnRef(natives.strings.toString(args.getNonNull(0)));
+		}
+
+		void builderLength(Natives &natives, NativeArgs &args) {
+			args.returnInt(static_cast<i4>(natives.strings.length(args.getNonNull(0))));
+		}
+
+		void builderCharAt(Natives &natives, NativeArgs &args) {
+			args.returnInt(natives.strings.charAt(args.getNonNull(0), args.getInt(1)));
+		}
+
+		void builderSetLength(Natives &natives, NativeArgs &args) {
+			natives.strings.setLength(args.getNonNull(0), args.getInt(1));
+			args.returnVoid();
+		}
+
+		// java/lang/Math, static methods: the arguments start at slot 0
+
+		template <double (*f)(double)>
+		void mathDouble(Natives &, NativeArgs &args) {
+			args.returnDouble(f(args.getDouble(0)));
+		}
+
+		template <double (*f)(double, double)>
+		void mathDouble2(Natives &, NativeArgs &args) {
+			args.returnDouble(f(args.getDouble(0), args.getDouble(2)));
+		}
+
+		template <float (*f)(float, float)>
+		void mathFloat2(Natives &, NativeArgs &args) {
+			args.returnFloat(f(args.getFloat(0), args.getFloat(1)));
+		}
+
+		template <double (*f)(double, double, double)>
+		void mathFmaDouble(Natives &, NativeArgs &args) {
+			args.returnDouble(f(args.getDouble(0), args.getDouble(2), args.getDouble(4)));
+		}
+
+		template <float (*f)(float, float, float)>
+		void mathFmaFloat(Natives &, NativeArgs &args) {
+			args.returnFloat(f(args.getFloat(0), args.getFloat(1), args.getFloat(2)));
+		}
+
+#ifdef JVM_X86_INTRINSICS
+		// Compiled for the extension whatever the build flags, they are only registered when the CPU has it
+
+		__attribute__((target("sse2"))) double sqrtHardware(double x) {
+			auto v = _mm_set_sd(x);
+			return _mm_cvtsd_f64(_mm_sqrt_sd(v, v));
+		}
+
+		__attribute__((target("sse4.1"))) double floorHardware(double x) {
+			auto v = _mm_set_sd(x);
+			return _mm_cvtsd_f64(_mm_floor_sd(v, v));
+		}
+
+		__attribute__((target("sse4.1"))) double ceilHardware(double x) {
+			auto v = _mm_set_sd(x);
+			return _mm_cvtsd_f64(_mm_ceil_sd(v, v));
+		}
+
+		__attribute__((target("sse4.1"))) double rintHardware(double x) {
+			auto v = _mm_set_sd(x);
+			return _mm_cvtsd_f64(_mm_round_sd(v, v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+		}
+
+		__attribute__((target("fma"))) double fmaHardware(double a, double b, double c) {
+			return _mm_cvtsd_f64(_mm_fmadd_sd(_mm_set_sd(a), _mm_set_sd(b), _mm_set_sd(c)));
+		}
+
+		__attribute__((target("fma"))) float fmaFloatHardware(float a, float b, float c) {
+			return _mm_cvtss_f32(_mm_fmadd_ss(_mm_set_ss(a), _mm_set_ss(b), _mm_set_ss(c)));
+		}
+#endif
+
+		// Scalar fallbacks, std::rint rounds half to even as Math.rint in the default rounding mode
+
+		double sqrtScalar(double x) {
+			return std::sqrt(x);
+		}
+
+		double floorScalar(double x) {
+			return std::floor(x);
+		}
+
+		double ceilScalar(double x) {
+			return std::ceil(x);
+		}
+
+		double rintScalar(double x) {
+			return std::rint(x);
+		}
+
+		double fmaScalar(double a, double b, double c) {
+			return std::fma(a, b, c);
+		}
+
+		float fmaFloatScalar(float a, float b, float c) {
+			return std::fma(a, b, c);
+		}
+
+		/**
+		 * Math.cbrt, exact for the cubes of integers, which the C library may miss by an ulp
+		 */
+		double cbrtExact(double x) {
+			auto root = std::cbrt(x);
+			auto integer = std::rint(root);
+			return integer * integer * integer == x ? integer : root;
+		}
+
+		/**
+		 * Math.min of floating point numbers: NaN when either is NaN, and -0.0 is less than 0.0
+		 */
+		template <typename T>
+		T javaMin(T a, T b) {
+			if (std::isnan(a) || std::isnan(b)) {
+				return std::isnan(a) ? a : b;
+			} else if (a == 0 && b == 0) {
+				return std::signbit(a) ? a : b;
+			}
+			return a < b ? a : b;
+		}
+
+		template <typename T>
+		T javaMax(T a, T b) {
+			if (std::isnan(a) || std::isnan(b)) {
+				return std::isnan(a) ? a : b;
+			} else if (a == 0 && b == 0) {
+				return std::signbit(a) ? b : a;
+			}
+			return a > b ? a : b;
+		}
+
+		/**
+		 * Math.round: the closest integer, ties towards positive infinity, 0 for NaN and clamped to the range of the result
+		 * @tparam I int for a float, long for a double
+		 */
+		template <typename I, typename T>
+		I javaRound(T x) {
+			if (std::isnan(x)) {
+				return 0;
+			}
+
+			auto rounded = std::floor(x);
+			if (x - rounded >= T(0.5)) { // exact, x and its floor are less than 1 apart
+				rounded += 1;
+			}
+
+			auto limit = std::ldexp(T(1), std::numeric_limits<I>::digits); // 2^31 or 2^63, exactly
+			if (rounded >= limit) {
+				return std::numeric_limits<I>::max();
+			} else if (rounded < -limit) {
+				return std::numeric_limits<I>::min();
+			}
+			return static_cast<I>(rounded);
+		}
+
+		void mathAbsInt(Natives &, NativeArgs &args) {
+			auto x = args.getInt(0);
+			args.returnInt(x < 0 ? static_cast<i4>(0u - static_cast<u4>(x)) : x); // Integer.MIN_VALUE stays negative
+		}
+
+		void mathAbsLong(Natives &, NativeArgs &args) {
+			auto x = args.getLong(0);
+			args.returnLong(x < 0 ? static_cast<i8>(0ull - static_cast<u8>(x)) : x);
+		}
+
+		void mathAbsFloat(Natives &, NativeArgs &args) {
+			args.returnFloat(std::fabs(args.getFloat(0)));
+		}
+
+		template <bool max>
+		void mathMinMaxInt(Natives &, NativeArgs &args) {
+			auto a = args.getInt(0), b = args.getInt(1);
+			args.returnInt(max == (a > b) ? a : b);
+		}
+
+		template <bool max>
+		void mathMinMaxLong(Natives &, NativeArgs &args) {
+			auto a = args.getLong(0), b = args.getLong(2);
+			args.returnLong(max == (a > b) ? a : b);
+		}
+
+		void mathRoundDouble(Natives &, NativeArgs &args) {
+			args.returnLong(javaRound<i8>(args.getDouble(0)));
+		}
+
+		void mathRoundFloat(Natives &, NativeArgs &args) {
+			args.returnInt(javaRound<i4>(args.getFloat(0)));
+		}
+	}
+
+	u4 &NativeArgs::getNonNull(u2 slot) const {
+		if (slots[slot].ui4 == 0) {
+			throw JvmException("NullPointerException");
+		}
+		return slots[slot].ui4;
+	}
+
+	Natives::Natives(Heap &heap, Strings &strings, PrintStream &out) : heap(heap), strings(strings), out(out) {
+		add("java/lang/Object", "<init>", "()V", ignore);
+		add("java/lang/Object", "registerNatives", "()V", ignore);
+		add("java/lang/Object", "equals", "(Ljava/lang/Object;)Z", objectEquals);
+		add("java/lang/Object", "toString", "()Ljava/lang/String;", objectToString);
+
+		// System.out is allocated with the heap, by createObjects()
+		addField("java/lang/System", "out", 0);
+		outField = findField(Symbols::intern("java/lang/System"), Symbols::intern("out"));
+
+		const std::string stream = "java/io/PrintStream";
+		auto addPrint = [&](const std::string &descriptor, NativeMethod print, NativeMethod println) {
+			add(stream, "print", descriptor, print);
+			add(stream, "println", descriptor, println);
+		};
+		addPrint("(Ljava/lang/String;)V", printObject<false>, printObject<true>);
+		addPrint("(Ljava/lang/Object;)V", printObject<false>, printObject<true>);
+		addPrint("([C)V", printChars<false>, printChars<true>);
+		addPrint("(I)V", printInt<false>, printInt<true>);
+		addPrint("(C)V", printChar<false>, printChar<true>);
+		addPrint("(Z)V", printBoolean<false>, printBoolean<true>);
+		addPrint("(F)V", printFloat<false>, printFloat<true>);
+		addPrint("(J)V", printLong<false>, printLong<true>);
+		addPrint("(D)V", printDouble<false>, printDouble<true>);
+		add(stream, "println", "()V", endPrint<true>);
+		add(stream, "flush", "()V", flush);
+
+		add("java/lang/System", "arraycopy", "(Ljava/lang/Object;ILjava/lang/Object;II)V", arraycopy);
+
+		for (auto type : std::string("ZBCSIJFD")) {
+			auto wide = type == 'J' || type == 'D';
+			auto array = std::string("[") + type;
+			add("java/util/Arrays", "fill", "(" + array + type + ")V", wide ? arraysFill<true, false> : arraysFill<false, false>);
+			add("java/util/Arrays", "fill", "(" + array + "II" + type + ")V", wide ? arraysFill<true, true> : arraysFill<false, true>);
+			add("java/util/Arrays", "equals", "(" + array + array + ")Z", arraysEquals);
+		}
+		add("java/util/Arrays", "fill", "([Ljava/lang/Object;Ljava/lang/Object;)V", arraysFill<false, false>);
+		add("java/util/Arrays", "fill", "([Ljava/lang/Object;IILjava/lang/Object;)V", arraysFill<false, true>);
+
+		const std::string string = "java/lang/String";
+		add(string, "length", "()I", stringLength);
+		add(string, "isEmpty", "()Z", stringIsEmpty);
+		add(string, "charAt", "(I)C", stringCharAt);
+		add(string, "hashCode", "()I", stringHashCode);
+		add(string, "equals", "(Ljava/lang/Object;)Z", stringEquals);
+		add(string, "intern", "()Ljava/lang/String;", stringIntern);
+		add(string, "toString", "()Ljava/lang/String;", stringToString);
+
+		const std::string builder = "java/lang/StringBuilder";
+		const std::string returnsBuilder = ")Ljava/lang/StringBuilder;";
+		add(builder, "<init>", "()V", ignore); // the buffer is allocated by the first append
+		add(builder, "<init>", "(I)V", builderInitCapacity);
+		add(builder, "<init>", "(Ljava/lang/String;)V", builderInitText);
+		add(builder, "<init>", "(Ljava/lang/CharSequence;)V", builderInitText);
+		add(builder, "append", "(Ljava/lang/String;" + returnsBuilder, builderAppendObject);
+		add(builder, "append", "(Ljava/lang/Object;" + returnsBuilder, builderAppendObject);
+		add(builder, "append", "(Ljava/lang/CharSequence;" + returnsBuilder, builderAppendObject);
+		add(builder, "append", "(Ljava/lang/StringBuffer;" + returnsBuilder, builderAppendObject);
+		add(builder, "append", "(C" + returnsBuilder, builderAppendChar);
+		add(builder, "append", "(Z" + returnsBuilder, builderAppendValue<'Z'>);
+		add(builder, "append", "(I" + returnsBuilder, builderAppendValue<'I'>);
+		add(builder, "append", "(J" + returnsBuilder, builderAppendValue<'J'>);
+		add(builder, "append", "(F" + returnsBuilder, builderAppendValue<'F'>);
+		add(builder, "append", "(D" + returnsBuilder, builderAppendValue<'D'>);
+		add(builder, "toString", "()Ljava/lang/String;", builderToString);
+		add(builder, "length", "()I", builderLength);
+		add(builder, "charAt", "(I)C", builderCharAt);
+		add(builder, "setLength", "(I)V", builderSetLength);
+
+		// Math runs inline at the call, with the instructions of the CPU when it has them
+		const std::string math = "java/lang/Math";
+		auto &cpu = CpuFeatures::get();
+		NativeMethod sqrt = mathDouble<sqrtScalar>, floor = mathDouble<floorScalar>, ceil = mathDouble<ceilScalar>, rint = mathDouble<rintScalar>;
+		NativeMethod fma = mathFmaDouble<fmaScalar>, fmaFloat = mathFmaFloat<fmaFloatScalar>;
+#ifdef JVM_X86_INTRINSICS
+		if (cpu.sse2) {
+			sqrt = mathDouble<sqrtHardware>;
+		}
+		if (cpu.sse41) {
+			floor = mathDouble<floorHardware>;
+			ceil = mathDouble<ceilHardware>;
+			rint = mathDouble<rintHardware>;
+		}
+		if (cpu.fma) {
+			fma = mathFmaDouble<fmaHardware>;
+			fmaFloat = mathFmaFloat<fmaFloatHardware>;
+		}
+#else
+		(void) cpu;
+#endif
+		add(math, "sqrt", "(D)D", sqrt);
+		add(math, "floor", "(D)D", floor);
+		add(math, "ceil", "(D)D", ceil);
+		add(math, "rint", "(D)D", rint);
+		add(math, "fma", "(DDD)D", fma);
+		add(math, "fma", "(FFF)F", fmaFloat);
+		add(math, "cbrt", "(D)D", mathDouble<cbrtExact>);
+		add(math, "sin", "(D)D", mathDouble<std::sin>);
+		add(math, "cos", "(D)D", mathDouble<std::cos>);
+		add(math, "tan", "(D)D", mathDouble<std::tan>);
+		add(math, "asin", "(D)D", mathDouble<std::asin>);
+		add(math, "acos", "(D)D", mathDouble<std::acos>);
+		add(math, "atan", "(D)D", mathDouble<std::atan>);
+		add(math, "exp", "(D)D", mathDouble<std::exp>);
+		add(math, "log", "(D)D", mathDouble<std::log>);
+		add(math, "log10", "(D)D", mathDouble<std::log10>);
+		add(math, "atan2", "(DD)D", mathDouble2<std::atan2>);
+		add(math, "pow", "(DD)D", mathDouble2<std::pow>);
+		add(math, "hypot", "(DD)D", mathDouble2<std::hypot>);
+		add(math, "abs", "(I)I", mathAbsInt);
+		add(math, "abs", "(J)J", mathAbsLong);
+		add(math, "abs", "(F)F", mathAbsFloat);
+		add(math, "abs", "(D)D", mathDouble<std::fabs>);
+		add(math, "min", "(II)I", mathMinMaxInt<false>);
+		add(math, "max", "(II)I", mathMinMaxInt<true>);
+		add(math, "min", "(JJ)J", mathMinMaxLong<false>);
+		add(math, "max", "(JJ)J", mathMinMaxLong<true>);
+		add(math, "min", "(FF)F", mathFloat2<javaMin<float>>);
+		add(math, "max", "(FF)F", mathFloat2<javaMax<float>>);
+		add(math, "min", "(DD)D", mathDouble2<javaMin<double>>);
+		add(math, "max", "(DD)D", mathDouble2<javaMax<double>>);
+		add(math, "round", "(D)J", mathRoundDouble);
+		add(math, "round", "(F)I", mathRoundFloat);
+	}
+
+	void Natives::add(const std::string &klass, const std::string &name, const std::string &descriptor, NativeMethod method) {
+		methods[std::make_tuple(Symbols::intern(klass), Symbols::intern(name), Symbols::intern(descriptor))] = method;
+	}
+
+	void Natives::addField(const std::string &klass, const std::string &name, u8 value) {
+		fields[std::make_pair(Symbols::intern(klass), Symbols::intern(name))] = value;
+	}
+
+	NativeMethod Natives::find(u4 klass, u4 name, u4 descriptor) const {
+		auto method = methods.find(std::make_tuple(klass, name, descriptor));
+		return method == methods.end() ? nullptr : method->second;
+	}
+
+	void Natives::createObjects() {
+		systemOut = heap.newObject(0, Symbols::intern("java/io/PrintStream"));
+		*outField = systemOut;
+	}
+
+	void Natives::forwardRoots() {
+		systemOut = heap.forward(systemOut);
+		*outField = systemOut;
+	}
+
+	u8 *Natives::findField(u4 klass, u4 name) {
+		auto field = fields.find(std::make_pair(klass, name));
+		return field == fields.end() ? nullptr : &field->second;
+	}
+
+	void Natives::ignore(Natives &, NativeArgs &args) {
+		args.returnVoid();
+	}
+
+}
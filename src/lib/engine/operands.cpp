@@ -1,87 +1,100 @@
-#include <util/JvmException.hpp>
 #include "engine/operands.hpp"
 #include "util/JvmException.hpp"
 
 namespace jvm {
 
+	void Operands::bind(op4 *values, u1 *types, u2 size) {
+		this->values = values;
+		this->types = types;
+		depth = 0;
+		maxSize = size;
+	}
+
+	// Release builds (NDEBUG) trust the load-time verifier: no bounds checks and no type tags
+
+	void Operands::resize(u2 count) {
+#ifndef NDEBUG
+		if (count > maxSize) {
+			throw JvmException("Maximum operands stack exceeded");
+		}
+#endif
+		depth = count;
+	}
+
+	void Operands::drop(u2 count) {
+#ifndef NDEBUG
+		if (depth < count) {
+			throw JvmException("Not enough operands on stack");
+		}
+#endif
+		depth -= count;
+	}
+
 	Data Operands::pop4() {
+#ifndef NDEBUG
 		if (empty()) {
 			throw JvmException("Not enough operands on stack");
 		}
-		auto data = top(); pop();
-		return data;
+		depth--;
+		return { .type = types[depth], .value = values[depth] };
+#else
+		depth--;
+		return { .type = T_INT, .value = values[depth] };
+#endif
 	}
 
 	BigData Operands::pop8() {
-		if (size() < 2) {
+#ifndef NDEBUG
+		if (depth < 2) {
 			throw JvmException("Not enough operands on stack");
 		}
+#endif
 
-		Data high = top(); pop();
-		Data low  = top(); pop();
+		depth -= 2;
 
-		auto res = Converter::to_op8(low.value, high.value);
-		BigData bigData { .type = low.type, .value =  res };
+		auto res = Converter::to_op8(values[depth], values[depth + 1]);
+#ifndef NDEBUG
+		BigData bigData { .type = types[depth], .value =  res };
+#else
+		BigData bigData { .type = T_LONG, .value =  res };
+#endif
 
 		return bigData;
 	}
 
 	void Operands::push4(u1 type, u4 value) {
 		op4 bytes = { .ui4 = value };
-		Data data = { .type = type, .value = bytes };
-
-		push(data);
-
-		if (size() > maxSize) {
-			throw JvmException("Maximum operands stack exceeded");
-		}
+		push4(type, bytes);
 	}
 
 	void Operands::push4(u1 type, op4 value) {
-		Data data = { .type = type, .value = value };
-
-		push(data);
-
-		if (size() > maxSize) {
+#ifndef NDEBUG
+		if (depth + 1 > maxSize) {
 			throw JvmException("Maximum operands stack exceeded");
 		}
+
+		types[depth] = type;
+#endif
+		values[depth] = value;
+		depth++;
 	}
 
 	void Operands::push8(u1 type, u8 value) {
-		op4 high_bytes, low_bytes;
-
-		high_bytes.ui4 = static_cast<u4>(value >> 32ul);
-		low_bytes.ui4  = static_cast<u4>(value & ((1ul << 32ul) - 1));
-
-		Data data1 { .type = type, .value = low_bytes };
-		Data data2 { .type = type, .value = high_bytes };
-
-		push(data1);
-		push(data2);
-
-		if (size() > maxSize) {
-			throw JvmException("Maximum operands stack exceeded");
-		}
+		op8 bytes;
+		bytes.ull = value;
+		push8(type, bytes);
 	}
 
 	void Operands::push8(u1 type, op8 value) {
-		op4 low, high;
-
-		std::tie(low, high) = Converter::to_op4(value);
-
-		Data data1 { .type = type, .value = low };
-		Data data2 { .type = type, .value = high };
-
-		push(data1);
-		push(data2);
-
-		if (size() > maxSize) {
+#ifndef NDEBUG
+		if (depth + 2 > maxSize) {
 			throw JvmException("Maximum operands stack size exceeded");
 		}
-	}
 
-	void Operands::setSize(u2 size) {
-		maxSize = size;
+		types[depth] = types[depth + 1] = type;
+#endif
+		std::tie(values[depth], values[depth + 1]) = Converter::to_op4(value);
+		depth += 2;
 	}
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,107 @@
+#include <cstring>
+
+#include "engine/print_stream.hpp"
+#include "util/number_format.hpp"
+
+namespace jvm {
+
+	PrintStream::PrintStream(std::ostream &os) : os(os), buffer(BUFFER_SIZE) {
+	}
+
+	PrintStream::~PrintStream() {
+		flush();
+	}
+
+	void PrintStream::write(const char *text, size_t length) {
+		if (length > buffer.size() - used) {
+			drain();
+			if (length > buffer.size()) { // too large to be buffered
+				os.write(text, static_cast<std::streamsize>(length));
+				return;
+			}
+		}
+
+		std::memcpy(buffer.data() + used, text, length);
+		used += length;
+	}
+
+	void PrintStream::printLatin1(const u1 *chars, u4 length) {
+		for (u4 i = 0; i < length; i++) {
+			if (chars[i] < 0x80) {
+				put(static_cast<char>(chars[i]));
+			} else {
+				putCodePoint(chars[i]);
+			}
+		}
+	}
+
+	void PrintStream::printUtf16(const u2 *units, u4 length) {
+		for (u4 i = 0; i < length; i++) {
+			u4 c = units[i];
+
+			if (c >= 0xD800 && c < 0xE000) { // a surrogate pair is one code point
+				if (c < 0xDC00 && i + 1 < length && units[i + 1] >= 0xDC00 && units[i + 1] < 0xE000) {
+					c = 0x10000 + ((c - 0xD800) << 10) + (units[++i] - 0xDC00u);
+				} else {
+					c = '?';
+				}
+			}
+
+			putCodePoint(c);
+		}
+	}
+
+	void PrintStream::printLong(i8 value) {
+		char text[NumberFormat::MAX_LENGTH];
+		write(text, NumberFormat::writeLong(value, text));
+	}
+
+	void PrintStream::printFloat(float value) {
+		char text[NumberFormat::MAX_LENGTH];
+		write(text, NumberFormat::writeFloat(value, text));
+	}
+
+	void PrintStream::printDouble(double value) {
+		char text[NumberFormat::MAX_LENGTH];
+		write(text, NumberFormat::writeDouble(value, text));
+	}
+
+	void PrintStream::printBoolean(bool value) {
+		if (value) {
+			write("true", 4);
+		} else {
+			write("false", 5);
+		}
+	}
+
+	void PrintStream::flush() {
+		drain();
+		os.flush();
+	}
+
+	void PrintStream::drain() {
+		if (used > 0) {
+			os.write(buffer.data(), static_cast<std::streamsize>(used));
+			used = 0;
+		}
+	}
+
+	void PrintStream::putCodePoint(u4 c) {
+		if (c < 0x80) {
+			put(static_cast<char>(c));
+		} else if (c < 0x800) {
+			put(static_cast<char>(0xC0 | (c >> 6)));
+			put(static_cast<char>(0x80 | (c & 0x3F)));
+		} else if (c < 0x10000) {
+			put(static_cast<char>(0xE0 | (c >> 12)));
+			put(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+			put(static_cast<char>(0x80 | (c & 0x3F)));
+		} else {
+			put(static_cast<char>(0xF0 | (c >> 18)));
+			put(static_cast<char>(0x80 | ((c >> 12) & 0x3F)));
+			put(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+			put(static_cast<char>(0x80 | (c & 0x3F)));
+		}
+	}
+
+}
@@ -0,0 +1,78 @@
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+
+#include "engine/sequence_profiler.hpp"
+
+namespace jvm {
+
+	void SequenceProfiler::record(Instruction *instruction) {
+		if (instruction != expected) {
+			length = 0;
+		}
+
+		// A superinstruction already runs its whole sequence, the next instruction is the one after it
+		auto super = CodeInfo::superinstruction(instruction->opcode);
+		expected = instruction;
+		for (size_t i = 0; i < (super != nullptr ? super->sequence.size() : 1); i++) {
+			expected = expected->next();
+		}
+
+		if (length == MAX_LENGTH) {
+			std::copy(window + 1, window + MAX_LENGTH, window);
+			length--;
+		}
+		window[length++] = CodeInfo::family(instruction->opcode);
+
+		u8 key = 0;
+		for (u1 i = length; i > 0; i--) { // every sequence ending here, the shortest first
+			key |= u8(window[i - 1]) << (8 * (length - i));
+			if (length - i > 0) {
+				counts[key | (u8(length - i + 1) << 32)]++;
+			}
+		}
+
+		if (super != nullptr || endsSequence(window[length - 1])) {
+			length = 0;
+		}
+	}
+
+	void SequenceProfiler::printStats(std::ostream &os, u4 top) const {
+		std::vector<std::pair<u8, u8>> sequences(counts.begin(), counts.end());
+
+		// Fusing a sequence of n instructions saves n - 1 dispatches each time it runs
+		auto saved = [](const std::pair<u8, u8> &sequence) {
+			return sequence.second * ((sequence.first >> 32) - 1);
+		};
+		std::sort(sequences.begin(), sequences.end(), [&](const std::pair<u8, u8> &a, const std::pair<u8, u8> &b) {
+			return saved(a) != saved(b) ? saved(a) > saved(b) : a.first < b.first;
+		});
+
+		os << "sequências de bytecodes mais executadas (despachos economizados, execuções, sequência):" << std::endl;
+		for (size_t i = 0; i < sequences.size() && i < top; i++) {
+			auto sequenceLength = static_cast<u1>(sequences[i].first >> 32);
+			std::vector<u1> families;
+			std::string text;
+			for (u1 j = sequenceLength; j > 0; j--) {
+				families.push_back(static_cast<u1>(sequences[i].first >> (8 * (j - 1))));
+				text += (text.empty() ? "" : " ") + CodeInfo::mnemonic(families.back());
+			}
+
+			os << std::setw(14) << saved(sequences[i]) << std::setw(14) << sequences[i].second << "  " << text;
+			for (auto &super : CodeInfo::superinstructions()) {
+				if (super.sequence == families) {
+					os << "  => " << super.name;
+				}
+			}
+			os << std::endl;
+		}
+	}
+
+	bool SequenceProfiler::endsSequence(u1 opcode) {
+		return (opcode >= 153 && opcode <= 177)     // branches, switches and returns
+		       || (opcode >= 182 && opcode <= 186)  // invokes
+		       || opcode == 191                     // athrow
+		       || (opcode >= 198 && opcode <= 201); // ifnull, ifnonnull, goto_w, jsr_w
+	}
+
+}
@@ -0,0 +1,377 @@
+#include <cstring>
+#include <sstream>
+
+#include "engine/strings.hpp"
+#include "util/converter.hpp"
+#include "util/number_format.hpp"
+#include "util/JvmException.hpp"
+
+namespace jvm {
+
+	namespace {
+		/**
+		 * hashCode of java/lang/String: s[0]*31^(n-1) + ... + s[n-1], wrapping as an int
+		 */
+		template <typename T>
+		i4 hashOf(const T *chars, u4 length) {
+			u4 hash = 0;
+			for (u4 i = 0; i < length; i++) {
+				hash = 31 * hash + chars[i];
+			}
+			return static_cast<i4>(hash);
+		}
+	}
+
+	Strings::Strings(Heap &heap) : heap(heap) {
+		heap.setReferences(builderClass(), {offsetof(StringBuilderObject, value)});
+	}
+
+	u4 Strings::stringClass() {
+		static const u4 symbol = Symbols::intern("java/lang/String");
+		return symbol;
+	}
+
+	u4 Strings::builderClass() {
+		static const u4 symbol = Symbols::intern("java/lang/StringBuilder");
+		return symbol;
+	}
+
+	u4 Strings::create(u4 length, u1 coder) {
+		if (length > MAX_LENGTH) {
+			throw JvmException("OutOfMemoryError: String length " + std::to_string(length));
+		}
+
+		auto ref = heap.newObject(static_cast<u4>(sizeof(StringObject)) + (length << coder), stringClass());
+		auto string = get(ref);
+		string->length = length;
+		string->coder = coder;
+		return ref;
+	}
+
+	u4 Strings::create(const std::u16string &chars) {
+		auto length = static_cast<u4>(chars.size());
+		auto latin = std::all_of(chars.begin(), chars.end(), [](char16_t c) { return c < 0x100; });
+
+		auto ref = create(length, latin ? StringObject::LATIN1 : StringObject::UTF16);
+		if (latin) {
+			std::copy(chars.begin(), chars.end(), latin1(ref));
+		} else {
+			std::copy(chars.begin(), chars.end(), utf16(ref));
+		}
+		return ref;
+	}
+
+	u4 Strings::literal(RuntimeEntry &entry) {
+		return pool[literalIndex(entry)];
+	}
+
+	u4 Strings::literalIndex(RuntimeEntry &entry) {
+		if (entry.value.ull == 0) { // the index in the pool plus one, once resolved
+			auto text = decode(Symbols::get(entry.text));
+			auto hash = hashOf(text.data(), static_cast<u4>(text.size()));
+			auto index = find(text, hash);
+
+			if (index < 0) {
+				auto ref = create(text);
+				get(ref)->hash = hash;
+				get(ref)->hashIsZero = hash == 0;
+
+				index = static_cast<i4>(pool.size());
+				pool.push_back(ref);
+				byHash.emplace(hash, static_cast<u4>(index));
+			}
+
+			entry.value.ull = static_cast<u8>(index) + 1;
+		}
+
+		return static_cast<u4>(entry.value.ull - 1);
+	}
+
+	u4 Strings::intern(u4 ref) {
+		auto hash = hashCode(ref);
+		auto index = find(chars(ref), hash);
+
+		if (index >= 0) {
+			return pool[static_cast<u4>(index)];
+		}
+
+		byHash.emplace(hash, static_cast<u4>(pool.size()));
+		pool.push_back(ref);
+		return ref;
+	}
+
+	u4 Strings::newBuilder() {
+		return heap.newObject(sizeof(StringBuilderObject), builderClass());
+	}
+
+	void Strings::ensureCapacity(u4 &builder, u4 capacity) {
+		auto count = this->builder(builder)->count;
+		if (capacity > count) {
+			appendSpace(builder, capacity - count, StringObject::LATIN1);
+			this->builder(builder)->count = count;
+		}
+	}
+
+	void Strings::append(u4 &builder, u4 &value) {
+		if (value == 0) {
+			append(builder, "null", 4);
+			return;
+		} else if (not isText(value)) {
+			auto text = objectText(value);
+			append(builder, text.data(), static_cast<u4>(text.size()));
+			return;
+		}
+
+		auto length = view(value).length;
+		auto to = appendSpace(builder, length, view(value).coder);
+
+		auto chars = view(value); // the builder may be the value, its new buffer holds its old characters
+		copyChars(chars.data, chars.coder, length, to, this->builder(builder)->coder);
+	}
+
+	void Strings::append(u4 &builder, const char *text, u4 length) {
+		auto to = appendSpace(builder, length, StringObject::LATIN1);
+		copyChars(reinterpret_cast<const u1 *>(text), StringObject::LATIN1, length, to, this->builder(builder)->coder);
+	}
+
+	void Strings::append(u4 &builder, u2 c) {
+		auto to = appendSpace(builder, 1, c < 0x100 ? StringObject::LATIN1 : StringObject::UTF16);
+		if (this->builder(builder)->coder == StringObject::LATIN1) {
+			*to = static_cast<u1>(c);
+		} else {
+			*reinterpret_cast<u2 *>(to) = c;
+		}
+	}
+
+	void Strings::setLength(u4 &builder, i4 length) {
+		if (length < 0) {
+			throw JvmException("StringIndexOutOfBoundsException: String index out of range: " + std::to_string(length));
+		}
+
+		auto count = this->builder(builder)->count;
+		if (static_cast<u4>(length) > count) {
+			auto to = appendSpace(builder, static_cast<u4>(length) - count, StringObject::LATIN1);
+			std::memset(to, 0, (static_cast<u4>(length) - count) << this->builder(builder)->coder);
+		}
+		this->builder(builder)->count = static_cast<u4>(length);
+	}
+
+	u4 Strings::toString(u4 &builder) {
+		auto chars = view(builder);
+		auto coder = chars.coder;
+
+		// Inflated builders may only hold Latin-1 characters again
+		if (coder == StringObject::UTF16) {
+			auto units = reinterpret_cast<const u2 *>(chars.data);
+			if (std::all_of(units, units + chars.length, [](u2 c) { return c < 0x100; })) {
+				coder = StringObject::LATIN1;
+			}
+		}
+
+		auto ref = create(chars.length, coder);
+		chars = view(builder);
+		if (coder == chars.coder) {
+			std::memcpy(latin1(ref), chars.data, chars.length << coder);
+		} else {
+			auto units = reinterpret_cast<const u2 *>(chars.data);
+			std::copy(units, units + chars.length, latin1(ref));
+		}
+		return ref;
+	}
+
+	u2 Strings::charAt(u4 ref, i4 index) const {
+		auto chars = view(ref);
+
+		if (static_cast<u4>(index) >= chars.length) {
+			throw JvmException("StringIndexOutOfBoundsException: Index " + std::to_string(index) + " out of bounds for length " + std::to_string(chars.length));
+		}
+
+		return chars.coder == StringObject::LATIN1 ? chars.data[index] : reinterpret_cast<const u2 *>(chars.data)[index];
+	}
+
+	void Strings::getChars(u4 ref, u1 *to, u1 coder) const {
+		auto chars = view(ref);
+		copyChars(chars.data, chars.coder, chars.length, to, coder);
+	}
+
+	std::string Strings::objectText(u4 ref) const {
+		auto object = heap.get(ref);
+		std::string name;
+
+		if (object->kind == T_ARRAY) {
+			static const char descriptors[] = "????ZCFDBSIJ";
+			name = object->elementType == T_REF ? "[L" + Symbols::get(object->klass) + ";" : std::string("[") + descriptors[object->elementType];
+		} else {
+			name = Symbols::get(object->klass);
+		}
+
+		std::replace(name.begin(), name.end(), '/', '.');
+
+		std::ostringstream text;
+		text << name << '@' << std::hex << ref;
+		return text.str();
+	}
+
+	u4 Strings::valueOf(char type, const op4 *slots, char *out) {
+		switch (type) {
+			case 'Z':
+				if (slots[0].i4) {
+					std::memcpy(out, "true", 4);
+					return 4;
+				}
+				std::memcpy(out, "false", 5);
+				return 5;
+			case 'J':
+				return NumberFormat::writeLong(Converter::to_op8(slots[0], slots[1]).ll, out);
+			case 'F':
+				return NumberFormat::writeFloat(slots[0].f, out);
+			case 'D':
+				return NumberFormat::writeDouble(Converter::to_op8(slots[0], slots[1]).lf, out);
+			default:
+				return NumberFormat::writeLong(slots[0].i4, out);
+		}
+	}
+
+	void Strings::copyChars(const u1 *from, u1 fromCoder, u4 length, u1 *to, u1 toCoder) {
+		if (length == 0) {
+			return;
+		} else if (fromCoder == toCoder) {
+			std::memmove(to, from, length << toCoder);
+		} else {
+			std::copy(from, from + length, reinterpret_cast<u2 *>(to));
+		}
+	}
+
+	i4 Strings::hashCode(u4 ref) {
+		auto string = get(ref);
+
+		if (string->hash == 0 && not string->hashIsZero) {
+			string->hash = string->coder == StringObject::LATIN1 ? hashOf(latin1(ref), string->length) : hashOf(utf16(ref), string->length);
+			string->hashIsZero = string->hash == 0;
+		}
+
+		return string->hash;
+	}
+
+	bool Strings::equals(u4 a, u4 b) const {
+		if (a == b) {
+			return true;
+		}
+
+		auto x = get(a), y = get(b);
+		if (x->length != y->length) {
+			return false;
+		}
+
+		if (x->coder == y->coder) {
+			return std::memcmp(x + 1, y + 1, x->length << x->coder) == 0;
+		}
+
+		return chars(a) == chars(b);
+	}
+
+	void Strings::print(PrintStream &out, u4 ref) const {
+		auto chars = view(ref);
+
+		if (chars.coder == StringObject::LATIN1) {
+			out.printLatin1(chars.data, chars.length);
+		} else {
+			out.printUtf16(reinterpret_cast<const u2 *>(chars.data), chars.length);
+		}
+	}
+
+	void Strings::forwardRoots() {
+		for (auto &ref : pool) {
+			ref = heap.forward(ref);
+		}
+	}
+
+	std::u16string Strings::decode(const std::string &text) {
+		std::u16string chars;
+		chars.reserve(text.size());
+
+		for (size_t i = 0; i < text.size(); i++) {
+			auto c = static_cast<u1>(text[i]);
+
+			if (c < 0x80) {
+				chars += static_cast<char16_t>(c);
+			} else if ((c & 0xE0) == 0xC0 && i + 1 < text.size()) { // also the null character, as 0xC0 0x80
+				chars += static_cast<char16_t>(((c & 0x1F) << 6) | (text[i + 1] & 0x3F));
+				i += 1;
+			} else if ((c & 0xF0) == 0xE0 && i + 2 < text.size()) { // supplementary characters are two of these, a surrogate pair
+				chars += static_cast<char16_t>(((c & 0x0F) << 12) | ((text[i + 1] & 0x3F) << 6) | (text[i + 2] & 0x3F));
+				i += 2;
+			} else {
+				throw JvmException("ClassFormatError: malformed modified UTF-8 string");
+			}
+		}
+
+		return chars;
+	}
+
+	i4 Strings::find(const std::u16string &text, i4 hash) const {
+		auto range = byHash.equal_range(hash);
+
+		for (auto candidate = range.first; candidate != range.second; ++candidate) {
+			if (chars(pool[candidate->second]) == text) {
+				return static_cast<i4>(candidate->second);
+			}
+		}
+
+		return -1;
+	}
+
+	std::u16string Strings::chars(u4 ref) const {
+		auto chars = view(ref);
+
+		if (chars.coder == StringObject::LATIN1) {
+			return std::u16string(chars.data, chars.data + chars.length);
+		}
+
+		auto units = reinterpret_cast<const u2 *>(chars.data);
+		return std::u16string(units, units + chars.length);
+	}
+
+	Strings::Chars Strings::view(u4 ref) const {
+		if (heap.get(ref)->klass == builderClass()) {
+			auto builder = this->builder(ref);
+			return Chars { builder->value == 0 ? nullptr : heap.data<u1>(builder->value), builder->count, builder->coder };
+		}
+
+		auto string = get(ref);
+		return Chars { latin1(ref), string->length, string->coder };
+	}
+
+	u1 *Strings::appendSpace(u4 &builder, u4 more, u1 coder) {
+		auto object = this->builder(builder);
+		u8 needed = u8(object->count) + more;
+		coder = std::max(coder, object->coder);
+
+		if (needed > MAX_LENGTH) {
+			throw JvmException("OutOfMemoryError: StringBuilder length " + std::to_string(needed));
+		}
+
+		u8 capacity = object->value == 0 ? 0 : heap.get(object->value)->length >> object->coder;
+		if (needed > capacity || coder != object->coder) {
+			// Doubling keeps the appends amortized constant time
+			if (needed > capacity) {
+				capacity = std::min<u8>(std::max<u8>(needed, capacity == 0 ? 16 : 2 * capacity + 2), MAX_LENGTH);
+			}
+
+			auto value = heap.newArray(T_BYTE, static_cast<i4>(capacity << coder)); // may collect
+			object = this->builder(builder);
+			if (object->value != 0) {
+				copyChars(heap.data<u1>(object->value), object->coder, object->count, heap.data<u1>(value), coder);
+			}
+
+			object->value = value;
+			object->coder = coder;
+			heap.markCard(&object->value);
+		}
+
+		auto to = heap.data<u1>(object->value) + (u8(object->count) << object->coder);
+		object->count += more;
+		return to;
+	}
+
+}
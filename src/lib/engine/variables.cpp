@@ -2,16 +2,8 @@
 
 namespace jvm {
 
-	// TODO: implement this
-//	Variables::Variables(uint32_t n) {
-//		vec = new op4[n];
-//	}
-
-	Variables::Variables() {}
-
-	Variables::~Variables() {
-		// TODO: implement this
-		//delete[] vec;
+	void Variables::bind(op4 *vec) {
+		this->vec = vec;
 	}
 
 	op4 Variables::get4(u4 idx) {
@@ -42,8 +34,4 @@ namespace jvm {
 		std::tie(vec[idx], vec[idx + 1]) = Converter::to_op4(aux);
 	}
 
-	void Variables::setSize(u4 size) {
-		vec.resize(size);
-	}
-
 };
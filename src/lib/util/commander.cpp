@@ -1,11 +1,17 @@
 #include "util/commander.hpp"
+#include "class_loader/code_info.hpp"
+#include "engine/heap.hpp"
 
 #include <iostream>
 #include <cstdlib>
+#include <thread>
+#include <algorithm>
+#include <limits>
 
 namespace jvm {
     CommandState Commander::parse(const std::vector<std::string>& commands) {
         CommandState state = {0};
+        state.youngMegabytes = -1;
         for (const auto &command : commands) {
             if (command == "--help"||  command == "-h") {
                 // if it is help, than show it and finish the program
@@ -15,6 +21,38 @@ namespace jvm {
                 state.shouldDescribe = true;
             } else if (command == "--execute" || command == "-r") {
                 state.shouldRun = true;
+            } else if (command == "--threaded" || command == "-t") {
+                state.threaded = true;
+            } else if (command == "--bench" || command == "-b") {
+                state.benchmark = true;
+            } else if (command == "--prefetch" || command == "-p") {
+                state.prefetch = true;
+                state.prefetchWorkers = std::max(1u, std::thread::hardware_concurrency());
+            } else if (command.compare(0, 11, "--prefetch=") == 0) {
+                state.prefetch = true;
+                state.prefetchWorkers = static_cast<unsigned>(Commander::parseNumber(command, 11, 1024));
+            } else if (command == "--gc-stats" || command == "-g") {
+                state.gcStats = true;
+            } else if (command.compare(0, 7, "--heap=") == 0) {
+                state.heapMegabytes = Commander::parseNumber(command, 7, Heap::MAX_CAPACITY >> 20);
+                if (state.heapMegabytes == 0) {
+                    throw JvmException("O heap precisa de pelo menos 1 MB: use --heap=N, com N > 0");
+                }
+            } else if (command.compare(0, 8, "--young=") == 0) {
+                state.youngMegabytes = static_cast<long>(Commander::parseNumber(command, 8, Heap::MAX_CAPACITY >> 20));
+            } else if (command == "--fuse" || command == "-f") {
+                state.superinstructions.clear();
+                for (const auto &super : CodeInfo::superinstructions()) {
+                    state.superinstructions.push_back(super.opcode);
+                }
+            } else if (command.compare(0, 7, "--fuse=") == 0) {
+                state.superinstructions = Commander::parseSuperinstructions(command.substr(7));
+            } else if (command == "--sequences" || command == "-s") {
+                state.sequences = 20;
+            } else if (command.compare(0, 12, "--sequences=") == 0) {
+                state.sequences = static_cast<unsigned>(Commander::parseNumber(command, 12, std::numeric_limits<unsigned>::max()));
+            } else if (command == "--registers" || command == "-R") {
+                state.registers = true;
             } else if (state.filename.empty()) {
                 state.filename = command;
             } else {
@@ -22,6 +60,13 @@ namespace jvm {
             }
         }
 
+        // Without --young=, the default nursery shrinks to fit a small heap
+        auto heapMegabytes = state.heapMegabytes > 0 ? state.heapMegabytes : Heap::DEFAULT_CAPACITY >> 20;
+        if (state.youngMegabytes >= 0 && static_cast<unsigned long>(state.youngMegabytes) >= heapMegabytes) {
+            throw JvmException("A geração jovem (" + std::to_string(state.youngMegabytes) + " MB) precisa ser menor que o heap ("
+                    + std::to_string(heapMegabytes) + " MB): use --young=N, com N < --heap");
+        }
+
         // Deal with missing commands
         if (state.filename.empty()) {
             state.filename = Commander::get_name();
@@ -34,12 +79,54 @@ namespace jvm {
         return state;
     }
 
+    unsigned long Commander::parseNumber(const std::string &command, size_t prefix, unsigned long max) {
+        auto value = command.substr(prefix);
+        if (value.empty() || value.size() > 10 || value.find_first_not_of("0123456789") != std::string::npos
+                || std::stoul(value) > max) {
+            throw JvmException("Valor inválido em " + command + ": use " + command.substr(0, prefix) + "N, com N entre 0 e " + std::to_string(max));
+        }
+        return std::stoul(value);
+    }
+
     void Commander::show_help() {
         std::cout << "  -d, --describe => descrevem o .class\n";
         std::cout << "  -r, --execute  => executa o código descrito no .class\n";
+        std::cout << "  -t, --threaded => executa com o interpretador threaded (computed goto)\n";
+        std::cout << "  -b, --bench    => mostra o número de instruções executadas por segundo\n";
+        std::cout << "  -p, --prefetch => carrega em paralelo as classes referenciadas antes de serem usadas\n";
+        std::cout << "  --prefetch=N   => usa N threads para carregar as classes, 0 carrega em ordem (determinístico)\n";
+        std::cout << "  -g, --gc-stats => mostra as estatísticas de alocação e de coleta de lixo ao terminar\n";
+        std::cout << "  --heap=N       => reserva N MB para o heap, a geração velha dividida em dois semiespaços\n";
+        std::cout << "  --young=N      => usa N MB do heap para a geração jovem, 0 usa uma geração só\n";
+        std::cout << "  -f, --fuse     => funde as sequências de bytecodes frequentes em superinstruções\n";
+        std::cout << "  --fuse=A,B     => funde só as superinstruções dadas:";
+        for (const auto &super : CodeInfo::superinstructions()) {
+            std::cout << " " << super.name;
+        }
+        std::cout << "\n";
+        std::cout << "  -s, --sequences => mostra as 20 sequências de bytecodes mais executadas, candidatas a superinstruções\n";
+        std::cout << "  --sequences=N  => mostra as N sequências mais executadas\n";
+        std::cout << "  -R, --registers => traduz os bytecodes para código de registradores e executa esse código\n";
         std::cout << "  -h, --help     => descrevem os comandos válidos\n";
     }
 
+    std::vector<u1> Commander::parseSuperinstructions(const std::string &names) {
+        std::vector<u1> opcodes;
+        size_t start = 0;
+        while (start <= names.size()) {
+            auto end = std::min(names.find(',', start), names.size());
+            auto name = names.substr(start, end - start);
+            auto &supers = CodeInfo::superinstructions();
+            auto super = std::find_if(supers.begin(), supers.end(), [&](const Superinstruction &s) { return name == s.name; });
+            if (super == supers.end()) {
+                throw JvmException("Superinstrução desconhecida: " + name);
+            }
+            opcodes.push_back(super->opcode);
+            start = end + 1;
+        }
+        return opcodes;
+    }
+
     std::string Commander::get_name() {
         std::string filename;
         do {
@@ -0,0 +1,19 @@
+#include "util/cpu_features.hpp"
+
+namespace jvm {
+
+	const CpuFeatures &CpuFeatures::get() {
+		static const CpuFeatures features;
+		return features;
+	}
+
+	CpuFeatures::CpuFeatures() {
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+		__builtin_cpu_init();
+		sse2 = __builtin_cpu_supports("sse2");
+		sse41 = __builtin_cpu_supports("sse4.1");
+		fma = __builtin_cpu_supports("fma");
+#endif
+	}
+
+}
@@ -0,0 +1,142 @@
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "util/number_format.hpp"
+
+namespace jvm {
+
+	namespace {
+		const char DIGITS[] = "00010203040506070809101112131415161718192021222324252627282930313233343536373839404142434445464748495051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899"; // the two digits of 0 to 99
+
+		/**
+		 * Writes the special values, which have no digits
+		 * @return number of characters written, 0 for the other values
+		 */
+		u4 writeSpecial(double value, char *out) {
+			const char *text = nullptr;
+
+			if (std::isnan(value)) {
+				text = "NaN";
+			} else if (std::isinf(value)) {
+				text = value > 0 ? "Infinity" : "-Infinity";
+			} else if (value == 0) {
+				text = std::signbit(value) ? "-0.0" : "0.0";
+			} else {
+				return 0;
+			}
+
+			auto length = static_cast<u4>(std::strlen(text));
+			std::memcpy(out, text, length);
+			return length;
+		}
+	}
+
+	u4 NumberFormat::writeLong(i8 value, char *out) {
+		char buffer[20];
+		auto end = buffer + sizeof(buffer), p = end;
+		u8 n = value < 0 ? 0 - static_cast<u8>(value) : static_cast<u8>(value); // also for the smallest long
+
+		while (n >= 100) {
+			auto i = (n % 100) * 2;
+			n /= 100;
+			*--p = DIGITS[i + 1];
+			*--p = DIGITS[i];
+		}
+		if (n >= 10) {
+			*--p = DIGITS[n * 2 + 1];
+			*--p = DIGITS[n * 2];
+		} else {
+			*--p = static_cast<char>('0' + n);
+		}
+
+		auto length = 0u;
+		if (value < 0) {
+			out[length++] = '-';
+		}
+		std::memcpy(out + length, p, static_cast<size_t>(end - p));
+		return length + static_cast<u4>(end - p);
+	}
+
+	u4 NumberFormat::writeDouble(double value, char *out) {
+		auto length = writeSpecial(value, out);
+		return length > 0 ? length : writeShortest(value, false, out);
+	}
+
+	u4 NumberFormat::writeFloat(float value, char *out) {
+		auto length = writeSpecial(value, out);
+		return length > 0 ? length : writeShortest(value, true, out);
+	}
+
+	u4 NumberFormat::writeShortest(double value, bool single, char *out) {
+		// A normal number whose shortest text has fewer digits than FLT_DIG or DBL_DIG rounds to that text padded with zeros,
+		// so the search starts there. Each precision rounds correctly, the first one that reads back is the shortest.
+		// As in Java, it has at least two digits: the closest one of two digits when a single digit would do
+		auto subnormal = std::fabs(value) < (single ? FLT_MIN : DBL_MIN);
+		char scientific[MAX_LENGTH];
+		for (int precision = subnormal ? 2 : single ? FLT_DIG : DBL_DIG; ; precision++) {
+			std::snprintf(scientific, sizeof(scientific), "%.*e", precision - 1, value);
+			if (precision == (single ? 9 : 17) || (single ? std::strtof(scientific, nullptr) == static_cast<float>(value) : std::strtod(scientific, nullptr) == value)) {
+				break;
+			}
+		}
+
+		// d.ddde[+-]x: the significant digits without the trailing zeros and the exponent
+		char digits[MAX_LENGTH];
+		u4 count = 0;
+		auto c = scientific + (value < 0 ? 1 : 0);
+		for (; *c != 'e'; c++) {
+			if (*c != '.') {
+				digits[count++] = *c;
+			}
+		}
+		while (count > 1 && digits[count - 1] == '0') {
+			count--;
+		}
+		auto exponent = static_cast<int>(std::strtol(c + 1, nullptr, 10));
+
+		u4 length = 0;
+		if (value < 0) {
+			out[length++] = '-';
+		}
+
+		if (exponent >= -3 && exponent < 7) {
+			if (exponent < 0) { // 0.00ddd
+				out[length++] = '0';
+				out[length++] = '.';
+				for (int i = exponent; i < -1; i++) {
+					out[length++] = '0';
+				}
+				std::memcpy(out + length, digits, count);
+				length += count;
+			} else { // ddd.ddd, at least one digit after the point
+				for (int i = 0; i <= exponent; i++) {
+					out[length++] = static_cast<u4>(i) < count ? digits[i] : '0';
+				}
+				out[length++] = '.';
+				if (static_cast<u4>(exponent) + 1 < count) {
+					std::memcpy(out + length, digits + exponent + 1, count - static_cast<u4>(exponent) - 1);
+					length += count - static_cast<u4>(exponent) - 1;
+				} else {
+					out[length++] = '0';
+				}
+			}
+		} else { // d.dddEx
+			out[length++] = digits[0];
+			out[length++] = '.';
+			if (count > 1) {
+				std::memcpy(out + length, digits + 1, count - 1);
+				length += count - 1;
+			} else {
+				out[length++] = '0';
+			}
+			out[length++] = 'E';
+			length += writeLong(exponent, out + length);
+		}
+
+		return length;
+	}
+
+}
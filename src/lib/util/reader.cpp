@@ -1,79 +1,129 @@
 #include "util/reader.hpp"
 #include "util/JvmException.hpp"
 
+#if defined(__unix__) || defined(__APPLE__)
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#define JVM_MMAP_READER
+#endif
+
 namespace jvm {
 
 	uint64_t Reader::size() {
-		_class.seekg(0, _class.end);
-		auto len = _class.tellg();
-		_class.seekg(0, _class.beg);
-		return len;
+		return length;
 	}
 
 	bool Reader::isValid() {
+		if (length < 4) {
+			return false;
+		}
 		auto firstWord = getNextWord();
 		return (firstWord == MAGIC_NUMBER);
 	}
 
 	void Reader::open(std::string &filename) {
-		index = 0;
+#ifdef JVM_MMAP_READER
+		int fd = ::open(filename.c_str(), O_RDONLY);
 
-		_class.open(filename, std::ios::binary);
+		if (fd < 0) {
+			throw JvmException("Couldn't open file");
+		}
 
-		if (!_class.is_open()) {
+		struct stat info;
+		if (fstat(fd, &info) < 0) {
+			::close(fd);
 			throw JvmException("Couldn't open file");
 		}
 
-		// reserve in memory the space needed for the file
-		bytes.resize(size());
+		size_t fileSize = static_cast<size_t>(info.st_size);
+		void *mapping = fileSize > 0 ? mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+		::close(fd); // the mapping stays valid after the descriptor is closed
+
+		if (mapping == MAP_FAILED) {
+			throw JvmException("This file isn't a valid .class file");
+		}
+
+		buffer = std::shared_ptr<const uint8_t>(static_cast<const uint8_t *>(mapping), [fileSize](const uint8_t *bytes) {
+			munmap(const_cast<uint8_t *>(bytes), fileSize);
+		});
+#else
+		std::ifstream file(filename, std::ios::binary | std::ios::ate);
 
-		// read the file to memory
-		for (auto i = 0; !_class.eof(); i++) {
-			_class.read((char*) &bytes[i], 1);
+		if (!file.is_open()) {
+			throw JvmException("Couldn't open file");
 		}
 
+		size_t fileSize = static_cast<size_t>(file.tellg());
+		auto bytes = new uint8_t[fileSize];
+		buffer = std::shared_ptr<const uint8_t>(bytes, std::default_delete<const uint8_t[]>());
+
+		// read the whole file to memory at once
+		file.seekg(0, file.beg);
+		file.read(reinterpret_cast<char *>(bytes), fileSize);
+#endif
+
+		data = buffer.get();
+		length = static_cast<uint32_t>(fileSize);
+		index = 0;
+
 		if (!isValid()) {
 			throw JvmException("This file isn't a valid .class file");
 		}
 	}
 
-	uint8_t Reader::getNextByte() {
-		return bytes[index++];
+	void Reader::open(const uint8_t *bytes, uint32_t size) {
+		buffer = std::shared_ptr<const uint8_t>(bytes, [](const uint8_t *) {}); // owned by the caller
+		data = bytes;
+		length = size;
+		index = 0;
+
+		if (!isValid()) {
+			throw JvmException("This file isn't a valid .class file");
+		}
 	}
 
-	uint16_t Reader::getNextHalfWord() {
-		uint16_t result = 0;
-		for (auto i = 0; i < 2; i++) {
-			int32_t byte = bytes[index + i];
-			byte <<= (BYTESIZE * (1 - i));
-			result |= byte;
+	std::shared_ptr<const uint8_t> Reader::getBuffer() {
+		return buffer;
+	}
+
+	const uint8_t *Reader::getBytes(uint32_t n) {
+		if (n > length - index) {
+			throw JvmException("Unexpected end of the .class file");
 		}
 
-		index += 2;
+		auto bytes = data + index;
+		index += n;
 
-		return result;
+		return bytes;
 	}
 
-	uint32_t Reader::getNextWord() {
-		uint32_t result = 0;
-		for (auto i = 0; i < 4; i++) {
-			int32_t byte = bytes[index + i];
-			byte <<= (BYTESIZE * (3 - i));
-			result |= byte;
-		}
+	uint8_t Reader::getNextByte() {
+		return *getBytes(1);
+	}
 
-		index += 4;
+	uint16_t Reader::getNextHalfWord() {
+		auto bytes = getBytes(2);
+		return static_cast<uint16_t>(bytes[0] << BYTESIZE | bytes[1]);
+	}
 
-		return result;
+	uint32_t Reader::getNextWord() {
+		auto bytes = getBytes(4);
+		return static_cast<uint32_t>(bytes[0]) << (3 * BYTESIZE)
+		     | static_cast<uint32_t>(bytes[1]) << (2 * BYTESIZE)
+		     | static_cast<uint32_t>(bytes[2]) << BYTESIZE
+		     | static_cast<uint32_t>(bytes[3]);
 	}
 
 	void Reader::close() {
-		_class.close();
+		data = nullptr;
+		length = index = 0;
+		buffer.reset();
 	}
 
 	void Reader::skipBytes(int n) {
-		_class.seekg(n, std::ifstream::cur);
-		index += n;
+		getBytes(static_cast<uint32_t>(n));
 	}
 
 	uint8_t operator<<(uint8_t &num, Reader &reader) {
@@ -87,4 +137,4 @@ namespace jvm {
 	uint32_t operator<<(uint32_t &num, Reader &reader) {
 		return num = reader.getNextWord();
 	}
-}
\ No newline at end of file
+}
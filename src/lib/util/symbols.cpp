@@ -0,0 +1,37 @@
+#include "util/symbols.hpp"
+#include "util/JvmException.hpp"
+
+namespace jvm {
+
+	std::mutex Symbols::mutex;
+
+	std::unordered_map<std::string, u4> Symbols::ids;
+
+	u4 Symbols::count = 0;
+
+	std::atomic<std::string *> Symbols::chunks[MAX_CHUNKS];
+
+	u4 Symbols::intern(const std::string &text) {
+		std::lock_guard<std::mutex> lock(mutex);
+
+		auto it = ids.find(text);
+		if (it != ids.end()) {
+			return it->second;
+		}
+
+		auto id = count;
+		if (id % CHUNK_SIZE == 0) {
+			if (id >> CHUNK_SHIFT == MAX_CHUNKS) {
+				throw JvmException("Too many symbols");
+			}
+			// get() reads the chunk without the lock, so it is published after its strings exist
+			chunks[id >> CHUNK_SHIFT].store(new std::string[CHUNK_SIZE], std::memory_order_release);
+		}
+		chunks[id >> CHUNK_SHIFT].load(std::memory_order_relaxed)[id & (CHUNK_SIZE - 1)] = text;
+		ids.emplace(text, id);
+		count++;
+
+		return id;
+	}
+
+}
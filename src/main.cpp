@@ -21,6 +21,20 @@ int main (int argc, char *argv[ ]) {
 			jvm::Engine engine(cl);
 			auto index = state.filename.find_last_of("/\\");
 			engine.path = state.filename.substr(0, index + 1);
+			engine.threaded = state.threaded;
+			engine.benchmark = state.benchmark;
+			engine.prefetch = state.prefetch;
+			engine.prefetchWorkers = state.prefetchWorkers;
+			engine.gcStats = state.gcStats;
+			engine.superinstructions = state.superinstructions;
+			engine.sequences = state.sequences;
+			engine.registers = state.registers;
+			if (state.heapMegabytes > 0) {
+				engine.heapSize = static_cast<uint64_t>(state.heapMegabytes) << 20;
+			}
+			if (state.youngMegabytes >= 0) {
+				engine.nurserySize = static_cast<uint64_t>(state.youngMegabytes) << 20;
+			}
 			engine.execute();
 		}
 
@@ -0,0 +1,45 @@
+/**
+ * Loop run by alloc_test. The first round warms the engine up: it loads, links and quickens the code.
+ * The second round must run without a single allocation of the engine. System.out.flush() ends each round
+ */
+public class AllocLoop {
+
+	private int count;
+
+	private static int total;
+
+	public int next(int i) {
+		count += i;
+		return count;
+	}
+
+	private static long mix(long a, double b) {
+		return a * 31 + (long) b;
+	}
+
+	public static void main(String[] args) {
+		AllocLoop loop = new AllocLoop();
+		long sum = 0;
+
+		for (int round = 0; round < 2; round++) {
+			for (int i = 0; i < 20000; i++) {
+				sum = mix(sum, loop.next(i) * 0.5);
+
+				int[][] grid = new int[2][3];
+				grid[1][2] = i;
+
+				String text = "i=" + i + " d=" + i * 0.25 + " s=" + sum;
+				StringBuilder builder = new StringBuilder();
+				builder.append(text).append(i).append(true);
+
+				total += builder.length() + grid[1][2];
+				if (loop.equals(builder)) {
+					total++;
+				}
+			}
+			System.out.flush();
+		}
+
+		System.out.println(total);
+	}
+}
@@ -0,0 +1,138 @@
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <streambuf>
+
+#include "class_loader/class_loader.hpp"
+#include "engine/engine.hpp"
+#include "util/JvmException.hpp"
+
+// Allocations of the whole process through the global operator new, the containers and strings of the engine included
+static bool counting = false;
+static size_t allocations = 0;
+
+static void *allocate(size_t size) {
+	if (counting) {
+		allocations++;
+	}
+	return std::malloc(size == 0 ? 1 : size);
+}
+
+void *operator new(size_t size) {
+	auto p = allocate(size);
+	if (p == nullptr) {
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+void *operator new[](size_t size) {
+	return operator new(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept {
+	return allocate(size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept {
+	return allocate(size);
+}
+
+void operator delete(void *p) noexcept {
+	std::free(p);
+}
+
+void operator delete[](void *p) noexcept {
+	std::free(p);
+}
+
+void operator delete(void *p, const std::nothrow_t &) noexcept {
+	std::free(p);
+}
+
+void operator delete[](void *p, const std::nothrow_t &) noexcept {
+	std::free(p);
+}
+
+/**
+ * Stream buffer of std::cout, where System.out writes. It drops the text and counts the allocations between the
+ * first and the second flush, so over the second round of AllocLoop
+ */
+class RoundMarker : public std::streambuf {
+public:
+	int flushes = 0;	///> Number of flushes of System.out
+
+protected:
+	int overflow(int c) override {
+		return traits_type::not_eof(c);
+	}
+
+	std::streamsize xsputn(const char *, std::streamsize count) override {
+		return count;
+	}
+
+	int sync() override {
+		flushes++;
+		counting = flushes == 1;
+		return 0;
+	}
+};
+
+/**
+ * Runs AllocLoop with a dispatch loop, with or without the superinstructions
+ * @return whether its second round allocated nothing
+ */
+static bool steadyState(const std::string &filename, const char *dispatch, bool threaded, bool fused, bool registers) {
+	RoundMarker marker;
+	auto console = std::cout.rdbuf(&marker);
+
+	try {
+		jvm::ClassLoader cl;
+		cl.read(filename);
+
+		jvm::Engine engine(cl);
+		engine.path = filename.substr(0, filename.find_last_of("/\\") + 1);
+		engine.threaded = threaded;
+		engine.registers = registers;
+		if (fused) {
+			for (const auto &super : jvm::CodeInfo::superinstructions()) {
+				engine.superinstructions.push_back(super.opcode);
+			}
+		}
+
+		allocations = 0;
+		engine.execute();
+		counting = false;
+	} catch (const jvm::JvmException& e) {
+		counting = false;
+		std::cout.rdbuf(console);
+		std::cerr << dispatch << " dispatch: " << e.what() << std::endl;
+		return false;
+	}
+
+	std::cout.rdbuf(console);
+
+	if (marker.flushes < 2) {
+		std::cerr << dispatch << " dispatch: the rounds did not run" << std::endl;
+		return false;
+	}
+
+	std::cerr << dispatch << " dispatch: " << allocations << " allocations in the steady state" << std::endl;
+	return allocations == 0;
+}
+
+int main (int argc, char *argv[ ]) {
+	if (argc < 2) {
+		std::cerr << "usage: alloc_test AllocLoop.class" << std::endl;
+		return 2;
+	}
+
+	bool passed = steadyState(argv[1], "switch", false, false, false);
+#ifdef JVM_THREADED_DISPATCH
+	passed &= steadyState(argv[1], "threaded", true, false, false);
+	passed &= steadyState(argv[1], "fused threaded", true, true, false);
+#endif
+	passed &= steadyState(argv[1], "registers", false, false, true);
+
+	return passed ? 0 : 1;
+}